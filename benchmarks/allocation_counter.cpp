@@ -0,0 +1,41 @@
+/// =*============================= SignalEasel ==============================*=
+/// A C++ library for audio modulation/demodulation into analog & digital modes.
+/// Detailed documentation can be found here: https://signaleasel.joshuajer.red
+///
+/// @author Joshua Jerred
+/// @date   2026-10-19
+///
+/// @copyright Copyright 2026 Joshua Jerred. All rights reserved.
+/// @license   This project is licensed under the GNU GPL v3.0 license.
+/// =*========================================================================*=
+
+/// @brief Replaces the global operator new of the benchmark executable to count
+/// heap allocations, see benchmarks::AllocationCounter.
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "benchmarks/benchmark_fixtures.hpp"
+
+namespace {
+std::atomic<uint64_t> g_allocations{0};
+} // namespace
+
+uint64_t signal_easel::benchmarks::getAllocationCount() {
+  return g_allocations.load(std::memory_order_relaxed);
+}
+
+void *operator new(std::size_t size) {
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void *pointer = std::malloc(size == 0 ? 1 : size)) {
+    return pointer;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void *pointer) noexcept { std::free(pointer); }
+
+void operator delete(void *pointer, std::size_t) noexcept {
+  std::free(pointer);
+}
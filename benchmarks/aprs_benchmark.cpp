@@ -0,0 +1,248 @@
+/// =*============================= SignalEasel ==============================*=
+/// A C++ library for audio modulation/demodulation into analog & digital modes.
+/// Detailed documentation can be found here: https://signaleasel.joshuajer.red
+///
+/// @author Joshua Jerred
+/// @date   2026-10-19
+///
+/// @copyright Copyright 2026 Joshua Jerred. All rights reserved.
+/// @license   This project is licensed under the GNU GPL v3.0 license.
+/// =*========================================================================*=
+
+#include <algorithm>
+#include <array>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <SignalEasel/aprs.hpp>
+#include <SignalEasel/aprs/telemetry_data.hpp>
+#include <SignalEasel/aprs/telemetry_transcoder.hpp>
+
+#include "benchmarks/benchmark_fixtures.hpp"
+
+using namespace signal_easel;
+using aprs::telemetry::TelemetryData;
+using aprs::telemetry::TelemetryTranscoder;
+using benchmarks::reportFrames;
+
+namespace {
+
+/// @brief Demodulate an APRS packet once, so only the information field
+/// parser is timed.
+template <typename Packet>
+void BM_ParsePacket(benchmark::State &state,
+                    const std::vector<int16_t> &audio,
+                    bool (aprs::Demodulator::*parse)(Packet &)) {
+  aprs::Demodulator demodulator;
+  afsk::DemodulatorBenchmark::loadAudio(demodulator, audio);
+  demodulator.processAudioBuffer();
+  if (!demodulator.lookForAx25Packet()) {
+    state.SkipWithError("No packet found");
+    return;
+  }
+
+  benchmarks::AllocationCounter allocations;
+  for (auto _ : state) {
+    Packet packet;
+    if (!(demodulator.*parse)(packet)) {
+      state.SkipWithError("Failed to parse the packet");
+      break;
+    }
+    benchmark::DoNotOptimize(packet);
+  }
+  reportFrames(state);
+  allocations.report(state);
+}
+
+/// @brief A compressed position report, the format the modulator sends.
+std::vector<int16_t> positionPacketAudio() {
+  aprs::PositionPacket packet;
+  packet.source_address = "N0CALL";
+  packet.source_ssid = 11;
+  packet.time_code = "092345";
+  packet.latitude = 40.0;
+  packet.longitude = -105.0;
+  packet.altitude = 1000;
+  packet.speed = 100;
+  packet.course = 200;
+
+  aprs::Modulator modulator;
+  modulator.encode(packet);
+  return modulator.getAudioBuffer();
+}
+
+BENCHMARK_CAPTURE(BM_ParsePacket, position, positionPacketAudio(),
+                  &aprs::Demodulator::parsePositionPacket);
+BENCHMARK_CAPTURE(BM_ParsePacket, position_uncompressed,
+                  benchmarks::loadFixture("aprs_real.wav"),
+                  &aprs::Demodulator::parsePositionPacket);
+BENCHMARK_CAPTURE(BM_ParsePacket, message,
+                  benchmarks::loadFixture("aprs_message.wav"),
+                  &aprs::Demodulator::parseMessagePacket);
+BENCHMARK_CAPTURE(BM_ParsePacket, experimental,
+                  benchmarks::loadFixture("multi_packet_aprs.wav"),
+                  &aprs::Demodulator::parseExperimentalPacket);
+
+/// @brief Just the information field parsers, with the packet reused so the
+/// strings keep their capacity (as in a receive loop).
+void BM_ParsePositionInformation(benchmark::State &state,
+                                 std::string destination, std::string info) {
+  aprs::PositionPacket packet;
+  const bool mic_e = !destination.empty();
+
+  benchmarks::AllocationCounter allocations;
+  for (auto _ : state) {
+    const bool parsed =
+        mic_e ? aprs::parseMicEInformation(destination, info, packet)
+              : aprs::parsePositionInformation(info, packet);
+    if (!parsed) {
+      state.SkipWithError("Failed to parse the position");
+      break;
+    }
+    benchmark::DoNotOptimize(packet);
+  }
+  reportFrames(state);
+  allocations.report(state);
+}
+
+BENCHMARK_CAPTURE(BM_ParsePositionInformation, uncompressed, "",
+                  "@092345z4903.50N/07201.75W>088/036/A=001234Hello");
+BENCHMARK_CAPTURE(BM_ParsePositionInformation, compressed, "",
+                  "!/5L!!<*e7>7P[/A=001234Hello");
+BENCHMARK_CAPTURE(BM_ParsePositionInformation, mic_e, "S32UVT",
+                  "`(_fn\"Oj/\"4T}Hello");
+
+void BM_Base91Encode(benchmark::State &state) {
+  uint32_t value = 0;
+  for (auto _ : state) {
+    const auto encoded = aprs::base91Encode(static_cast<int>(value), 4);
+    benchmark::DoNotOptimize(encoded.data());
+    value = (value + 7919) % aprs::BASE91_POWERS[4];
+  }
+}
+BENCHMARK(BM_Base91Encode);
+
+void BM_Base91EncodeFixed(benchmark::State &state) {
+  uint32_t value = 0;
+  std::array<uint8_t, 4> encoded{};
+  for (auto _ : state) {
+    aprs::base91EncodeFixed(value, encoded);
+    benchmark::DoNotOptimize(encoded.data());
+    value = (value + 7919) % aprs::BASE91_POWERS[4];
+  }
+}
+BENCHMARK(BM_Base91EncodeFixed);
+
+/// @brief The five analog channels and the sequence number of a compressed
+/// telemetry report.
+void BM_Base91EncodeBatch(benchmark::State &state) {
+  std::array<uint32_t, 6> values = {1, 2000, 4000, 6000, 8000, 8280};
+  std::array<uint8_t, 12> encoded{};
+  for (auto _ : state) {
+    aprs::base91EncodeBatch<2>(values.data(), values.size(), encoded.data());
+    benchmark::DoNotOptimize(encoded.data());
+    values[0] = (values[0] + 1) % aprs::BASE91_POWERS[2];
+  }
+}
+BENCHMARK(BM_Base91EncodeBatch);
+
+TelemetryData telemetryData() {
+  TelemetryData data;
+  data.setTelemetryStationAddress("N0CALL", 11);
+  data.setSequenceNumber(123);
+  data.setComment("SignalEasel");
+  data.setProjectTitle("Benchmark");
+  return data;
+}
+
+using TelemetryEncoder = bool (*)(const TelemetryData &,
+                                  std::vector<uint8_t> &);
+
+void BM_TelemetryEncode(benchmark::State &state, TelemetryEncoder encoder) {
+  const TelemetryData data = telemetryData();
+  std::vector<uint8_t> message;
+
+  for (auto _ : state) {
+    if (!encoder(data, message)) {
+      state.SkipWithError("Failed to encode the message");
+      break;
+    }
+    benchmark::DoNotOptimize(message.data());
+  }
+  reportFrames(state);
+}
+
+void BM_TelemetryDecode(benchmark::State &state, TelemetryEncoder encoder) {
+  std::vector<uint8_t> message;
+  encoder(telemetryData(), message);
+
+  for (auto _ : state) {
+    TelemetryData data;
+    if (!TelemetryTranscoder::decodeMessage(data, message)) {
+      state.SkipWithError("Failed to decode the message");
+      break;
+    }
+    benchmark::DoNotOptimize(data);
+  }
+  reportFrames(state);
+}
+
+#define TELEMETRY_BENCHMARKS(name, encoder)                                    \
+  BENCHMARK_CAPTURE(BM_TelemetryEncode, name, &TelemetryTranscoder::encoder);  \
+  BENCHMARK_CAPTURE(BM_TelemetryDecode, name, &TelemetryTranscoder::encoder)
+
+TELEMETRY_BENCHMARKS(data_report, encodeDataReportMessage);
+TELEMETRY_BENCHMARKS(coefficients, encodeParameterCoefficientMessage);
+TELEMETRY_BENCHMARKS(names, encodeParameterNameMessage);
+TELEMETRY_BENCHMARKS(units_and_labels, encodeUnitAndLabelMessage);
+TELEMETRY_BENCHMARKS(bit_sense, encodeBitSenseMessage);
+
+/// @brief Feeds audio to the receiver in PulseAudio sized blocks.
+class BlockReceiver : public aprs::Receiver {
+public:
+  bool process() override { return false; }
+
+  void receive(const std::vector<int16_t> &audio) {
+    for (size_t i = 0; i < audio.size(); i += PULSE_AUDIO_BUFFER_SIZE) {
+      const size_t length = std::min(PULSE_AUDIO_BUFFER_SIZE, audio.size() - i);
+      detectSignal(audio.data() + i, length);
+    }
+    flushReceiveBuffer();
+  }
+};
+
+/**
+ * @brief Signal detection and decoding of several back to back packets, as a
+ * station sees them. The packets are taken out of the queue as they would be
+ * by an application. The "allocations" counter is what the receive path
+ * allocates per recording, it should not grow with the number of candidate
+ * frames found in the noise.
+ */
+void BM_AprsReceiver(benchmark::State &state) {
+  const auto audio = benchmarks::loadFixture("multi_packet_aprs.wav");
+  BlockReceiver receiver;
+  receiver.receive(audio); // warm up the receiver's buffers
+
+  aprs::ExperimentalPacket packet;
+  ax25::Frame frame;
+  while (receiver.getAprsExperimental(packet, frame)) {
+  }
+
+  size_t frames = 0;
+  benchmarks::AllocationCounter allocations;
+  for (auto _ : state) {
+    receiver.receive(audio);
+    while (receiver.getAprsExperimental(packet, frame)) {
+      frames++;
+    }
+  }
+  benchmarks::reportSamples(state, audio.size());
+  state.counters["frames"] = benchmark::Counter(
+      static_cast<double>(frames), benchmark::Counter::kAvgIterations);
+  allocations.report(state);
+}
+BENCHMARK(BM_AprsReceiver)->Unit(benchmark::kMillisecond);
+
+} // namespace
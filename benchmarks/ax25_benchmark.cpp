@@ -0,0 +1,137 @@
+/// =*============================= SignalEasel ==============================*=
+/// A C++ library for audio modulation/demodulation into analog & digital modes.
+/// Detailed documentation can be found here: https://signaleasel.joshuajer.red
+///
+/// @author Joshua Jerred
+/// @date   2026-10-19
+///
+/// @copyright Copyright 2026 Joshua Jerred. All rights reserved.
+/// @license   This project is licensed under the GNU GPL v3.0 license.
+/// =*========================================================================*=
+
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <SignalEasel/aprs.hpp>
+#include <SignalEasel/ax25.hpp>
+
+#include "benchmarks/benchmark_fixtures.hpp"
+
+using namespace signal_easel;
+using benchmarks::reportFrames;
+
+namespace {
+
+/// @brief The demodulated (still NRZI encoded) bits of a real APRS packet
+BitStream receivedBitStream() {
+  aprs::Demodulator demodulator;
+  demodulator.loadAudioFromFile(benchmarks::fixturePath("aprs_real.wav"));
+  demodulator.processAudioBuffer();
+  return afsk::DemodulatorBenchmark::getBitStream(demodulator);
+}
+
+/// @brief The decoders consume their input, so each run decodes a batch of
+/// copies made before the timing starts. Pausing the timer costs far more
+/// than a decode, so it is only paused to refill the batch between runs.
+constexpr size_t BATCH_SIZE = 64;
+
+void refillBatch(benchmark::State &state, std::vector<BitStream> &batch,
+                 const BitStream &source) {
+  state.PauseTiming();
+  batch.assign(BATCH_SIZE, source);
+  state.ResumeTiming();
+}
+
+void BM_DecodeNrzi(benchmark::State &state) {
+  const BitStream received = receivedBitStream();
+  std::vector<BitStream> batch(BATCH_SIZE, received);
+
+  for (auto _ : state) {
+    for (BitStream &input : batch) {
+      BitStream output = ax25::decodeNrzi(input);
+      benchmark::DoNotOptimize(output);
+    }
+    refillBatch(state, batch, received);
+  }
+  reportFrames(state, BATCH_SIZE);
+}
+BENCHMARK(BM_DecodeNrzi);
+
+void BM_FindStartFlagsDeStuffBytes(benchmark::State &state) {
+  BitStream received = receivedBitStream();
+  const BitStream decoded = ax25::decodeNrzi(received);
+  BitStream check = decoded;
+  if (ax25::findStartFlags(check) < 1) {
+    state.SkipWithError("No start flags found");
+    return;
+  }
+  std::vector<BitStream> batch(BATCH_SIZE, decoded);
+
+  for (auto _ : state) {
+    for (BitStream &input : batch) {
+      ax25::findStartFlags(input);
+      auto bytes = ax25::deStuffBytes(input);
+      benchmark::DoNotOptimize(bytes.data());
+    }
+    refillBatch(state, batch, decoded);
+  }
+  reportFrames(state, BATCH_SIZE);
+}
+BENCHMARK(BM_FindStartFlagsDeStuffBytes);
+
+void BM_CalculateFcs(benchmark::State &state) {
+  BitStream received = receivedBitStream();
+  BitStream decoded = ax25::decodeNrzi(received);
+  ax25::findStartFlags(decoded);
+  auto frame = ax25::deStuffBytes(decoded);
+
+  // Everything but the FCS itself
+  frame.resize(frame.size() - 2);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(ax25::calculateFcs(frame));
+  }
+  reportFrames(state);
+  state.SetBytesProcessed(static_cast<int64_t>(frame.size()) *
+                          state.iterations());
+}
+BENCHMARK(BM_CalculateFcs);
+
+/// @brief A typical APRS frame, a position report through two digipeaters
+ax25::Frame positionFrame() {
+  const std::string info = "!4157.71N\\11130.86W&/Amazon Digi/A=007547";
+  ax25::Frame frame;
+  frame.setDestinationAddress(ax25::Address("APRS", 0, false));
+  frame.setSourceAddress(ax25::Address("N7PDI", 1, true));
+  frame.addRepeaterAddress(ax25::Address("WIDE1", 1, false));
+  frame.addRepeaterAddress(ax25::Address("WIDE2", 1, false));
+  frame.setInformation(std::vector<uint8_t>(info.begin(), info.end()));
+  return frame;
+}
+
+void BM_EncodeFrame(benchmark::State &state) {
+  ax25::Frame frame = positionFrame();
+
+  for (auto _ : state) {
+    auto encoded = frame.encodeFrame();
+    benchmark::DoNotOptimize(encoded.data());
+  }
+  reportFrames(state);
+}
+BENCHMARK(BM_EncodeFrame);
+
+void BM_EncodeFrameReusedBuffer(benchmark::State &state) {
+  ax25::Frame frame = positionFrame();
+  std::vector<uint8_t> encoded;
+
+  for (auto _ : state) {
+    frame.encodeFrame(encoded);
+    benchmark::DoNotOptimize(encoded.data());
+  }
+  reportFrames(state);
+}
+BENCHMARK(BM_EncodeFrameReusedBuffer);
+
+} // namespace
@@ -0,0 +1,118 @@
+/// =*============================= SignalEasel ==============================*=
+/// A C++ library for audio modulation/demodulation into analog & digital modes.
+/// Detailed documentation can be found here: https://signaleasel.joshuajer.red
+///
+/// @author Joshua Jerred
+/// @date   2026-10-19
+///
+/// @copyright Copyright 2026 Joshua Jerred. All rights reserved.
+/// @license   This project is licensed under the GNU GPL v3.0 license.
+/// =*========================================================================*=
+
+#ifndef SIGNAL_EASEL_BENCHMARK_FIXTURES_HPP_
+#define SIGNAL_EASEL_BENCHMARK_FIXTURES_HPP_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <wav_gen.hpp>
+
+#include <SignalEasel/afsk.hpp>
+#include <SignalEasel/bit_stream.hpp>
+
+namespace signal_easel {
+
+namespace benchmarks {
+
+/// @brief The full path of one of the WAV files in tests/
+inline std::string fixturePath(const std::string &file_name) {
+  return std::string(SIGNAL_EASEL_FIXTURE_DIR) + "/" + file_name;
+}
+
+inline std::vector<int16_t> loadFixture(const std::string &file_name) {
+  std::vector<int16_t> samples;
+  wavgen::Reader reader(fixturePath(file_name));
+  reader.getAllSamples(samples);
+  return samples;
+}
+
+/// @brief Report the throughput as audio samples per second
+inline void reportSamples(benchmark::State &state, size_t samples_per_run) {
+  state.counters["samples"] = benchmark::Counter(
+      static_cast<double>(samples_per_run * state.iterations()),
+      benchmark::Counter::kIsRate);
+}
+
+/// @brief Report the throughput as AX.25/APRS frames per second
+inline void reportFrames(benchmark::State &state, size_t frames_per_run = 1) {
+  state.counters["frames"] = benchmark::Counter(
+      static_cast<double>(frames_per_run * state.iterations()),
+      benchmark::Counter::kIsRate);
+}
+
+/// @brief The number of heap allocations made by the benchmark executable so
+/// far (see allocation_counter.cpp).
+uint64_t getAllocationCount();
+
+/**
+ * @brief Counts the heap allocations made while the benchmark is timing.
+ * @details Call pause()/resume() along with State::PauseTiming()/
+ * ResumeTiming() to leave the setup out.
+ */
+class AllocationCounter {
+public:
+  AllocationCounter() : start_(getAllocationCount()) {}
+
+  void pause() { paused_at_ = getAllocationCount(); }
+  void resume() { start_ += getAllocationCount() - paused_at_; }
+
+  /// @brief Report the allocations per iteration as the "allocations" counter
+  void report(benchmark::State &state) const {
+    state.counters["allocations"] = benchmark::Counter(
+        static_cast<double>(getAllocationCount() - start_),
+        benchmark::Counter::kAvgIterations);
+  }
+
+private:
+  uint64_t start_;
+  uint64_t paused_at_ = 0;
+};
+
+} // namespace benchmarks
+
+namespace afsk {
+
+/// @brief Exposes the individual demodulation stages to the benchmarks.
+class DemodulatorBenchmark {
+public:
+  static void loadAudio(Demodulator &demodulator,
+                        const std::vector<int16_t> &audio) {
+    demodulator.audio_buffer_ = audio;
+  }
+
+  static void audioBufferToBaseBandSignal(Demodulator &demodulator) {
+    Demodulator::ProcessResults results;
+    demodulator.audioBufferToBaseBandSignal(results);
+  }
+
+  static void baseBandToBitStream(Demodulator &demodulator) {
+    Demodulator::ProcessResults results;
+    demodulator.baseBandToBitStream(results);
+  }
+
+  static size_t getBaseBandLength(const Demodulator &demodulator) {
+    return demodulator.base_band_signal_.size();
+  }
+
+  static const BitStream &getBitStream(const Demodulator &demodulator) {
+    return demodulator.output_bit_stream_;
+  }
+};
+
+} // namespace afsk
+
+} // namespace signal_easel
+
+#endif /* SIGNAL_EASEL_BENCHMARK_FIXTURES_HPP_ */
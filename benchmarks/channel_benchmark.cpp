@@ -0,0 +1,111 @@
+/// =*============================= SignalEasel ==============================*=
+/// A C++ library for audio modulation/demodulation into analog & digital modes.
+/// Detailed documentation can be found here: https://signaleasel.joshuajer.red
+///
+/// @author Joshua Jerred
+/// @date   2026-10-19
+///
+/// @copyright Copyright 2026 Joshua Jerred. All rights reserved.
+/// @license   This project is licensed under the GNU GPL v3.0 license.
+/// =*========================================================================*=
+
+#include <cstdint>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <SignalEasel/aprs.hpp>
+#include <SignalEasel/channel_simulator.hpp>
+
+#include "benchmarks/benchmark_fixtures.hpp"
+
+using namespace signal_easel;
+using Engine = afsk::Settings::DemodulationEngine;
+
+namespace {
+
+/// @brief The number of simulated packets per point on the curve
+constexpr benchmark::IterationCount PACKETS_PER_POINT = 50;
+
+std::vector<int16_t> modulateTestPacket() {
+  aprs::MessagePacket packet;
+  packet.source_address = "TSTCLL";
+  packet.source_ssid = 11;
+  packet.addressee = "TSTCLL-11";
+  packet.message = "Hello World!";
+  packet.message_id = "1";
+
+  aprs::Modulator modulator;
+  modulator.encode(packet);
+  return modulator.getAudioBuffer();
+}
+
+/**
+ * @brief Packet success rate of the full receive chain against Eb/N0.
+ * @details Each iteration sends the same packet through the channel with a
+ * new seed, so a run is repeatable. Only the demodulation is timed; the
+ * "success_rate" counter is the fraction of packets that decoded, and is what
+ * compare_benchmarks.py watches for sensitivity regressions.
+ * Arguments: Eb/N0 in dB, demodulation engine.
+ */
+void BM_AprsPacketSuccessRate(benchmark::State &state,
+                              ChannelSimulator::Settings channel_settings) {
+  const auto clean_audio = modulateTestPacket();
+  channel_settings.add_noise = true;
+  channel_settings.eb_n0_db = static_cast<double>(state.range(0));
+
+  afsk::Settings settings;
+  settings.demodulation_engine = static_cast<Engine>(state.range(1));
+  aprs::Demodulator demodulator(settings);
+
+  std::vector<int16_t> audio;
+  uint32_t seed = 0;
+  size_t decoded = 0;
+  size_t num_samples = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    channel_settings.seed = seed++;
+    ChannelSimulator channel(channel_settings);
+    channel.process(clean_audio, audio);
+    afsk::DemodulatorBenchmark::loadAudio(demodulator, audio);
+    num_samples += audio.size();
+    state.ResumeTiming();
+
+    demodulator.processAudioBuffer();
+    aprs::MessagePacket packet;
+    if (demodulator.lookForAx25Packet() &&
+        demodulator.parseMessagePacket(packet)) {
+      decoded++;
+    }
+  }
+
+  state.counters["success_rate"] =
+      static_cast<double>(decoded) / static_cast<double>(state.iterations());
+  state.counters["samples"] = benchmark::Counter(
+      static_cast<double>(num_samples), benchmark::Counter::kIsRate);
+}
+
+ChannelSimulator::Settings impairedChannel() {
+  ChannelSimulator::Settings settings;
+  settings.frequency_offset = 20.0;
+  settings.clock_drift_ppm = 200.0;
+  settings.twist_db = -4.0;
+  return settings;
+}
+
+void successRateArguments(benchmark::internal::Benchmark *benchmark) {
+  benchmark
+      ->ArgsProduct({benchmark::CreateDenseRange(0, 24, 2),
+                     {static_cast<int64_t>(Engine::CORRELATOR),
+                      static_cast<int64_t>(Engine::QUADRATURE_MIXER)}})
+      ->ArgNames({"ebn0", "engine"})
+      ->Iterations(PACKETS_PER_POINT)
+      ->Unit(benchmark::kMillisecond);
+}
+
+BENCHMARK_CAPTURE(BM_AprsPacketSuccessRate, awgn, ChannelSimulator::Settings())
+    ->Apply(successRateArguments);
+BENCHMARK_CAPTURE(BM_AprsPacketSuccessRate, impaired, impairedChannel())
+    ->Apply(successRateArguments);
+
+} // namespace
@@ -0,0 +1,229 @@
+/// =*============================= SignalEasel ==============================*=
+/// A C++ library for audio modulation/demodulation into analog & digital modes.
+/// Detailed documentation can be found here: https://signaleasel.joshuajer.red
+///
+/// @author Joshua Jerred
+/// @date   2026-10-19
+///
+/// @copyright Copyright 2026 Joshua Jerred. All rights reserved.
+/// @license   This project is licensed under the GNU GPL v3.0 license.
+/// =*========================================================================*=
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <SignalEasel/afsk.hpp>
+#include <SignalEasel/aprs.hpp>
+#include <SignalEasel/psk.hpp>
+#include <SignalEasel/spectrum.hpp>
+
+#include "benchmarks/benchmark_fixtures.hpp"
+#include "src/afsk/snr_estimator.hpp"
+#include "src/afsk/tone_detector.hpp"
+#include "src/fft.hpp"
+
+using namespace signal_easel;
+using benchmarks::loadFixture;
+using benchmarks::reportSamples;
+using Engine = afsk::Settings::DemodulationEngine;
+
+namespace {
+
+const char *const AUDIO_FIXTURE = "aprs_real.wav";
+
+/// @brief The filter, SNR and tone detection stages for each sample type
+template <typename T, Engine ENGINE>
+void BM_ToneDetector(benchmark::State &state) {
+  const auto audio = loadFixture(AUDIO_FIXTURE);
+  afsk::BasicToneDetector<T> detector(AUDIO_SAMPLE_RATE, ENGINE);
+  std::vector<uint8_t> base_band;
+  afsk::Demodulator::ProcessResults results;
+
+  for (auto _ : state) {
+    detector.process(audio, base_band, results);
+    benchmark::DoNotOptimize(base_band.data());
+  }
+  reportSamples(state, audio.size());
+}
+BENCHMARK_TEMPLATE(BM_ToneDetector, double, Engine::CORRELATOR);
+BENCHMARK_TEMPLATE(BM_ToneDetector, double, Engine::QUADRATURE_MIXER);
+BENCHMARK_TEMPLATE(BM_ToneDetector, float, Engine::CORRELATOR);
+BENCHMARK_TEMPLATE(BM_ToneDetector, float, Engine::QUADRATURE_MIXER);
+BENCHMARK_TEMPLATE(BM_ToneDetector, FixedSample, Engine::CORRELATOR);
+BENCHMARK_TEMPLATE(BM_ToneDetector, FixedSample, Engine::QUADRATURE_MIXER);
+
+/// @brief The SNR estimate the receiver's signal detection runs on every
+/// block, with and without searching the AFC range
+void BM_SnrEstimator(benchmark::State &state) {
+  const auto audio = loadFixture(AUDIO_FIXTURE);
+  afsk::SnrEstimator estimator(AUDIO_SAMPLE_RATE,
+                               static_cast<uint32_t>(state.range(0)));
+  afsk::Demodulator::ProcessResults results;
+
+  for (auto _ : state) {
+    estimator.process(audio.data(), audio.size());
+    estimator.estimate(results);
+    benchmark::DoNotOptimize(results.snr);
+  }
+  reportSamples(state, audio.size());
+}
+BENCHMARK(BM_SnrEstimator)->Arg(0)->Arg(afsk::AFSK_AFC_MAX_RANGE);
+
+/// @brief Audio to base band signal as the library is configured, including
+/// the resampler when demodulating at a reduced rate.
+void BM_AfskCorrelator(benchmark::State &state, Engine engine,
+                       uint32_t sample_rate) {
+  afsk::Settings settings;
+  settings.demodulation_engine = engine;
+  settings.demodulation_sample_rate = sample_rate;
+  afsk::Demodulator demodulator(settings);
+  demodulator.loadAudioFromFile(benchmarks::fixturePath(AUDIO_FIXTURE));
+  const size_t num_samples = loadFixture(AUDIO_FIXTURE).size();
+
+  for (auto _ : state) {
+    afsk::DemodulatorBenchmark::audioBufferToBaseBandSignal(demodulator);
+  }
+  reportSamples(state, num_samples);
+}
+BENCHMARK_CAPTURE(BM_AfskCorrelator, correlator_48000, Engine::CORRELATOR,
+                  AUDIO_SAMPLE_RATE);
+BENCHMARK_CAPTURE(BM_AfskCorrelator, quadrature_mixer_48000,
+                  Engine::QUADRATURE_MIXER, AUDIO_SAMPLE_RATE);
+BENCHMARK_CAPTURE(BM_AfskCorrelator, correlator_9600, Engine::CORRELATOR,
+                  9600);
+BENCHMARK_CAPTURE(BM_AfskCorrelator, quadrature_mixer_9600,
+                  Engine::QUADRATURE_MIXER, 9600);
+
+/// @brief Clock recovery and bit slicing of the base band signal
+void BM_BaseBandToBitStream(benchmark::State &state) {
+  afsk::Demodulator demodulator;
+  demodulator.loadAudioFromFile(benchmarks::fixturePath(AUDIO_FIXTURE));
+  afsk::DemodulatorBenchmark::audioBufferToBaseBandSignal(demodulator);
+
+  for (auto _ : state) {
+    afsk::DemodulatorBenchmark::baseBandToBitStream(demodulator);
+  }
+  reportSamples(state,
+                afsk::DemodulatorBenchmark::getBaseBandLength(demodulator));
+}
+BENCHMARK(BM_BaseBandToBitStream);
+
+/// @brief The whole receive chain, audio in to a parsed AX.25 frame
+void BM_AprsDemodulate(benchmark::State &state) {
+  aprs::Demodulator demodulator;
+  demodulator.loadAudioFromFile(benchmarks::fixturePath(AUDIO_FIXTURE));
+  const size_t num_samples = loadFixture(AUDIO_FIXTURE).size();
+
+  for (auto _ : state) {
+    demodulator.processAudioBuffer();
+    if (!demodulator.lookForAx25Packet()) {
+      state.SkipWithError("No packet found");
+      break;
+    }
+  }
+  reportSamples(state, num_samples);
+  benchmarks::reportFrames(state);
+}
+BENCHMARK(BM_AprsDemodulate);
+
+/// @brief One PSK channel, the cost of each extra carrier being monitored
+void BM_PskDemodulate(benchmark::State &state, psk::Settings::Mode mode,
+                      psk::Settings::SymbolRate symbol_rate) {
+  psk::Settings settings;
+  settings.mode = mode;
+  settings.symbol_rate = symbol_rate;
+  psk::Modulator modulator(settings);
+  modulator.encodeString("The quick brown fox jumps over the lazy dog");
+  const auto &audio = modulator.getAudioBuffer();
+  psk::Demodulator demodulator(settings);
+  std::string text;
+
+  for (auto _ : state) {
+    demodulator.reset();
+    demodulator.process(audio.data(), audio.size());
+    demodulator.takeText(text);
+    benchmark::DoNotOptimize(text.data());
+  }
+  reportSamples(state, audio.size());
+}
+BENCHMARK_CAPTURE(BM_PskDemodulate, bpsk_125, psk::Settings::Mode::BPSK,
+                  psk::Settings::SymbolRate::SR_125);
+BENCHMARK_CAPTURE(BM_PskDemodulate, bpsk_1000, psk::Settings::Mode::BPSK,
+                  psk::Settings::SymbolRate::SR_1000);
+BENCHMARK_CAPTURE(BM_PskDemodulate, qpsk_125, psk::Settings::Mode::QPSK,
+                  psk::Settings::SymbolRate::SR_125);
+BENCHMARK_CAPTURE(BM_PskDemodulate, qpsk_1000, psk::Settings::Mode::QPSK,
+                  psk::Settings::SymbolRate::SR_1000);
+
+/// @brief Eight BPSK stations across the passband at once
+void BM_PskChannelizer(benchmark::State &state) {
+  std::vector<int32_t> mixed;
+  for (uint32_t carrier = 600; carrier <= 2700; carrier += 300) {
+    psk::Settings settings;
+    settings.carrier_frequency = carrier;
+    settings.amplitude = 0.1;
+    psk::Modulator modulator(settings);
+    modulator.encodeString("The quick brown fox jumps over the lazy dog");
+    const auto &audio = modulator.getAudioBuffer();
+    mixed.resize(std::max(mixed.size(), audio.size()), 0);
+    for (size_t i = 0; i < audio.size(); i++) {
+      mixed[i] += audio[i];
+    }
+  }
+  const std::vector<int16_t> audio(mixed.begin(), mixed.end());
+
+  psk::ChannelizerSettings settings;
+  settings.threads = static_cast<unsigned int>(state.range(0));
+  psk::Channelizer channelizer(settings);
+  std::vector<psk::Channelizer::Channel> channels;
+  constexpr size_t BLOCK_SIZE = AUDIO_SAMPLE_RATE / 10;
+
+  for (auto _ : state) {
+    channelizer.reset();
+    for (size_t i = 0; i < audio.size(); i += BLOCK_SIZE) {
+      channelizer.process(audio.data() + i,
+                          std::min(BLOCK_SIZE, audio.size() - i));
+    }
+    channelizer.takeText(channels);
+    benchmark::DoNotOptimize(channels.data());
+  }
+  reportSamples(state, audio.size());
+}
+BENCHMARK(BM_PskChannelizer)->Arg(1)->Arg(4);
+
+/// @brief One transform of each size, the rate is transforms per second
+void BM_RealFft(benchmark::State &state) {
+  const auto size = static_cast<size_t>(state.range(0));
+  const auto audio = loadFixture(AUDIO_FIXTURE);
+  const std::vector<float> input(audio.begin(), audio.begin() + size);
+  RealFft fft(size);
+  std::vector<float> power(fft.getNumBins());
+
+  for (auto _ : state) {
+    fft.power(input.data(), power.data());
+    benchmark::DoNotOptimize(power.data());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RealFft)->Arg(256)->Arg(1024)->Arg(4096)->Arg(16384);
+
+/// @brief A waterfall at the default settings, four spectra per fft_size
+void BM_SpectrumAnalyzer(benchmark::State &state) {
+  const auto audio = loadFixture(AUDIO_FIXTURE);
+  SpectrumAnalyzer analyzer(SpectrumSettings{});
+  std::vector<SpectrumAnalyzer::Spectrum> spectra;
+
+  for (auto _ : state) {
+    analyzer.reset();
+    analyzer.process(audio);
+    analyzer.takeSpectra(spectra);
+    benchmark::DoNotOptimize(spectra.data());
+  }
+  reportSamples(state, audio.size());
+}
+BENCHMARK(BM_SpectrumAnalyzer);
+
+} // namespace
@@ -0,0 +1,169 @@
+/// =*============================= SignalEasel ==============================*=
+/// A C++ library for audio modulation/demodulation into analog & digital modes.
+/// Detailed documentation can be found here: https://signaleasel.joshuajer.red
+///
+/// @author Joshua Jerred
+/// @date   2026-10-19
+///
+/// @copyright Copyright 2026 Joshua Jerred. All rights reserved.
+/// @license   This project is licensed under the GNU GPL v3.0 license.
+/// =*========================================================================*=
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <SignalEasel/afsk.hpp>
+#include <SignalEasel/aprs.hpp>
+#include <SignalEasel/psk.hpp>
+
+#include "benchmarks/benchmark_fixtures.hpp"
+
+using namespace signal_easel;
+using benchmarks::reportFrames;
+using benchmarks::reportSamples;
+
+namespace {
+
+const std::string MESSAGE = "The quick brown fox jumps over the lazy dog.";
+
+void BM_AfskModulatorEncode(benchmark::State &state) {
+  afsk::Modulator modulator;
+  size_t num_samples = 0;
+
+  for (auto _ : state) {
+    modulator.clearBuffer();
+    modulator.addString(MESSAGE);
+    num_samples = modulator.getAudioBuffer().size();
+  }
+  reportSamples(state, num_samples);
+}
+BENCHMARK(BM_AfskModulatorEncode);
+
+aprs::PositionPacket positionPacket() {
+  aprs::PositionPacket packet;
+  packet.source_address = "N0CALL";
+  packet.source_ssid = 11;
+  packet.time_code = "092345";
+  packet.latitude = 40.0;
+  packet.longitude = -105.0;
+  packet.altitude = 1000;
+  packet.speed = 100;
+  packet.course = 200;
+  packet.comment = MESSAGE;
+  return packet;
+}
+
+aprs::MessagePacket messagePacket() {
+  aprs::MessagePacket packet;
+  packet.source_address = "N0CALL";
+  packet.source_ssid = 11;
+  packet.addressee = "N0CALL-1";
+  packet.message = MESSAGE;
+  packet.message_id = "1";
+  return packet;
+}
+
+aprs::TelemetryPacket telemetryPacket() {
+  aprs::TelemetryPacket packet;
+  packet.source_address = "N0CALL";
+  packet.source_ssid = 11;
+  packet.telemetry_type = aprs::Packet::Type::TELEMETRY_DATA_REPORT;
+  packet.telemetry_data.setSequenceNumber(123);
+  return packet;
+}
+
+template <typename Packet>
+void BM_AprsModulatorEncode(benchmark::State &state, Packet packet) {
+  aprs::Modulator modulator;
+  size_t num_samples = 0;
+
+  for (auto _ : state) {
+    modulator.clearBuffer();
+    modulator.encode(packet);
+    num_samples = modulator.getAudioBuffer().size();
+  }
+  reportSamples(state, num_samples);
+  reportFrames(state);
+}
+BENCHMARK_CAPTURE(BM_AprsModulatorEncode, position, positionPacket());
+BENCHMARK_CAPTURE(BM_AprsModulatorEncode, message, messagePacket());
+BENCHMARK_CAPTURE(BM_AprsModulatorEncode, telemetry, telemetryPacket());
+
+/// @brief A repeated beacon, every encode after the first is a cache hit.
+void BM_AprsModulatorEncodeCached(benchmark::State &state) {
+  const auto packet = positionPacket();
+  auto cache = std::make_shared<AudioCache>();
+  aprs::Modulator modulator;
+  modulator.useAudioCache(cache);
+  size_t num_samples = 0;
+
+  for (auto _ : state) {
+    modulator.clearBuffer();
+    modulator.encode(packet);
+    num_samples = modulator.getAudioBuffer().size();
+  }
+  reportSamples(state, num_samples);
+  reportFrames(state);
+  state.counters["hit_rate"] =
+      static_cast<double>(cache->getStats().hits) /
+      static_cast<double>(cache->getStats().hits + cache->getStats().misses);
+}
+BENCHMARK(BM_AprsModulatorEncodeCached);
+
+/// @brief A tape of 64 position reports. Arguments are the separation (0 for
+/// flag fill, 1 for silence) and the number of threads.
+void BM_AprsModulatorEncodeBatch(benchmark::State &state) {
+  constexpr size_t NUM_PACKETS = 64;
+  const std::vector<aprs::PositionPacket> packets(NUM_PACKETS,
+                                                  positionPacket());
+  aprs::BatchSettings batch_settings;
+  batch_settings.separation =
+      state.range(0) == 0 ? aprs::BatchSettings::Separation::FLAG_FILL
+                          : aprs::BatchSettings::Separation::SILENCE;
+  batch_settings.silence_samples = AUDIO_SAMPLE_RATE / 10;
+  batch_settings.threads = static_cast<unsigned int>(state.range(1));
+  aprs::Modulator modulator;
+  size_t num_samples = 0;
+
+  for (auto _ : state) {
+    modulator.clearBuffer();
+    modulator.encodeBatch(packets, batch_settings);
+    num_samples = modulator.getAudioBuffer().size();
+  }
+  reportSamples(state, num_samples);
+  reportFrames(state, NUM_PACKETS);
+}
+BENCHMARK(BM_AprsModulatorEncodeBatch)
+    ->Args({0, 1})
+    ->Args({1, 1})
+    ->Args({1, 4})
+    ->UseRealTime();
+
+void BM_PskModulatorEncode(benchmark::State &state, psk::Settings::Mode mode,
+                           psk::Settings::SymbolRate symbol_rate) {
+  psk::Settings settings;
+  settings.mode = mode;
+  settings.symbol_rate = symbol_rate;
+  psk::Modulator modulator(settings);
+  size_t num_samples = 0;
+
+  for (auto _ : state) {
+    modulator.clearBuffer();
+    modulator.encodeString(MESSAGE);
+    num_samples = modulator.getAudioBuffer().size();
+  }
+  reportSamples(state, num_samples);
+}
+BENCHMARK_CAPTURE(BM_PskModulatorEncode, bpsk_125, psk::Settings::Mode::BPSK,
+                  psk::Settings::SymbolRate::SR_125);
+BENCHMARK_CAPTURE(BM_PskModulatorEncode, bpsk_1000, psk::Settings::Mode::BPSK,
+                  psk::Settings::SymbolRate::SR_1000);
+BENCHMARK_CAPTURE(BM_PskModulatorEncode, qpsk_125, psk::Settings::Mode::QPSK,
+                  psk::Settings::SymbolRate::SR_125);
+BENCHMARK_CAPTURE(BM_PskModulatorEncode, qpsk_1000, psk::Settings::Mode::QPSK,
+                  psk::Settings::SymbolRate::SR_1000);
+
+} // namespace
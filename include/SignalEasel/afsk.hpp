@@ -9,14 +9,21 @@
 #ifndef SIGNAL_EASEL_AFSK_HPP_
 #define SIGNAL_EASEL_AFSK_HPP_
 
+#include <array>
+#include <chrono>
+#include <memory>
+#include <string>
 #include <vector>
 
 #include <SignalEasel/constants.hpp>
 
+#include <SignalEasel/audio_cache.hpp>
 #include <SignalEasel/bit_stream.hpp>
 #include <SignalEasel/demodulator.hpp>
 #include <SignalEasel/modulator.hpp>
 #include <SignalEasel/receiver.hpp>
+#include <SignalEasel/resampler.hpp>
+#include <SignalEasel/spectrum.hpp>
 
 namespace signal_easel {
 namespace aprs {
@@ -50,8 +57,35 @@ inline constexpr double AFSK_BP_INCLUDED_BANDWIDTH =
     AFSK_BP_MARK_UPPER_CUTOFF - AFSK_BP_MARK_LOWER_CUTOFF +
     AFSK_BP_SPACE_UPPER_CUTOFF - AFSK_BP_SPACE_LOWER_CUTOFF;
 
+/// @brief The lowest sample rate the demodulator can run at internally. The
+/// SNR estimate's noise bins reach up to 2900 Hz, so this keeps the whole band
+/// of interest below Nyquist.
+inline constexpr uint32_t AFSK_MIN_DEMODULATION_SAMPLE_RATE = 9600;
+
+/// @brief The resampler filter length used when demodulating at a reduced
+/// rate. The signal stops well short of the new Nyquist frequency, so a short
+/// filter is plenty.
+inline constexpr uint32_t AFSK_RESAMPLER_FILTER_HALF_LENGTH = 8;
+
+/// @brief The furthest automatic frequency control can retune the tones. The
+/// mark and space band-pass filters are 400 Hz wide, further out the tones
+/// fall off their edges.
+inline constexpr uint32_t AFSK_AFC_MAX_RANGE = 200;
+
+/// @brief Automatic frequency control retunes the tones in whole steps of
+/// this, so the oscillator tables stay short. Well inside the correlator's
+/// tolerance at 1200 baud.
+inline constexpr uint32_t AFSK_AFC_STEP = 10;
+
+/// @brief The range of the SNR estimate, in dB. The SNR is the signal's power
+/// over the noise between AFSK_BP_MARK_LOWER_CUTOFF and
+/// AFSK_BP_SPACE_UPPER_CUTOFF.
 inline constexpr double AFSK_MINIMUM_SNR = -50.0;
-inline constexpr double AFSK_SNR_THRESHOLD = -10.0;
+inline constexpr double AFSK_MAXIMUM_SNR = 60.0;
+
+/// @brief The SNR a block of audio must beat for the receiver to treat it as
+/// a signal, in dB.
+inline constexpr double AFSK_SNR_THRESHOLD = 0.0;
 
 // seconds * samples per second
 inline constexpr size_t AFSK_RECEIVER_SAMPLE_BUFFER_SIZE =
@@ -73,6 +107,10 @@ inline constexpr size_t PERIODIC_DECODE_SAMPLE_COUNT = 2 * AUDIO_SAMPLE_RATE;
 /// longer than any APRS frame.
 inline constexpr size_t DECODE_TAIL_SAMPLE_COUNT = 1 * AUDIO_SAMPLE_RATE;
 
+class ToneDetector;
+class SnrEstimator;
+class DemodulatorBenchmark;
+
 /**
  * @brief Settings for AFSK modulation/demodulation.
  */
@@ -85,6 +123,57 @@ struct Settings : public signal_easel::Settings {
    * @brief If true, a string will be surrounded by SYN and EOT characters.
    */
   bool include_ascii_padding = true;
+
+  /**
+   * @brief The sample rate the demodulator runs at internally.
+   * @details Audio is always handed to the demodulator at AUDIO_SAMPLE_RATE.
+   * When this is lower, the audio is resampled first and the filters,
+   * correlator and clock recovery all run at the reduced rate. 9600 cuts the
+   * per-sample work about fivefold. Must be a multiple of AFSK_BAUD_RATE
+   * between AFSK_MIN_DEMODULATION_SAMPLE_RATE and AUDIO_SAMPLE_RATE.
+   */
+  uint32_t demodulation_sample_rate = AUDIO_SAMPLE_RATE;
+
+  /**
+   * @brief If true, the receiver band-limits and decimates the incoming audio
+   * once, as it arrives, down to demodulation_sample_rate. Signal detection,
+   * the receive buffer and decoding then all work on the decimated audio
+   * instead of each re-processing it at AUDIO_SAMPLE_RATE.
+   * @details demodulation_sample_rate must divide AUDIO_SAMPLE_RATE evenly
+   * (ie. 9600, 12000, 16000 or 24000 - but also a multiple of
+   * AFSK_BAUD_RATE).
+   */
+  bool decimating_front_end = false;
+
+  /**
+   * @brief The tone detector that turns the filtered audio into the base band
+   * signal.
+   * @details Both mix each tone down to I/Q and compare the power of the
+   * low-passed tones. CORRELATOR low-passes with a boxcar one symbol long,
+   * matched to the symbols so it holds up best on weak signals, but it
+   * re-sums the whole symbol for every sample. QUADRATURE_MIXER uses two
+   * cascaded single-pole IIR sections per I/Q arm instead, a fixed few
+   * operations per sample for CPU constrained stations, at the cost of
+   * passing more noise and smearing each symbol into the next.
+   */
+  enum class DemodulationEngine { CORRELATOR, QUADRATURE_MIXER };
+
+  Settings::DemodulationEngine demodulation_engine =
+      DemodulationEngine::CORRELATOR;
+
+  /**
+   * @brief Automatic frequency control, the furthest the demodulator retunes
+   * the mark and space tones from AFSK_MARK_FREQUENCY and
+   * AFSK_SPACE_FREQUENCY, in Hz. 0 disables it. At most AFSK_AFC_MAX_RANGE.
+   * @details Each buffer's offset is measured from how fast the phase of each
+   * tone's mixer output turns while that tone is being received, and the
+   * tones are retuned for that buffer and the ones after it. A receiver only
+   * demodulates when it decodes, so the offset is measured and the tones
+   * retuned in each decode pass, over the audio being decoded. Signal
+   * detection searches for the tones across the whole range, so mistuned
+   * signals are not missed. See Demodulator::ProcessResults::frequency_offset.
+   */
+  uint32_t afc_range = 0;
 };
 
 /**
@@ -93,13 +182,41 @@ struct Settings : public signal_easel::Settings {
 class Modulator : public DataModulator {
 public:
   Modulator(afsk::Settings settings = afsk::Settings())
-      : settings_(std::move(settings)) {}
+      : settings_(std::move(settings)) {
+    buildToneTable();
+  }
   ~Modulator() = default;
 
+  /**
+   * @brief Look up the audio of each block of data (each APRS packet) in a
+   * cache before rendering it, and add what is rendered.
+   * @details The key is the data, the settings that shape the audio and the
+   * phase the tone starts at, so cached audio is sample for sample what would
+   * have been rendered. The cache can be shared between modulators.
+   * @param cache The cache to use, nullptr to stop caching
+   */
+  void useAudioCache(std::shared_ptr<AudioCache> cache) {
+    audio_cache_ = std::move(cache);
+  }
+
+  std::shared_ptr<AudioCache> getAudioCache() const { return audio_cache_; }
+
 protected:
   void encodeBytes(const std::vector<uint8_t> &input_bytes) override;
 
+  /// @brief Start the next bytes from the phase a new transmission starts at
+  void resetPhase() { integral_value_ = 0; }
+
 private:
+  /// @brief Modulate the bytes (with any padding) onto the audio buffer
+  void renderBytes(const std::vector<uint8_t> &input_bytes);
+
+  /// @brief Fill tone_table_ with one cycle of the carrier at the amplitude
+  void buildToneTable();
+
+  /// @brief Build the audio cache key for the bytes into cache_key_
+  void buildCacheKey(const std::vector<uint8_t> &input_bytes);
+
   /**
    * @brief Converts the data to NRZI for APRS mode.
    * @details NRZI encoding (Non Return to Zero Inverted), 0 is encoded as a
@@ -111,8 +228,6 @@ private:
   afsk::Settings settings_;
 
   bool nrzi_previous_tone_mark_ = false;
-  int8_t current_bipolar_bit_ = 0;
-  int8_t previous_bipolar_bit_ = 0;
   int32_t integral_value_ = 0;
 
   static constexpr uint32_t OVER_SAMPLE_FACTOR_ = 4;
@@ -121,10 +236,49 @@ private:
   static constexpr uint32_t SAMPLES_PER_SYMBOL_ =
       SAMPLE_FREQUENCY_ / AFSK_BAUD_RATE;
 
-  static constexpr double CENTER_OVER_SAMPLE_FREQ_ =
-      static_cast<double>(AFSK_CENTER_FREQUENCY) / SAMPLE_FREQUENCY_;
-  static constexpr double DELTA_OVER_SAMPLE_FREQ_ =
-      static_cast<double>(AFSK_FREQUENCY_DEVIATION) / SAMPLE_FREQUENCY_;
+  static constexpr uint32_t OUTPUT_SAMPLES_PER_SYMBOL_ =
+      SAMPLES_PER_SYMBOL_ / OVER_SAMPLE_FACTOR_;
+
+  /**
+   * @brief The entries in the tone table, one cycle of the carrier.
+   * @details The phase at every oversampled step is a whole number of
+   * 1/TONE_TABLE_SIZE_ turns, so a sample is a lookup instead of a cosine.
+   * Each symbol walks the table by a fixed step per sample for its tone,
+   * starting wherever the previous symbol left the phase.
+   */
+  static constexpr uint32_t TONE_TABLE_SIZE_ = 1920;
+  static_assert(
+      AFSK_CENTER_FREQUENCY * TONE_TABLE_SIZE_ % SAMPLE_FREQUENCY_ == 0 &&
+          AFSK_FREQUENCY_DEVIATION * TONE_TABLE_SIZE_ % SAMPLE_FREQUENCY_ == 0,
+      "The tones must land on the tone table at every oversampled step");
+
+  /// @brief Phase advanced by the center frequency per oversampled step
+  static constexpr uint32_t CENTER_PHASE_STEP_ =
+      AFSK_CENTER_FREQUENCY * TONE_TABLE_SIZE_ / SAMPLE_FREQUENCY_;
+  /// @brief Phase advanced per oversampled step per unit of the integrator
+  static constexpr uint32_t DELTA_PHASE_STEP_ =
+      AFSK_FREQUENCY_DEVIATION * TONE_TABLE_SIZE_ / SAMPLE_FREQUENCY_;
+  static_assert(CENTER_PHASE_STEP_ > DELTA_PHASE_STEP_);
+
+  /// @brief The phase advanced by one oversampled step
+  /// @param integral_step How far the integrator moves, -1, 0 or 1
+  static constexpr uint32_t getPhaseStep(int32_t integral_step) {
+    return static_cast<uint32_t>(
+        static_cast<int32_t>(CENTER_PHASE_STEP_) +
+        integral_step * static_cast<int32_t>(DELTA_PHASE_STEP_));
+  }
+
+  /// @brief The integrator values that make one full turn of the deviation
+  /// phase. Keeping the integrator within one turn doesn't change the tone,
+  /// but makes the samples depend only on the data and the starting phase.
+  static constexpr int32_t INTEGRAL_PERIOD_ =
+      SAMPLE_FREQUENCY_ / AFSK_FREQUENCY_DEVIATION;
+  static_assert(SAMPLE_FREQUENCY_ % AFSK_FREQUENCY_DEVIATION == 0);
+
+  std::array<int16_t, TONE_TABLE_SIZE_> tone_table_{};
+
+  std::shared_ptr<AudioCache> audio_cache_{};
+  std::string cache_key_{};
 };
 
 /**
@@ -134,6 +288,8 @@ class Demodulator : public signal_easel::Demodulator {
 public:
   friend class Receiver;
   friend class aprs::Receiver;
+  /// @brief Lets the benchmarks time the demodulation stages on their own
+  friend class DemodulatorBenchmark;
 
   /**
    * @brief Stats related to the processing of the audio buffer.
@@ -141,20 +297,42 @@ public:
    */
   struct ProcessResults {
     /**
-     * @brief RMS of the input signal (received audio power).
+     * @brief RMS of the input signal (received audio power), in PCM units.
      */
     double rms = 0.0;
 
     /**
-     * @brief Estimated Signal to Noise Ratio (SNR) of the input signal.
+     * @brief Estimated Signal to Noise Ratio (SNR) of the input signal, in dB.
+     * @see AFSK_MINIMUM_SNR
      */
     double snr = 0.0;
+
+    /**
+     * @brief The offset of the received tones from AFSK_MARK_FREQUENCY and
+     * AFSK_SPACE_FREQUENCY, in Hz, as measured by automatic frequency
+     * control. Always zero when Settings::afc_range is 0.
+     */
+    double frequency_offset = 0.0;
+
+    /**
+     * @brief Time spent in the filter (including resampling), tone detection
+     * and clock recovery stages. Always zero when the library is built
+     * without SIGNALEASEL_INSTRUMENTATION.
+     */
+    std::chrono::nanoseconds filter_time{0};
+    std::chrono::nanoseconds correlator_time{0};
+    std::chrono::nanoseconds clock_recovery_time{0};
   };
 
-  Demodulator(afsk::Settings settings = afsk::Settings())
-      : signal_easel::Demodulator(settings),
-        afsk_settings_(std::move(settings)) {}
-  ~Demodulator() = default;
+  /**
+   * @brief Constructor
+   * @param settings The AFSK settings
+   * @exception signal_easel::Exception AFSK_INVALID_DEMODULATION_SAMPLE_RATE
+   * @exception signal_easel::Exception VALIDATION_ERROR if afc_range is over
+   * AFSK_AFC_MAX_RANGE
+   */
+  Demodulator(afsk::Settings settings = afsk::Settings());
+  ~Demodulator();
 
   ProcessResults processAudioBuffer();
 
@@ -185,9 +363,43 @@ private:
    */
   void baseBandToBitStream(ProcessResults &results);
 
+  /**
+   * @brief Returns the audio buffer at the demodulation sample rate,
+   * resampling it first if needed.
+   */
+  const std::vector<int16_t> &getDemodulationBuffer();
+
+  /**
+   * @brief Drops the bits of output_bit_stream_ up to the end of the SYN
+   * preamble, leaving it at the STX character.
+   * @details The clock recovery is still settling during the first few
+   * characters and can slip by a bit or more, which would read the rest of
+   * the preamble (and the text after it) out of alignment. Whenever the
+   * next byte is not a SYN, a SYN up to 7 bits further on that is followed
+   * by another SYN or the STX re-aligns the stream, otherwise the preamble
+   * has ended.
+   * @return false if there is no SYN character in the bit stream
+   */
+  bool alignOnPreamble();
+
   std::vector<uint8_t> base_band_signal_{};
 
   afsk::Settings afsk_settings_;
+
+  /// @brief The internal sample rate, see Settings::demodulation_sample_rate
+  uint32_t sample_rate_ = AUDIO_SAMPLE_RATE;
+  /// @brief True when audio_buffer_ is already at sample_rate_ because it came
+  /// through the receiver's decimating front end.
+  bool audio_at_demodulation_rate_ = false;
+  /// @brief The symbol length at sample_rate_
+  int32_t samples_per_symbol_ = AFSK_SAMPLES_PER_SYMBOL;
+
+  /// @brief Converts from AUDIO_SAMPLE_RATE to sample_rate_
+  Resampler resampler_{AUDIO_SAMPLE_RATE, AUDIO_SAMPLE_RATE};
+  std::vector<int16_t> resampled_audio_{};
+
+  /// @brief The filter, SNR and tone detection stages
+  std::unique_ptr<ToneDetector> tone_detector_{};
 };
 
 /**
@@ -195,10 +407,13 @@ private:
  */
 class Receiver : public signal_easel::Receiver {
 public:
-  Receiver(afsk::Settings settings = afsk::Settings())
-      : signal_easel::Receiver(settings), demodulator_(settings),
-        afsk_settings_(settings) {}
-  ~Receiver() = default;
+  /**
+   * @brief Constructor
+   * @param settings The AFSK settings
+   * @exception signal_easel::Exception AFSK_INVALID_DEMODULATION_SAMPLE_RATE
+   */
+  Receiver(afsk::Settings settings = afsk::Settings());
+  ~Receiver();
 
   /**
    * @brief Returns true if there was enough data to process.
@@ -212,10 +427,67 @@ public:
   /// @return The current SNR
   double getLiveSnr() { return live_snr_; }
 
+  /// @brief Get the frequency offset measured by automatic frequency control
+  /// (see Settings::afc_range), the tones' offset in Hz.
+  double getFrequencyOffset() const { return frequency_offset_; }
+
+  /**
+   * @brief Start computing power spectra of the received audio, for a live
+   * waterfall. Replaces the analyzer (and any spectra not yet taken) if it
+   * was already enabled.
+   * @param settings See SpectrumSettings
+   * @exception signal_easel::Exception VALIDATION_ERROR
+   */
+  void enableSpectrum(SpectrumSettings settings = SpectrumSettings());
+
+  /**
+   * @brief Move the spectra of the audio received since the last call into
+   * spectra, oldest first.
+   * @param spectra (out) Replaced with the spectra
+   * @return true if there were any, false if there were none or
+   * enableSpectrum() has not been called
+   */
+  bool takeSpectra(std::vector<SpectrumAnalyzer::Spectrum> &spectra);
+
+  /// @brief The analyzer behind takeSpectra(), for it's bin frequencies and
+  /// band power. nullptr until enableSpectrum() is called.
+  const SpectrumAnalyzer *getSpectrumAnalyzer() const {
+    return spectrum_analyzer_.get();
+  }
+
 protected:
-  bool detectSignal(const PulseAudioBuffer &audio_buffer);
+  bool detectSignal(const PulseAudioBuffer &audio_buffer) {
+    return detectSignal(audio_buffer.data(), audio_buffer.size());
+  }
+
+  /**
+   * @brief Run signal detection on a block of audio, accumulating it into the
+   * receive buffer and decoding when appropriate.
+   * @details Detection only estimates the block's SNR, the audio is not
+   * demodulated until it is decoded.
+   * @param samples Pointer to the first sample of the block
+   * @param num_samples The number of samples in the block
+   * @return true if a signal was detected in the block
+   */
+  bool detectSignal(const int16_t *samples, size_t num_samples);
   virtual void decode();
 
+  /// @brief Decode anything left in the receive buffer. Used when the audio
+  /// source ends so a packet at the very end of a stream is not lost.
+  void flushReceiveBuffer();
+
+  /**
+   * @brief Add the stage times of a demodulation pass to processing_stats_.
+   * @param results The results of the pass
+   * @param clock_recovery True if the pass went on to clock recovery
+   */
+  void recordDemodulation(const afsk::Demodulator::ProcessResults &results,
+                          bool clock_recovery);
+
+  /// @brief Add the time since the audio that completed a packet arrived to
+  /// the latency histogram. Call as each packet is delivered.
+  void recordPacketDelivered();
+
   /// @brief After a periodic decode, trim the receive buffer to keep only
   /// the last DECODE_TAIL_SAMPLE_COUNT samples. This gives a packet that
   /// straddled the decode boundary a chance to be recovered by the next
@@ -228,7 +500,29 @@ protected:
 
   std::vector<int16_t> receive_buffer_{};
 
+  /// @brief Band-limits and decimates incoming audio when
+  /// Settings::decimating_front_end is set.
+  Resampler front_end_{AUDIO_SAMPLE_RATE, AUDIO_SAMPLE_RATE};
+  std::vector<int16_t> front_end_buffer_{};
+
+  /// @brief Measures each block's SNR for signal detection
+  std::unique_ptr<SnrEstimator> snr_estimator_;
+
+  /// @brief Fed every block of audio at AUDIO_SAMPLE_RATE, see
+  /// enableSpectrum()
+  std::unique_ptr<SpectrumAnalyzer> spectrum_analyzer_ = nullptr;
+
+  /// @brief AFSK_RECEIVED_MIN_SAMPLES, PERIODIC_DECODE_SAMPLE_COUNT and
+  /// DECODE_TAIL_SAMPLE_COUNT at the rate of the receive buffer.
+  size_t received_min_samples_ = AFSK_RECEIVED_MIN_SAMPLES;
+  size_t periodic_decode_sample_count_ = PERIODIC_DECODE_SAMPLE_COUNT;
+  size_t decode_tail_sample_count_ = DECODE_TAIL_SAMPLE_COUNT;
+
   double live_snr_ = 0.0;
+  double frequency_offset_ = 0.0;
+
+  /// @brief When the last block of audio with a signal in it arrived
+  std::chrono::steady_clock::time_point last_signal_arrival_{};
 };
 
 } // namespace afsk
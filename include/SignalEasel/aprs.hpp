@@ -9,13 +9,17 @@
 #ifndef SIGNAL_EASEL_APRS_HPP_
 #define SIGNAL_EASEL_APRS_HPP_
 
+#include <cstddef>
 #include <cstdint>
 #include <string>
+#include <vector>
 
 #include <BoosterSeat/time.hpp>
 
 #include <SignalEasel/afsk.hpp>
+#include <SignalEasel/aprs/base91.hpp>
 #include <SignalEasel/aprs/packets.hpp>
+#include <SignalEasel/aprs/position_parser.hpp>
 #include <SignalEasel/aprs/telemetry_transcoder.hpp>
 #include <SignalEasel/ax25.hpp>
 
@@ -30,6 +34,35 @@ struct Settings : public afsk::Settings {
   }
 };
 
+/**
+ * @brief How Modulator::encodeBatch lays out a batch of packets.
+ */
+struct BatchSettings {
+  enum class Separation {
+    /// @brief One transmission, with flags between the frames (a burst)
+    FLAG_FILL,
+    /// @brief A transmission per frame, with silence between them
+    SILENCE
+  };
+
+  Separation separation = Separation::FLAG_FILL;
+
+  /// @brief The flags between two frames with FLAG_FILL, at least one
+  size_t fill_flags = 8;
+
+  /// @brief The silence between two frames with SILENCE, in samples
+  uint32_t silence_samples = AUDIO_SAMPLE_RATE;
+
+  /**
+   * @brief The threads to render the frames on with SILENCE, 1 renders them
+   * on the calling thread.
+   * @details Every transmission starts at the same phase, so the audio does
+   * not depend on the number of threads. FLAG_FILL is one continuous
+   * transmission and is always rendered on the calling thread.
+   */
+  unsigned int threads = 1;
+};
+
 class Modulator : public afsk::Modulator {
 public:
   Modulator(aprs::Settings settings = aprs::Settings())
@@ -41,7 +74,33 @@ public:
   void encode(const aprs::ExperimentalPacket &packet);
   void encode(const aprs::TelemetryPacket &packet);
 
+  /**
+   * @brief Encode many packets back to back, for test tapes and bursts.
+   * @details The frames are built first and the audio buffer grows once.
+   * @tparam PacketType Any of the packet types encode() takes
+   * @param packets The packets, in the order to send them
+   * @param count The number of packets
+   * @param batch_settings How to separate the frames
+   * @exception signal_easel::Exception NO_DATA_TO_WRITE if there are no
+   * packets, or any exception encode() would throw for a packet.
+   */
+  template <typename PacketType>
+  void encodeBatch(const PacketType *const *packets, size_t count,
+                   const BatchSettings &batch_settings = BatchSettings());
+
+  /// @brief Like encodeBatch(packets, count, batch_settings), for a vector
+  template <typename PacketType>
+  void encodeBatch(const std::vector<PacketType> &packets,
+                   const BatchSettings &batch_settings = BatchSettings());
+
 private:
+  /// @brief Render frames built by encodeBatch
+  void encodeFrames(std::vector<ax25::Frame> &frames,
+                    const BatchSettings &batch_settings);
+
+  /// @brief Render an encoded frame as a transmission of it's own
+  void encodeTransmission(const std::vector<uint8_t> &encoded_frame);
+
   aprs::Settings settings_;
 };
 
@@ -76,8 +135,8 @@ public:
   /**
    * @brief If the packet was a position packet, this function will try to
    * parse the packet into it's positional data.
-   * @todo This function will not be friendly to many types of aprs position
-   * packets.
+   * @details Compressed, uncompressed and Mic-E reports are supported, see
+   * position_parser.hpp. Does not throw.
    * @param position (out) The position packet
    * @return true if the packet was fully parsed
    * @return false if the packet was not a valid position packet
@@ -99,6 +158,12 @@ private:
 
   ax25::Frame frame_{};
   aprs::Packet::Type type_ = aprs::Packet::Type::UNKNOWN;
+
+  /// @brief Frames are parsed into here and swapped into frame_ when they
+  /// are APRS, so neither gives up it's storage on a failed candidate.
+  ax25::Frame candidate_frame_{};
+  /// @brief The de-stuffed bytes of the frame being parsed
+  std::vector<uint8_t> frame_buffer_{};
 };
 
 class Receiver : public signal_easel::afsk::Receiver {
@@ -120,8 +185,7 @@ public:
     uint32_t current_other_packets_in_queue = 0;
   };
 
-  Receiver(aprs::Settings settings = aprs::Settings())
-      : afsk::Receiver(settings) {}
+  Receiver(aprs::Settings settings = aprs::Settings());
 
   bool getAprsMessage(aprs::MessagePacket &message_packet, ax25::Frame &frame);
 
@@ -162,18 +226,25 @@ private:
   afsk::Demodulator::ProcessResults demodulation_res_{};
 
   Demodulator aprs_demodulator_{};
+
+  /// @brief The NRZI decoded bit stream of the current decode pass, kept so
+  /// it's storage is reused by the next pass.
+  BitStream nrzi_stream_{};
 };
 
 /// @brief Encodes a string into a base91 encoded string.
+/// @details Allocates, see base91.hpp for the fixed width and batch versions.
 /// @param value - The value to encode.
-/// @param num_bytes - The number of bytes to encode the value into.
+/// @param num_bytes - The number of bytes to encode the value into, 1 to 4.
 /// @return The base91 encoded value, of size num_bytes.
+/// @exception signal_easel::Exception BASE_91_ENCODE_VALUE_NOT_CORRECT_SIZE if
+/// the value is negative or does not fit in num_bytes.
 std::vector<uint8_t> base91Encode(int value, unsigned int num_bytes);
 
 /// @brief Decodes a base91 encoded value to an integer.
 /// @param encoded - A vector of bytes that represent the base91 encoded value.
 /// @return The decoded integer.
-int base91Decode(std::vector<uint8_t> encoded);
+int base91Decode(const std::vector<uint8_t> &encoded);
 
 /// @brief The base function to encode an APRS packet with the provided base
 /// data and info field.
@@ -184,6 +255,36 @@ int base91Decode(std::vector<uint8_t> encoded);
 std::vector<uint8_t> encodePacket(const aprs::Packet &required_fields,
                                   std::vector<uint8_t> &info);
 
+/// @brief Like encodePacket, but returns the AX.25 frame before it is encoded.
+/// @param required_fields - The required fields for the packet, a base APRS
+/// packet.
+/// @param info - The information field of the APRS packet.
+/// @return The AX.25 frame of the packet.
+ax25::Frame buildPacketFrame(const aprs::Packet &required_fields,
+                             std::vector<uint8_t> info);
+
+template <typename PacketType>
+void Modulator::encodeBatch(const PacketType *const *packets, size_t count,
+                            const BatchSettings &batch_settings) {
+  std::vector<ax25::Frame> frames;
+  frames.reserve(count);
+  for (size_t i = 0; i < count; i++) {
+    frames.push_back(buildPacketFrame(*packets[i], packets[i]->encode()));
+  }
+  encodeFrames(frames, batch_settings);
+}
+
+template <typename PacketType>
+void Modulator::encodeBatch(const std::vector<PacketType> &packets,
+                            const BatchSettings &batch_settings) {
+  std::vector<const PacketType *> pointers;
+  pointers.reserve(packets.size());
+  for (const PacketType &packet : packets) {
+    pointers.push_back(&packet);
+  }
+  encodeBatch(pointers.data(), pointers.size(), batch_settings);
+}
+
 } // namespace signal_easel::aprs
 
 // struct MessageNack {
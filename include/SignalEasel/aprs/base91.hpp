@@ -0,0 +1,142 @@
+/// =*============================= SignalEasel ==============================*=
+/// A C++ library for audio modulation/demodulation into analog & digital modes.
+/// Detailed documentation can be found here: https://signaleasel.joshuajer.red
+///
+/// @author Joshua Jerred
+/// @date   2026-10-19
+///
+/// @copyright Copyright 2026 Joshua Jerred. All rights reserved.
+/// @license   This project is licensed under the GNU GPL v3.0 license.
+/// =*========================================================================*=
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include <SignalEasel/exception.hpp>
+
+namespace signal_easel::aprs {
+
+/// @brief The first base-91 character, digits are offset by this.
+inline constexpr uint8_t BASE91_OFFSET = '!';
+
+/// @brief The widest field that fits in a uint32_t. Compressed positions are
+/// 4 characters, telemetry and Mic-E altitudes 2 and 3.
+inline constexpr size_t BASE91_MAX_WIDTH = 4;
+
+/// @brief 91^i, the place values of a base-91 field.
+inline constexpr std::array<uint32_t, BASE91_MAX_WIDTH + 1> BASE91_POWERS = {
+    1, 91, 8281, 753571, 68574961};
+
+/// @brief Encodes a value into a fixed width base-91 field, most significant
+/// digit first.
+/// @tparam WIDTH - The number of characters, 1 to BASE91_MAX_WIDTH.
+/// @param value - The value to encode, less than 91^WIDTH.
+/// @param[out] encoded - The field, untouched if the value is out of range.
+/// @return \c true if the value fit in the field.
+template <size_t WIDTH>
+constexpr bool base91EncodeFixed(uint32_t value,
+                                 std::array<uint8_t, WIDTH> &encoded) {
+  static_assert(WIDTH > 0 && WIDTH <= BASE91_MAX_WIDTH,
+                "Base-91 fields are 1 to 4 characters wide");
+  if (value >= BASE91_POWERS[WIDTH]) {
+    return false;
+  }
+  for (size_t i = WIDTH; i > 0; i--) {
+    encoded[i - 1] = static_cast<uint8_t>(value % 91 + BASE91_OFFSET);
+    value /= 91;
+  }
+  return true;
+}
+
+/// @brief Like base91EncodeFixed(value, encoded), but returns the field so it
+/// can initialise a constant.
+/// @exception signal_easel::Exception BASE_91_ENCODE_VALUE_NOT_CORRECT_SIZE if
+/// the value does not fit (a compile error in a constant expression).
+template <size_t WIDTH>
+constexpr std::array<uint8_t, WIDTH> base91EncodeFixed(uint32_t value) {
+  std::array<uint8_t, WIDTH> encoded{};
+  if (!base91EncodeFixed(value, encoded)) {
+    throw Exception(Exception::Id::BASE_91_ENCODE_VALUE_NOT_CORRECT_SIZE);
+  }
+  return encoded;
+}
+
+/// @brief Decodes a base-91 field, most significant digit first.
+/// @param encoded - The field, 1 to BASE91_MAX_WIDTH characters.
+/// @param[out] value - The decoded value.
+/// @return \c false if the field is empty, too wide or has a character
+/// outside of '!' to '{'.
+constexpr bool base91Decode(std::string_view encoded, uint32_t &value) {
+  if (encoded.empty() || encoded.size() > BASE91_MAX_WIDTH) {
+    return false;
+  }
+  uint32_t decoded = 0;
+  for (size_t i = 0; i < encoded.size(); i++) {
+    const uint8_t character = static_cast<uint8_t>(encoded[i]);
+    if (character < BASE91_OFFSET || character > BASE91_OFFSET + 90) {
+      return false;
+    }
+    decoded += (character - BASE91_OFFSET) *
+               BASE91_POWERS[encoded.size() - i - 1];
+  }
+  value = decoded;
+  return true;
+}
+
+/// @brief Decodes a fixed width base-91 field.
+template <size_t WIDTH>
+constexpr bool base91DecodeFixed(const std::array<uint8_t, WIDTH> &encoded,
+                                 uint32_t &value) {
+  static_assert(WIDTH > 0 && WIDTH <= BASE91_MAX_WIDTH,
+                "Base-91 fields are 1 to 4 characters wide");
+  uint32_t decoded = 0;
+  for (size_t i = 0; i < WIDTH; i++) {
+    if (encoded[i] < BASE91_OFFSET || encoded[i] > BASE91_OFFSET + 90) {
+      return false;
+    }
+    decoded += (encoded[i] - BASE91_OFFSET) * BASE91_POWERS[WIDTH - i - 1];
+  }
+  value = decoded;
+  return true;
+}
+
+/// @brief Encodes consecutive values into consecutive fixed width fields, as
+/// in compressed telemetry ("|ssAAbbccddeeff|").
+/// @param values - The values to encode.
+/// @param count - The number of values.
+/// @param[out] output - Room for count * WIDTH characters.
+/// @return \c false if a value did not fit. The fields before it are written.
+template <size_t WIDTH>
+constexpr bool base91EncodeBatch(const uint32_t *values, size_t count,
+                                 uint8_t *output) {
+  std::array<uint8_t, WIDTH> field{};
+  for (size_t i = 0; i < count; i++) {
+    if (!base91EncodeFixed(values[i], field)) {
+      return false;
+    }
+    for (size_t j = 0; j < WIDTH; j++) {
+      output[i * WIDTH + j] = field[j];
+    }
+  }
+  return true;
+}
+
+/// @brief Like base91EncodeBatch(values, count, output), for a fixed number of
+/// values, returning the fields so they can initialise a constant.
+/// @exception signal_easel::Exception BASE_91_ENCODE_VALUE_NOT_CORRECT_SIZE if
+/// a value does not fit.
+template <size_t WIDTH, size_t COUNT>
+constexpr std::array<uint8_t, WIDTH * COUNT>
+base91EncodeBatch(const std::array<uint32_t, COUNT> &values) {
+  std::array<uint8_t, WIDTH * COUNT> encoded{};
+  if (!base91EncodeBatch<WIDTH>(values.data(), COUNT, encoded.data())) {
+    throw Exception(Exception::Id::BASE_91_ENCODE_VALUE_NOT_CORRECT_SIZE);
+  }
+  return encoded;
+}
+
+} // namespace signal_easel::aprs
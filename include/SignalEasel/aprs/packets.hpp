@@ -50,6 +50,13 @@ struct Packet {
 };
 
 struct PositionPacket : public Packet {
+  /// @brief The position report formats, see position_parser.hpp
+  enum class Format { COMPRESSED, UNCOMPRESSED, MIC_E };
+
+  /// @brief The format the position was received in. Set when decoding,
+  /// encode() always uses the compressed format.
+  Format format = Format::COMPRESSED;
+
   std::string time_code = ""; // ddhhmm in *UTC* specifically.
   float latitude = 0.0;       // Decimal degrees
   float longitude = 0.0;      // Decimal degrees
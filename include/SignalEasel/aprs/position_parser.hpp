@@ -0,0 +1,63 @@
+/**
+ * =*========SignalEasel========*=
+ * A friendly library for signal modulation and demodulation.
+ * https://github.com/joshua-jerred/Giraffe
+ * https://joshuajer.red/signal-easel
+ * =*===========================*=
+ *
+ * @file   position_parser.hpp
+ * @date   2026-10-19
+ * @brief  Parsing APRS position reports
+ *
+ * =*=======================*=
+ * @copyright  2026 Joshua Jerred
+ * @license    GNU GPLv3
+ */
+
+#ifndef SIGNAL_EASEL_APRS_POSITION_PARSER_HPP_
+#define SIGNAL_EASEL_APRS_POSITION_PARSER_HPP_
+
+#include <string_view>
+
+#include <SignalEasel/aprs/packets.hpp>
+
+namespace signal_easel::aprs {
+
+/// @brief Checks if the first character of an information field is one of the
+/// APRS position data type identifiers ('!', '=', '/', '@', and the Mic-E
+/// identifiers '`', '\'', 0x1c and 0x1d).
+/// @param data_type - The first character of the information field.
+/// @return \c true if the information field holds a position report.
+bool isPositionDataType(char data_type);
+
+/// @brief Parses a position report, compressed or uncompressed, with or
+/// without a timestamp.
+/// @details Does not allocate, other than to grow the time code and comment
+/// strings of \p position past their current capacity, and never throws. An
+/// "/A=" altitude is taken out of the comment. Position ambiguity (spaces in
+/// place of digits) is read as zeros.
+/// @param info - The information field, starting with the data type
+/// identifier ('!', '=', '/' or '@').
+/// @param[out] position - The symbol, position, course, speed, altitude,
+/// time code and comment. Fields the report does not contain are zeroed.
+/// @return \c true if the report was parsed, \c false if it was malformed or
+/// not a (non Mic-E) position report.
+bool parsePositionInformation(std::string_view info, PositionPacket &position);
+
+/// @brief Parses a Mic-E position report. The latitude is carried in the AX.25
+/// destination address, the rest in the information field.
+/// @details Like parsePositionInformation, does not allocate or throw. The
+/// Mic-E message bits are not decoded.
+/// @param destination - The destination address, without the SSID (six
+/// characters).
+/// @param info - The information field, starting with the data type
+/// identifier ('`', '\'', 0x1c or 0x1d).
+/// @param[out] position - The symbol, position, course, speed, altitude and
+/// comment. Mic-E reports have no time code, it is cleared.
+/// @return \c true if the report was parsed, \c false if it was malformed.
+bool parseMicEInformation(std::string_view destination, std::string_view info,
+                          PositionPacket &position);
+
+} // namespace signal_easel::aprs
+
+#endif /* SIGNAL_EASEL_APRS_POSITION_PARSER_HPP_ */
@@ -0,0 +1,127 @@
+/**
+ * =*========SignalEasel========*=
+ * A friendly library for signal modulation and demodulation.
+ * https://github.com/joshua-jerred/Giraffe
+ * https://joshuajer.red/signal-easel
+ * =*===========================*=
+ *
+ * @file   audio_cache.hpp
+ * @date   2026-10-19
+ * @brief  LRU cache of rendered modulator audio
+ *
+ * =*=======================*=
+ * @copyright  2026 Joshua Jerred
+ * @license    GNU GPLv3
+ */
+
+#ifndef SIGNAL_EASEL_AUDIO_CACHE_HPP_
+#define SIGNAL_EASEL_AUDIO_CACHE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace signal_easel {
+
+/**
+ * @brief The default memory cap of an AudioCache, in bytes. About 80 seconds
+ * of audio, or a couple hundred APRS packets.
+ */
+inline constexpr size_t AUDIO_CACHE_DEFAULT_MAX_BYTES = 8 * 1024 * 1024;
+
+/**
+ * @brief Audio rendered by a modulator, shared between the cache and anyone
+ * still holding it after it is evicted.
+ */
+struct CachedAudio {
+  /// @brief The samples, at AUDIO_SAMPLE_RATE
+  std::vector<int16_t> samples{};
+
+  /// @brief How far the modulator's state (ie. the phase of a continuous phase
+  /// modulator) moved while rendering, so a hit can leave the modulator where
+  /// rendering would have.
+  int64_t state_change = 0;
+};
+
+/**
+ * @brief A least recently used cache of rendered audio, for packets that are
+ * transmitted over and over (beacons, telemetry definitions).
+ * @details Keys are opaque bytes, the modulator builds them from the data, it's
+ * settings and anything else the audio depends on. Entries are evicted, least
+ * recently used first, to keep the keys and samples under the memory cap.
+ * Safe to share between modulators on different threads.
+ */
+class AudioCache {
+public:
+  struct Stats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+    size_t entries = 0;
+    /// @brief The memory used by the keys and samples, in bytes
+    size_t bytes = 0;
+  };
+
+  /**
+   * @brief Constructor
+   * @param max_bytes The memory cap for the keys and samples. Audio larger
+   * than this is never cached.
+   */
+  explicit AudioCache(size_t max_bytes = AUDIO_CACHE_DEFAULT_MAX_BYTES)
+      : max_bytes_(max_bytes) {}
+
+  /**
+   * @brief Look up audio, counting a hit or a miss.
+   * @param key The key the audio was inserted with
+   * @return The audio, or nullptr if it is not cached
+   */
+  std::shared_ptr<const CachedAudio> find(const std::string &key);
+
+  /**
+   * @brief Add audio, evicting the least recently used entries to make room.
+   * Replaces any audio already cached under the key.
+   * @param key The key to look the audio up with
+   * @param audio The rendered audio
+   */
+  void insert(const std::string &key, CachedAudio audio);
+
+  /**
+   * @brief Remove every entry. The counters are kept.
+   */
+  void clear();
+
+  Stats getStats() const;
+
+  size_t getMaxBytes() const { return max_bytes_; }
+
+private:
+  struct Entry {
+    std::string key{};
+    std::shared_ptr<const CachedAudio> audio{};
+  };
+
+  static size_t getEntryBytes(const Entry &entry) {
+    return entry.key.size() + entry.audio->samples.size() * sizeof(int16_t);
+  }
+
+  void evict(size_t bytes_needed);
+
+  const size_t max_bytes_;
+
+  mutable std::mutex mutex_{};
+
+  /// @brief Most recently used at the front
+  std::list<Entry> entries_{};
+  std::unordered_map<std::string, std::list<Entry>::iterator> index_{};
+
+  Stats stats_{};
+};
+
+} // namespace signal_easel
+
+#endif /* SIGNAL_EASEL_AUDIO_CACHE_HPP_ */
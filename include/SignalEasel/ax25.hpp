@@ -59,6 +59,38 @@ uint16_t calculateFcs(const std::vector<uint8_t> &input_data);
  */
 BitStream decodeNrzi(BitStream &bit_stream);
 
+/**
+ * @brief Like decodeNrzi(BitStream &), but into a caller owned stream so it's
+ * storage can be reused from one decode pass to the next.
+ * @param bit_stream The NRZI encoded stream, all bits are consumed
+ * @param output (out) The decoded stream, cleared first
+ */
+void decodeNrzi(BitStream &bit_stream, BitStream &output);
+
+/**
+ * @brief Find the opening flags in an NRZI-decoded bit stream and consume
+ * them.
+ * @param bit_stream The bit stream to search
+ * @return int -1 if no flags were found, otherwise the number of opening flags
+ */
+int findStartFlags(BitStream &bit_stream);
+
+/**
+ * @brief Remove the stuffed bits from the frame that follows the opening
+ * flags, stopping at the closing flag.
+ * @param bit_stream The bit stream, positioned just after the opening flags
+ * @return std::vector<uint8_t> The frame bytes, including the FCS
+ */
+std::vector<uint8_t> deStuffBytes(BitStream &bit_stream);
+
+/**
+ * @brief Like deStuffBytes(BitStream &), but into a caller owned buffer so
+ * it's capacity is reused between frames.
+ * @param bit_stream The bit stream, positioned just after the opening flags
+ * @param output (out) The frame bytes, including the FCS. Cleared first.
+ */
+void deStuffBytes(BitStream &bit_stream, std::vector<uint8_t> &output);
+
 /**
  * @brief AX.25 Address class. For encoding and decoding AX.25 addresses.
  * @details See AX.25 2.2 3.12.2 and 3.12.3
@@ -193,9 +225,9 @@ public:
   /**
    * @brief Builds all internal portions of the frame. Doesn't include
    * the flags.
-   * @return std::vector<uint8_t> The built frame
+   * @return The built frame, valid until the frame is built again
    */
-  std::vector<uint8_t> buildFrame();
+  const std::vector<uint8_t> &buildFrame();
 
   /**
    * @brief A step beyond buildFrame. This function builds the frame, does the
@@ -204,6 +236,14 @@ public:
    */
   std::vector<uint8_t> encodeFrame();
 
+  /**
+   * @brief Same as encodeFrame(), into a caller owned buffer. The frame is
+   * stuffed, NRZI encoded and packed in one pass, so reusing the buffer
+   * encodes frames without touching the heap.
+   * @param encoded_frame Replaced with the encoded frame
+   */
+  void encodeFrame(std::vector<uint8_t> &encoded_frame);
+
   /**
    * @brief Attempt to parse an incoming bit stream into an AX.25 frame.
    * @details This consumes the input bit_stream during NRZI decoding.
@@ -225,6 +265,17 @@ public:
    */
   bool parseNrziDecodedBitStream(BitStream &nrzi_decoded_stream);
 
+  /**
+   * @brief Same as parseNrziDecodedBitStream(BitStream &), with a caller
+   * owned buffer for the de-stuffed bytes. A receiver that keeps the buffer
+   * and the frame between calls parses frames without touching the heap.
+   * @param nrzi_decoded_stream The post-NRZI-decoded bit stream to search
+   * @param frame_buffer Scratch space for the frame bytes
+   * @return true if a frame was successfully parsed, false otherwise.
+   */
+  bool parseNrziDecodedBitStream(BitStream &nrzi_decoded_stream,
+                                 std::vector<uint8_t> &frame_buffer);
+
   friend std::ostream &operator<<(std::ostream &os, const Frame &address);
 
 private:
@@ -243,6 +294,18 @@ private:
   std::vector<uint8_t> build_buffer_ = {};
 };
 
+/**
+ * @brief Encode frames back to back into one NRZI encoded burst, as
+ * Frame::encodeFrame does for one frame. The preamble and postamble are
+ * sent once, with flag fill between the frames.
+ * @param frames The frames to encode, each is built
+ * @param fill_flags The flags between two frames, at least one
+ * @param encoded Replaced with the encoded burst
+ * @exception signal_easel::Exception AX25_INVALID_FLAG_FILL if fill_flags is 0
+ */
+void encodeFrames(std::vector<Frame> &frames, size_t fill_flags,
+                  std::vector<uint8_t> &encoded);
+
 std::ostream &operator<<(std::ostream &os, const Address &frame);
 
 } // namespace signal_easel::ax25
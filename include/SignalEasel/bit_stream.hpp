@@ -47,6 +47,14 @@ public:
   void dumpBitStreamAsHex();
   void dumpBitStreamAsAscii();
   void addBits(const unsigned char *data, int num_bits);
+
+  /**
+   * @brief Add the low num_bits of a word, most significant first, with a
+   * single write to the buffer (two when it crosses into the next word).
+   * @param bits The bits, right aligned
+   * @param num_bits The number of bits, 0 to 32
+   */
+  void addWord(uint32_t bits, int num_bits);
   int8_t popNextBit();
   int peakNextBit();
   int peakNextByte();
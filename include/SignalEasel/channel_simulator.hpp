@@ -0,0 +1,177 @@
+/**
+ * =*========SignalEasel========*=
+ * A friendly library for signal modulation and demodulation.
+ * https://github.com/joshua-jerred/Giraffe
+ * https://joshuajer.red/signal-easel
+ * =*===========================*=
+ *
+ * @file   channel_simulator.hpp
+ * @date   2026-10-19
+ * @brief  Synthetic radio channel impairments for testing demodulators
+ *
+ * =*=======================*=
+ * @copyright  2026 Joshua Jerred
+ * @license    GNU GPLv3
+ */
+
+#ifndef SIGNAL_EASEL_CHANNEL_SIMULATOR_HPP_
+#define SIGNAL_EASEL_CHANNEL_SIMULATOR_HPP_
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace signal_easel {
+
+/**
+ * @brief The number of taps in the Hilbert transformer used to shift the
+ * frequency of the signal. Long enough to keep the unwanted sideband ~50dB
+ * down across the audio band.
+ */
+inline constexpr size_t CHANNEL_SIMULATOR_HILBERT_TAPS = 255;
+
+/**
+ * @brief The number of taps in the linear phase filter that applies the twist.
+ */
+inline constexpr size_t CHANNEL_SIMULATOR_TWIST_TAPS = 129;
+
+/**
+ * @brief The frequency around which the twist is applied, the gain here is
+ * unchanged. The middle of the Bell 202 tones.
+ */
+inline constexpr double CHANNEL_SIMULATOR_TWIST_CENTER = 1700.0;
+
+/**
+ * @brief Applies the impairments of a radio channel to clean modulator output,
+ * so demodulators can be tested and benchmarked for sensitivity, not just
+ * speed.
+ * @details The impairments are applied in the order a real signal meets them:
+ * the transmitter's audio response (twist), it's sample clock (clock drift),
+ * mistuning (frequency offset), fading (dropouts) and finally the receiver
+ * noise (AWGN). All randomness comes from a seeded Mersenne Twister with a
+ * portable Gaussian transform, so the same seed produces the same audio on
+ * every platform.
+ *
+ * The default settings leave the audio untouched.
+ */
+class ChannelSimulator {
+public:
+  struct Settings {
+    /**
+     * @brief If true, white Gaussian noise is added at eb_n0_db.
+     */
+    bool add_noise = false;
+
+    /**
+     * @brief The energy per bit to noise power spectral density ratio, in dB.
+     * @details The signal power is measured over the whole input, so the
+     * input should not contain long stretches of silence.
+     */
+    double eb_n0_db = 20.0;
+
+    /**
+     * @brief The bit rate of the signal, used to turn Eb/N0 into a noise
+     * level (ie. 1200 for AFSK1200).
+     */
+    uint32_t bit_rate = 1200;
+
+    /**
+     * @brief Shift every frequency in the signal by this many Hz, like a
+     * mistuned SSB receiver.
+     */
+    double frequency_offset = 0.0;
+
+    /**
+     * @brief The error of the transmitter's sample clock, in parts per
+     * million. Positive values are a fast clock: shorter symbols and higher
+     * tones.
+     */
+    double clock_drift_ppm = 0.0;
+
+    /**
+     * @brief The gain at 2200Hz relative to 1200Hz, in dB, applied as a linear
+     * slope around CHANNEL_SIMULATOR_TWIST_CENTER. Positive values mimic
+     * pre-emphasis without a matching de-emphasis, negative values the
+     * opposite.
+     */
+    double twist_db = 0.0;
+
+    /**
+     * @brief The average number of dropouts (signal fades to nothing) per
+     * second. Dropouts start at random, exponentially distributed, times.
+     */
+    double dropout_rate = 0.0;
+
+    /**
+     * @brief The length of each dropout in seconds.
+     */
+    double dropout_duration = 0.0;
+
+    /**
+     * @brief The seed for the noise and dropouts.
+     */
+    uint32_t seed = 0;
+  };
+
+  /**
+   * @brief Constructor for a channel with no impairments
+   */
+  ChannelSimulator();
+
+  /**
+   * @brief Constructor
+   * @param settings The channel impairments
+   * @exception signal_easel::Exception VALIDATION_ERROR if a setting is out of
+   * range
+   */
+  ChannelSimulator(Settings settings);
+
+  /**
+   * @brief Pass audio through the channel.
+   * @details The random state carries over between calls, so consecutive
+   * calls give different noise. Each call is otherwise independent (the
+   * filters start from silence).
+   * @param input The clean audio, at AUDIO_SAMPLE_RATE
+   * @param output (out) The impaired audio. Replaces the contents. The length
+   * differs from the input when there is clock drift.
+   */
+  void process(const std::vector<int16_t> &input,
+               std::vector<int16_t> &output);
+
+  /**
+   * @brief Re-seed the random number generator, so the next call to
+   * process() repeats the first.
+   */
+  void reset() { random_.seed(settings_.seed); }
+
+  const Settings &getSettings() const { return settings_; }
+
+  /**
+   * @brief The standard deviation of the noise added by the last call to
+   * process(), in PCM units.
+   */
+  double getNoiseLevel() const { return noise_level_; }
+
+private:
+  void applyTwist(std::vector<double> &signal) const;
+  void applyClockDrift(std::vector<double> &signal) const;
+  void applyFrequencyOffset(std::vector<double> &signal) const;
+  void applyDropouts(std::vector<double> &signal);
+  void addNoise(std::vector<double> &signal, double signal_power);
+
+  /// @brief A standard normal random number (Box-Muller)
+  double gaussian();
+  /// @brief A uniform random number in (0, 1)
+  double uniform();
+
+  Settings settings_;
+  std::mt19937 random_{};
+  double noise_level_ = 0.0;
+
+  std::vector<double> hilbert_taps_ = {};
+  std::vector<double> twist_taps_ = {};
+};
+
+} // namespace signal_easel
+
+#endif /* SIGNAL_EASEL_CHANNEL_SIMULATOR_HPP_ */
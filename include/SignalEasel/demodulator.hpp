@@ -24,6 +24,8 @@
 
 namespace signal_easel {
 
+class PcmStreamReader;
+
 /**
  * @brief The base class for all demodulators that turn audio into data
  */
@@ -43,6 +45,13 @@ public:
    */
   void loadAudioFromFile(const std::string &file_name);
 
+  /**
+   * @brief Read a raw s16le PCM stream until it ends and load it's contents
+   * into the audio buffer, replacing any audio already in it.
+   * @param reader The PCM stream to read from
+   */
+  void loadAudioFromPcmStream(PcmStreamReader &reader);
+
 #ifdef PULSE_AUDIO_ENABLED
   // virtual bool detectSignal() = 0;
   // virtual void processPulseAudio() = 0;
@@ -40,6 +40,7 @@ public:
     AX25_FRAME_NEED_AT_LEAST_TWO_ADDRESSES,
     AX25_FRAME_ALREADY_BUILT,
     AX25_FRAME_NOT_BUILT,
+    AX25_INVALID_FLAG_FILL,
     BASE_91_ENCODE_VALUE_NOT_CORRECT_SIZE,
     APRS_INVALID_SOURCE_ADDRESS_LENGTH,
     APRS_INVALID_SOURCE_SSID,
@@ -55,6 +56,11 @@ public:
     PULSE_CLOSE_ERROR,
     PULSE_READ_ERROR,
     PULSE_AUDIO_DISABLED,
+    PCM_STREAM_READ_ERROR,
+    PCM_STREAM_WRITE_ERROR,
+    PCM_STREAM_INVALID_SAMPLE_RATE,
+    RESAMPLER_INVALID_SAMPLE_RATE,
+    AFSK_INVALID_DEMODULATION_SAMPLE_RATE,
     APRS_RECEIVER_BUFFER_FULL,
     APRS_MESSAGE_NOT_IMPLEMENTED,
     APRS_INVALID_COMMENT_LENGTH,
@@ -105,6 +111,8 @@ public:
       return "AX25 frame already built";
     case Id::AX25_FRAME_NOT_BUILT:
       return "AX25 frame not built";
+    case Id::AX25_INVALID_FLAG_FILL:
+      return "Invalid AX25 flag fill";
     case Id::BASE_91_ENCODE_VALUE_NOT_CORRECT_SIZE:
       return "Base 91 encode value not correct size";
     case Id::APRS_INVALID_SOURCE_ADDRESS_LENGTH:
@@ -135,6 +143,16 @@ public:
       return "PulseAudio read error";
     case Id::PULSE_AUDIO_DISABLED:
       return "PulseAudio disabled";
+    case Id::PCM_STREAM_READ_ERROR:
+      return "PCM stream read error";
+    case Id::PCM_STREAM_WRITE_ERROR:
+      return "PCM stream write error";
+    case Id::PCM_STREAM_INVALID_SAMPLE_RATE:
+      return "PCM stream invalid sample rate";
+    case Id::RESAMPLER_INVALID_SAMPLE_RATE:
+      return "Resampler invalid sample rate";
+    case Id::AFSK_INVALID_DEMODULATION_SAMPLE_RATE:
+      return "Invalid AFSK demodulation sample rate";
     case Id::APRS_RECEIVER_BUFFER_FULL:
       return "APRS receiver buffer full";
     case Id::APRS_MESSAGE_NOT_IMPLEMENTED:
@@ -24,6 +24,8 @@
 
 namespace signal_easel {
 
+class PcmStreamWriter;
+
 /**
  * @brief The abstract base class for all modulators that turn data into audio
  */
@@ -55,6 +57,19 @@ public:
    */
   void writeToPulseAudio();
 
+  /**
+   * @brief Write the audio as raw s16le PCM to a file descriptor (ie. stdout)
+   * @param writer The PCM stream to write to
+   * @exception Exception Throws an exception if there is no data to write or
+   * if the write fails
+   */
+  void writeToPcmStream(PcmStreamWriter &writer);
+
+  /**
+   * @brief The audio generated so far, at AUDIO_SAMPLE_RATE
+   */
+  const std::vector<int16_t> &getAudioBuffer() const { return audio_buffer_; }
+
 protected:
   /**
    * @brief Add a PCM sample to the audio buffer
@@ -75,9 +90,7 @@ protected:
    * @param duration_in_samples
    */
   void addSilence(uint32_t duration_in_samples) {
-    for (uint32_t i = 0; i < duration_in_samples; i++) {
-      addAudioSample(0);
-    }
+    audio_buffer_.insert(audio_buffer_.end(), duration_in_samples, 0);
   }
 
   /**
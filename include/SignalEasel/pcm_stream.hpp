@@ -0,0 +1,237 @@
+/**
+ * =*========SignalEasel========*=
+ * A friendly library for signal modulation and demodulation.
+ * https://github.com/joshua-jerred/Giraffe
+ * https://joshuajer.red/signal-easel
+ * =*===========================*=
+ *
+ * @file   pcm_stream.hpp
+ * @date   2026-10-19
+ * @brief  Raw PCM (s16le) audio over file descriptors
+ *
+ * =*=======================*=
+ * @copyright  2026 Joshua Jerred
+ * @license    GNU GPLv3
+ */
+
+#ifndef SIGNAL_EASEL_PCM_STREAM_HPP_
+#define SIGNAL_EASEL_PCM_STREAM_HPP_
+
+#include <cstdint>
+#include <vector>
+
+#include <SignalEasel/constants.hpp>
+#include <SignalEasel/resampler.hpp>
+
+namespace signal_easel {
+
+/**
+ * @brief The default number of samples handed to a receiver per block. Matches
+ * PULSE_AUDIO_BUFFER_SIZE so signal detection behaves the same regardless of
+ * the audio source.
+ */
+inline constexpr size_t PCM_STREAM_BUFFER_SIZE = 16000;
+
+/**
+ * @brief The number of bytes requested from the file descriptor per read()
+ * call. Large reads keep the syscall count low when the source (rtl_fm, sox)
+ * is ahead of us.
+ */
+inline constexpr size_t PCM_STREAM_READ_SIZE = 64 * 1024;
+
+/**
+ * @brief Reads raw, headerless, mono, signed 16-bit little endian PCM audio
+ * from a file descriptor (stdin, a pipe, a FIFO, a socket...).
+ * @details Intended for pipelines such as `rtl_fm ... | decoder` where no
+ * sound server is available. Audio at any other rate than AUDIO_SAMPLE_RATE
+ * is resampled to AUDIO_SAMPLE_RATE as it is read, so the blocks can be fed
+ * straight to any demodulator. The reader does not own the file descriptor
+ * and will not close it.
+ */
+class PcmStreamReader {
+public:
+  /**
+   * @brief Constructor
+   * @param file_descriptor The file descriptor to read from (ie. STDIN_FILENO)
+   * @param sample_rate The sample rate of the incoming audio (ie. 22050 or
+   * 24000 for rtl_fm)
+   * @param buffer_size The number of samples, at AUDIO_SAMPLE_RATE, in each
+   * block returned by process(). Smaller blocks lower the latency at the cost
+   * of more calls.
+   * @exception signal_easel::Exception PCM_STREAM_INVALID_SAMPLE_RATE
+   */
+  PcmStreamReader(int file_descriptor,
+                  uint32_t sample_rate = AUDIO_SAMPLE_RATE,
+                  size_t buffer_size = PCM_STREAM_BUFFER_SIZE);
+  ~PcmStreamReader() = default;
+
+  PcmStreamReader(const PcmStreamReader &) = delete;
+  PcmStreamReader &operator=(const PcmStreamReader &) = delete;
+  PcmStreamReader(PcmStreamReader &&) = delete;
+  PcmStreamReader &operator=(PcmStreamReader &&) = delete;
+
+  /**
+   * @brief Read from the file descriptor until a full block of samples is
+   * available.
+   * @details Blocks if the file descriptor is blocking. With a non-blocking
+   * file descriptor, partial blocks are kept between calls. When the end of
+   * the stream is reached, the final (possibly short) block is returned once.
+   * @return true if a new block is available via getAudioBuffer()
+   * @exception signal_easel::Exception PCM_STREAM_READ_ERROR
+   */
+  bool process();
+
+  /**
+   * @brief Read everything until the end of the stream.
+   * @details A non-blocking file descriptor is waited on with poll() when it
+   * has nothing to read, so this blocks either way.
+   * @param output (out) The samples are appended to this vector
+   * @exception signal_easel::Exception PCM_STREAM_READ_ERROR
+   */
+  void readAll(std::vector<int16_t> &output);
+
+  /**
+   * @brief The most recent block of samples (see process()).
+   */
+  const std::vector<int16_t> &getAudioBuffer() const { return audio_buffer_; }
+
+  /**
+   * @brief True once the writing end of the stream has been closed.
+   */
+  bool isEndOfStream() const { return end_of_stream_; }
+
+  uint32_t getSampleRate() const { return sample_rate_; }
+  uint64_t getTotalSamples() const { return total_samples_; }
+  uint32_t getRms() const { return rms_; }
+  double getVolume() const { return volume_; }
+
+private:
+  /**
+   * @brief Pull more bytes from the file descriptor into the read buffer.
+   * @return false if no bytes could be read (end of stream or would block)
+   */
+  bool fillReadBuffer();
+
+  /**
+   * @brief Wait until the file descriptor can be read from, for readAll() on
+   * a non-blocking file descriptor.
+   */
+  void waitForData();
+
+  /**
+   * @brief Decode whole s16le samples from the read buffer.
+   * @param output (out) The samples are appended to this vector
+   * @param max_samples The maximum number of samples to decode
+   */
+  void decodeSamples(std::vector<int16_t> &output, size_t max_samples);
+
+  /**
+   * @brief Calculates the RMS/volume of the current block.
+   */
+  void updateLevels();
+
+  int file_descriptor_;
+  uint32_t sample_rate_;
+  size_t buffer_size_;
+
+  /// @brief Converts from sample_rate_ to AUDIO_SAMPLE_RATE
+  Resampler resampler_;
+  bool resampler_flushed_ = false;
+  std::vector<int16_t> input_samples_ = {};
+  std::vector<int16_t> resampled_ = {};
+  size_t resampled_start_ = 0;
+
+  bool end_of_stream_ = false;
+  bool block_complete_ = false;
+  uint64_t total_samples_ = 0;
+  uint32_t rms_ = 0;
+  double volume_ = 0.0;
+
+  std::vector<uint8_t> read_buffer_ =
+      std::vector<uint8_t>(PCM_STREAM_READ_SIZE);
+  size_t read_start_ = 0;
+  size_t read_end_ = 0;
+
+  std::vector<int16_t> audio_buffer_ = {};
+};
+
+/**
+ * @brief Writes raw, headerless, mono, signed 16-bit little endian PCM audio
+ * to a file descriptor (stdout, a pipe, a FIFO, a socket...).
+ * @details Audio is passed in at AUDIO_SAMPLE_RATE and resampled to the
+ * stream's sample rate if they differ. The writer does not own the file
+ * descriptor and will not close it.
+ * @see Modulator::writeToPcmStream
+ */
+class PcmStreamWriter {
+public:
+  /**
+   * @brief Constructor
+   * @param file_descriptor The file descriptor to write to (ie. STDOUT_FILENO)
+   * @param sample_rate The sample rate of the outgoing audio
+   * @exception signal_easel::Exception PCM_STREAM_INVALID_SAMPLE_RATE
+   */
+  PcmStreamWriter(int file_descriptor,
+                  uint32_t sample_rate = AUDIO_SAMPLE_RATE);
+  ~PcmStreamWriter() = default;
+
+  PcmStreamWriter(const PcmStreamWriter &) = delete;
+  PcmStreamWriter &operator=(const PcmStreamWriter &) = delete;
+  PcmStreamWriter(PcmStreamWriter &&) = delete;
+  PcmStreamWriter &operator=(PcmStreamWriter &&) = delete;
+
+  /**
+   * @brief Write samples to the stream. Blocks until all of them are written.
+   * @param samples The samples to write, at AUDIO_SAMPLE_RATE
+   * @exception signal_easel::Exception PCM_STREAM_WRITE_ERROR
+   */
+  void write(const std::vector<int16_t> &samples) {
+    write(samples.data(), samples.size());
+  }
+
+  /**
+   * @brief Write samples to the stream. Blocks until all of them are written.
+   * @param samples Pointer to the first sample, at AUDIO_SAMPLE_RATE
+   * @param num_samples The number of samples to write
+   * @exception signal_easel::Exception PCM_STREAM_WRITE_ERROR
+   */
+  void write(const int16_t *samples, size_t num_samples);
+
+  /**
+   * @brief When resampling, write out the audio still held back by the
+   * resampler's filter delay. Call once after the last write().
+   */
+  void flush();
+
+  uint32_t getSampleRate() const { return sample_rate_; }
+
+  /// @brief The number of samples written to the file descriptor, at the
+  /// stream's sample rate.
+  uint64_t getTotalSamples() const { return total_samples_; }
+
+private:
+  /**
+   * @brief Convert samples (at the stream's rate) to s16le and write them.
+   */
+  void writeSamples(const int16_t *samples, size_t num_samples);
+
+  /**
+   * @brief Write the contents of the byte buffer to the file descriptor,
+   * handling short writes and interrupted system calls.
+   */
+  void flushWriteBuffer();
+
+  int file_descriptor_;
+  uint32_t sample_rate_;
+  uint64_t total_samples_ = 0;
+
+  /// @brief Converts from AUDIO_SAMPLE_RATE to sample_rate_
+  Resampler resampler_;
+  std::vector<int16_t> resampled_ = {};
+
+  std::vector<uint8_t> write_buffer_ = {};
+};
+
+} // namespace signal_easel
+
+#endif /* SIGNAL_EASEL_PCM_STREAM_HPP_ */
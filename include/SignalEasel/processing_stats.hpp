@@ -0,0 +1,179 @@
+/**
+ * =*========SignalEasel========*=
+ * A friendly library for signal modulation and demodulation.
+ * https://github.com/joshua-jerred/Giraffe
+ * https://joshuajer.red/signal-easel
+ * =*===========================*=
+ *
+ * @file   processing_stats.hpp
+ * @date   2026-10-19
+ * @brief  Per-stage timing and latency counters for the receivers
+ *
+ * =*=======================*=
+ * @copyright  2026 Joshua Jerred
+ * @license    GNU GPLv3
+ */
+
+#ifndef SIGNAL_EASEL_PROCESSING_STATS_HPP_
+#define SIGNAL_EASEL_PROCESSING_STATS_HPP_
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include <SignalEasel/constants.hpp>
+
+namespace signal_easel {
+
+/**
+ * @brief The number of buckets in the latency histogram. Bucket 0 holds
+ * latencies under 1ms, bucket i holds [2^(i-1), 2^i) ms and the last bucket
+ * holds everything from 2^(N-2) ms up.
+ */
+inline constexpr size_t LATENCY_HISTOGRAM_BUCKETS = 16;
+
+/**
+ * @brief When the audio source reports more than this much audio waiting to
+ * be read, in milliseconds, the receiver has fallen behind and the read is
+ * counted as an overrun.
+ */
+inline constexpr uint64_t AUDIO_BACKLOG_OVERRUN_MS = 500;
+
+/**
+ * @brief The stages of the receive path, in the order audio passes through
+ * them.
+ */
+enum class ProcessingStage : uint8_t {
+  /// @brief The band-pass filter, SNR estimate and any resampling
+  FILTER = 0,
+  /// @brief Tone detection (the correlator or quadrature mixer)
+  CORRELATOR,
+  /// @brief Clock recovery and bit slicing
+  CLOCK_RECOVERY,
+  /// @brief NRZI decoding, flag search, bit de-stuffing and frame splitting
+  DEFRAME,
+  /// @brief Parsing the AX.25 frame into a packet
+  PARSE
+};
+
+inline constexpr size_t NUM_PROCESSING_STAGES = 5;
+
+/**
+ * @brief The cumulative cost of one stage.
+ */
+struct StageStats {
+  /// @brief The number of times the stage ran
+  uint64_t calls = 0;
+
+  /**
+   * @brief The amount of work done: samples for the FILTER, CORRELATOR and
+   * CLOCK_RECOVERY stages (at the demodulation sample rate), bits for
+   * DEFRAME and frames for PARSE.
+   */
+  uint64_t items = 0;
+
+  std::chrono::nanoseconds time{0};
+};
+
+/**
+ * @brief A log2 histogram of the time from audio arriving at the receiver to
+ * a packet made from it being delivered to the queue.
+ */
+struct LatencyHistogram {
+  std::array<uint64_t, LATENCY_HISTOGRAM_BUCKETS> buckets{};
+  uint64_t count = 0;
+  std::chrono::nanoseconds total{0};
+  std::chrono::nanoseconds max{0};
+
+  void add(std::chrono::nanoseconds latency) {
+    buckets.at(getBucketIndex(latency))++;
+    count++;
+    total += latency;
+    max = latency > max ? latency : max;
+  }
+
+  std::chrono::nanoseconds getMean() const {
+    return count == 0 ? std::chrono::nanoseconds{0}
+                      : total / static_cast<int64_t>(count);
+  }
+
+  static size_t getBucketIndex(std::chrono::nanoseconds latency) {
+    const auto milliseconds =
+        std::chrono::duration_cast<std::chrono::milliseconds>(latency).count();
+    size_t index = 0;
+    while (index < LATENCY_HISTOGRAM_BUCKETS - 1 &&
+           milliseconds >= (int64_t{1} << index)) {
+      index++;
+    }
+    return index;
+  }
+
+  /// @brief The exclusive upper bound of a bucket. The last bucket is
+  /// unbounded and returns nanoseconds::max().
+  static std::chrono::nanoseconds getBucketUpperBound(size_t index) {
+    if (index >= LATENCY_HISTOGRAM_BUCKETS - 1) {
+      return std::chrono::nanoseconds::max();
+    }
+    return std::chrono::milliseconds(int64_t{1} << index);
+  }
+};
+
+/**
+ * @brief A snapshot of where a receiver is spending it's time.
+ * @details Collected when the library is built with the
+ * SIGNALEASEL_INSTRUMENTATION CMake option (the default). Without it the
+ * timers compile away, the snapshot stays zeroed and enabled is false.
+ * Counting costs a couple of clock reads per audio block, not per sample.
+ */
+struct ProcessingStats {
+  /// @brief False if the library was built without instrumentation
+  bool enabled = false;
+
+  std::array<StageStats, NUM_PROCESSING_STAGES> stages{};
+
+  /// @brief The number of samples received, at AUDIO_SAMPLE_RATE
+  uint64_t audio_samples = 0;
+
+  /// @brief The total time spent processing the received audio, including
+  /// signal detection and decoding.
+  std::chrono::nanoseconds processing_time{0};
+
+  LatencyHistogram latency{};
+
+  /// @brief Reads where the audio source had fallen behind by more than
+  /// AUDIO_BACKLOG_OVERRUN_MS (audio is likely being lost).
+  uint64_t audio_overruns = 0;
+
+  /// @brief Packets dropped from a full position, experimental, telemetry or
+  /// other packet queue, and decodes where the message queue was full (see
+  /// Exception::Id::APRS_RECEIVER_BUFFER_FULL)
+  uint64_t queue_overruns = 0;
+
+  const StageStats &getStage(ProcessingStage stage) const {
+    return stages.at(static_cast<size_t>(stage));
+  }
+
+  StageStats &getStage(ProcessingStage stage) {
+    return stages.at(static_cast<size_t>(stage));
+  }
+
+  /**
+   * @brief The processing time divided by the duration of the received
+   * audio. Below 1.0 the receiver keeps up with real time, above it falls
+   * behind.
+   */
+  double getRealTimeFactor() const {
+    if (audio_samples == 0) {
+      return 0.0;
+    }
+    const double audio_seconds =
+        static_cast<double>(audio_samples) / AUDIO_SAMPLE_RATE;
+    return std::chrono::duration<double>(processing_time).count() /
+           audio_seconds;
+  }
+};
+
+} // namespace signal_easel
+
+#endif /* SIGNAL_EASEL_PROCESSING_STATS_HPP_ */
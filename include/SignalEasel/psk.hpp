@@ -18,10 +18,16 @@
 #define SIGNAL_EASEL_PSK_HPP_
 
 #include <array>
+#include <complex>
+#include <cstdint>
 #include <map>
+#include <string>
 #include <unordered_map>
+#include <vector>
 
 #include <SignalEasel/bit_stream.hpp>
+#include <SignalEasel/constants.hpp>
+#include <SignalEasel/demodulator.hpp>
 #include <SignalEasel/modulator.hpp>
 
 namespace signal_easel::psk {
@@ -29,6 +35,35 @@ namespace signal_easel::psk {
 extern const std::array<uint16_t, 128> AsciiToVaricodeArray;
 extern const std::unordered_map<std::string, uint8_t> VaricodeToAsciiMap;
 
+/**
+ * @brief Decodes a stream of varicode bits into characters.
+ * @details The bits of the character being received are kept in an integer
+ * and looked up, by value, in a table when the two 0 separator arrives. A
+ * couple of operations per bit, and no allocation.
+ */
+class VaricodeDecoder {
+public:
+  /**
+   * @brief Add the next bit.
+   * @param bit The bit
+   * @param[out] character The decoded character, only set when true is
+   * returned
+   * @return true if the bit completed a character
+   */
+  bool decode(bool bit, char &character);
+
+  /// @brief Discard any partly received character
+  void reset() {
+    bits_ = 0;
+    previous_bit_ = false;
+  }
+
+private:
+  /// @brief The bits since the last separator, first bit in the MSB
+  uint32_t bits_ = 0;
+  bool previous_bit_ = false;
+};
+
 /**
  * @brief Settings for PSK modulation
  */
@@ -39,14 +74,11 @@ struct Settings : public signal_easel::Settings {
   enum class Mode { BPSK, QPSK };
 
   /**
-   * @brief Enum for the different symbol rates
+   * @brief Enum for the different symbol rates, SR_31_25 and SR_62_5 are
+   * PSK31 and PSK63.
+   * @see getSymbolRate(), getSamplesPerSymbol()
    */
-  enum class SymbolRate : uint32_t {
-    SR_125 = 125U,
-    SR_250 = 250U,
-    SR_500 = 500U,
-    SR_1000 = 1000U
-  };
+  enum class SymbolRate { SR_31_25, SR_62_5, SR_125, SR_250, SR_500, SR_1000 };
 
   /**
    * @brief The mode of PSK to use
@@ -66,8 +98,44 @@ struct Settings : public signal_easel::Settings {
    * @brief Fldigi, in qpsk mode, uses zeros for the postamble.
    */
   bool fldigi_mode = true;
+
+  /**
+   * @brief The demodulator only outputs text while the signal quality (see
+   * Demodulator::Stats) is above this. Noise sits around 0.64, a clean signal
+   * near 1.0. QPSK scores lower than BPSK at the same SNR, while the Viterbi
+   * decoder still copies it, weak QPSK signals need a lower level (or 0.0,
+   * which disables the squelch).
+   */
+  double squelch_level = 0.8;
+
+  /**
+   * @brief Automatic frequency control, the furthest the demodulator retunes
+   * from carrier_frequency, in Hz. 0 leaves the Costas loop on it's own,
+   * which pulls in a few Hz.
+   * @details The offset is measured from the phase turn between quarter
+   * symbols, with the modulation removed by squaring it (BPSK) or raising it
+   * to the 4th power (QPSK). BPSK offsets up to the symbol rate are pulled
+   * in. QPSK's estimate is only used when it is consistent, which it rarely
+   * is above 125 baud, so those rates are mostly left to the Costas loop.
+   */
+  uint32_t afc_range = 0;
 };
 
+/// @brief The rate of each Settings::SymbolRate, in baud
+inline constexpr std::array<double, 6> PSK_SYMBOL_RATES = {
+    31.25, 62.5, 125.0, 250.0, 500.0, 1000.0};
+
+/// @brief The symbol rate in baud
+inline double getSymbolRate(Settings::SymbolRate symbol_rate) {
+  return PSK_SYMBOL_RATES.at(static_cast<size_t>(symbol_rate));
+}
+
+/// @brief The samples in each symbol at AUDIO_SAMPLE_RATE, 1536 for PSK31
+/// down to 48 at 1000 baud
+inline uint32_t getSamplesPerSymbol(Settings::SymbolRate symbol_rate) {
+  return static_cast<uint32_t>(AUDIO_SAMPLE_RATE / getSymbolRate(symbol_rate));
+}
+
 /**
  * @brief PSK Modulator
  */
@@ -105,6 +173,334 @@ private:
   uint32_t samples_per_symbol_ = 0;
 };
 
+/**
+ * @brief A soft decision Viterbi decoder for the QPSK convolutional code.
+ * @details The code has a constraint length of 5, so 16 states (the last 4
+ * bits) and 32 branches, each sending one of four phase changes. Branch
+ * metrics are the correlation of the received phase change with each of
+ * them, so the decoder works directly on the demodulator's phase changes
+ * without hard decisions. Bits are output a fixed TRACEBACK_LENGTH symbols
+ * behind the input.
+ */
+class ViterbiDecoder {
+public:
+  /// @brief The number of encoder states, 2^(constraint length - 1)
+  static constexpr uint32_t STATES = 16;
+
+  /// @brief How many symbols of decisions are kept, and the decoding delay
+  static constexpr uint32_t TRACEBACK_LENGTH = 32;
+
+  ViterbiDecoder() = default;
+
+  /**
+   * @brief Decode one symbol.
+   * @param phase_change The received symbol times the conjugate of the
+   * previous symbol, scaled to about unit magnitude.
+   * @param[out] bit The bit decided TRACEBACK_LENGTH symbols ago
+   * @return true if a bit was output, false for the first TRACEBACK_LENGTH
+   * symbols.
+   */
+  bool decode(std::complex<float> phase_change, bool &bit);
+
+  /// @brief Forget all paths, as if just constructed
+  void reset();
+
+private:
+  /// @brief The path metric of each state, the best is the highest
+  std::array<float, STATES> metrics_{};
+
+  /// @brief Per symbol and state, 1 if the surviving path came from the
+  /// predecessor with the high bit set. A ring buffer indexed by step, 32 bit
+  /// entries so the decisions are stored straight from vector compares.
+  std::array<std::array<uint32_t, STATES>, TRACEBACK_LENGTH> decisions_{};
+
+  uint64_t steps_ = 0;
+};
+
+/**
+ * @brief A streaming PSK demodulator, for a single carrier.
+ * @details Audio is mixed down to base band with a numerically controlled
+ * oscillator (NCO) and integrated over quarter symbols. Each symbol is the
+ * quarter symbols weighted by the half sine the modulator shapes symbols with
+ * (a matched filter). A Costas loop steers the NCO onto the carrier's phase
+ * and frequency, and a Gardner timing error detector stretches or shrinks
+ * the quarter symbols to keep them aligned with the symbols. Bits are the
+ * phase differences between symbols (through the ViterbiDecoder for QPSK),
+ * decoded from varicode into text.
+ *
+ * Audio can be fed in blocks of any size, the state carries over.
+ */
+class Demodulator : public signal_easel::Demodulator {
+public:
+  struct Stats {
+    /// @brief The symbols demodulated
+    uint64_t symbols = 0;
+
+    /// @brief The characters decoded
+    uint64_t characters = 0;
+
+    /// @brief The estimate of the carrier's offset from
+    /// Settings::carrier_frequency, from the Costas loop and automatic
+    /// frequency control, in Hz
+    double frequency_offset = 0.0;
+
+    /// @brief The average of |cos| of the phase change between symbols (of
+    /// twice the phase change for QPSK). 1.0 for a clean signal, 2/pi for
+    /// noise.
+    double signal_quality = 0.0;
+  };
+
+  /**
+   * @brief Constructor
+   * @param settings The PSK settings, the carrier and symbol rate must match
+   * the transmitter's.
+   * @exception signal_easel::Exception VALIDATION_ERROR if the carrier is
+   * outside of the audio band.
+   */
+  Demodulator(psk::Settings settings = psk::Settings());
+  ~Demodulator() = default;
+
+  /**
+   * @brief Demodulate a block of audio, continuing from the last block.
+   * @param samples The audio, at AUDIO_SAMPLE_RATE
+   * @param num_samples The number of samples
+   */
+  void process(const int16_t *samples, size_t num_samples);
+
+  /**
+   * @brief Demodulate the audio loaded with loadAudioFromFile or
+   * loadAudioFromPcmStream, continuing from any earlier audio.
+   */
+  void processAudioBuffer() {
+    process(audio_buffer_.data(), audio_buffer_.size());
+  }
+
+  /**
+   * @brief Move the text decoded so far out of the demodulator.
+   * @param output (out) Replaced with the text
+   * @return true if there was any text
+   */
+  bool takeText(std::string &output);
+
+  const Stats &getStats() const { return stats_; }
+
+  /// @brief Forget the signal, the loops and any text, as if just constructed
+  void reset();
+
+private:
+  /// @brief Quarter symbols per symbol, enough for the timing detector
+  static constexpr uint32_t BLOCKS_PER_SYMBOL_ = 4;
+
+  /// @brief Called as each quarter symbol is complete
+  void processBlock(std::complex<float> block);
+
+  /// @brief Called with the matched filter output at each symbol
+  void processSymbol(std::complex<float> symbol);
+
+  /// @brief Measure the frequency offset from the phase change between two
+  /// quarter symbols, retuning the NCO every AFC_BLOCKS_
+  void updateAfc(std::complex<float> difference);
+
+  /// @brief Called with each demodulated bit
+  void processBit(bool bit);
+
+  psk::Settings psk_settings_;
+
+  uint32_t samples_per_symbol_;
+  uint32_t block_length_;
+
+  /// @brief The NCO's phase and it's step per sample at the carrier, in
+  /// 1/2^32 turns
+  uint32_t nco_phase_ = 0;
+  uint32_t nco_step_;
+  /// @brief The Costas loop's frequency correction, in 1/2^32 turns/sample
+  double nco_frequency_offset_ = 0.0;
+  /// @brief The fraction of a step left over from nco_frequency_offset_
+  double nco_phase_remainder_ = 0.0;
+
+  /// @brief The quarter symbol being integrated
+  std::complex<float> block_sum_{};
+  uint32_t block_samples_ = 0;
+  uint32_t current_block_length_;
+
+  /// @brief The last BLOCKS_PER_SYMBOL_ quarter symbols, oldest first
+  std::array<std::complex<float>, BLOCKS_PER_SYMBOL_> blocks_{};
+  uint32_t block_index_ = 0;
+
+  std::complex<float> previous_symbol_{};
+  /// @brief The matched filter output half way between the last two symbols
+  std::complex<float> midpoint_{};
+  /// @brief Timing corrections owed, in samples
+  double timing_correction_ = 0.0;
+
+  /// @brief Quarter symbols the AFC averages over, 16 symbols
+  static constexpr uint32_t AFC_BLOCKS_ = 16 * BLOCKS_PER_SYMBOL_;
+  /// @brief The sum of the phase turns with the modulation removed, and of
+  /// their magnitudes
+  std::complex<double> afc_turn_{};
+  double afc_magnitude_ = 0.0;
+  uint32_t afc_blocks_ = 0;
+
+  VaricodeDecoder varicode_decoder_{};
+
+  ViterbiDecoder viterbi_decoder_{};
+
+  std::string text_{};
+  Stats stats_{};
+};
+
+/**
+ * @brief Settings for the Channelizer. The psk::Settings apply to every
+ * carrier, carrier_frequency is ignored.
+ */
+struct ChannelizerSettings : public psk::Settings {
+  /// @brief The passband searched for carriers, in Hz
+  uint32_t min_frequency = 300;
+  uint32_t max_frequency = 3000;
+
+  /// @brief How far the power around a carrier must be above the noise in
+  /// the same bandwidth to start a channel for it, in dB
+  double detection_threshold_db = 6.0;
+
+  /// @brief Samples between searches of the spectrum for carriers, at least
+  /// Channelizer::SPECTRUM_LENGTH
+  uint32_t detection_interval = AUDIO_SAMPLE_RATE / 4;
+
+  /// @brief Searches a carrier can be missing from before it's channel is
+  /// dropped
+  uint32_t channel_timeout = 8;
+
+  /// @brief The most carriers demodulated at once
+  size_t max_channels = 32;
+
+  /**
+   * @brief The threads to demodulate the channels on, 1 demodulates them on
+   * the calling thread.
+   * @details Threads are started for each run of audio between searches, so
+   * they pay off with several channels and blocks of a few thousand samples
+   * or more.
+   */
+  unsigned int threads = 1;
+};
+
+/**
+ * @brief Demodulates every PSK carrier in the passband at once.
+ * @details Every ChannelizerSettings::detection_interval the power spectrum
+ * of the first SPECTRUM_LENGTH samples is measured with a bank of Goertzel
+ * filters. Carriers are the peaks of the power in a symbol rate wide band,
+ * well above the noise floor (the median bin). Each new carrier gets a
+ * channel, a psk::Demodulator tuned to it that first catches up on the
+ * samples the carrier was found in. The channels mix their carrier down to a
+ * decimated base band of quarter symbols, and slice and decode it on their
+ * own, spread over ChannelizerSettings::threads. A channel is dropped when
+ * it's carrier has been gone for ChannelizerSettings::channel_timeout
+ * searches.
+ */
+class Channelizer {
+public:
+  /// @brief The samples the spectrum is measured over, 16 Hz bins
+  static constexpr uint32_t SPECTRUM_LENGTH = AUDIO_SAMPLE_RATE / 16;
+
+  /// @brief The text from one carrier
+  struct Channel {
+    /// @brief Unique to the carrier for the life of the Channelizer
+    uint32_t id = 0;
+
+    /// @brief The carrier frequency, as found in the spectrum and then
+    /// tracked by the demodulator, in Hz
+    double frequency = 0.0;
+
+    /// @brief The text decoded since the last takeText
+    std::string text{};
+
+    Demodulator::Stats stats{};
+
+    /// @brief false once the carrier is gone and the channel dropped, this is
+    /// the last of it's text
+    bool active = true;
+  };
+
+  /**
+   * @brief Constructor
+   * @param settings The settings for every carrier and the search
+   * @exception signal_easel::Exception VALIDATION_ERROR if the passband is
+   * empty or outside of the audio band, the detection interval is shorter
+   * than SPECTRUM_LENGTH or max_channels is 0.
+   */
+  Channelizer(ChannelizerSettings settings = ChannelizerSettings());
+
+  /**
+   * @brief Demodulate a block of audio, continuing from the last block.
+   * @param samples The audio, at AUDIO_SAMPLE_RATE
+   * @param num_samples The number of samples
+   */
+  void process(const int16_t *samples, size_t num_samples);
+
+  /**
+   * @brief Move the text decoded so far out of the channels.
+   * @param output (out) Replaced with every active channel, lowest frequency
+   * first, then the channels dropped since the last call
+   * @return true if any channel had text
+   */
+  bool takeText(std::vector<Channel> &output);
+
+  /// @brief The number of carriers being demodulated
+  size_t getNumChannels() const { return channels_.size(); }
+
+  /// @brief Drop every channel and forget the audio, as if just constructed
+  void reset();
+
+private:
+  struct ChannelState {
+    uint32_t id;
+    /// @brief The frequency the demodulator is tuned to, in Hz
+    uint32_t carrier_frequency;
+    Demodulator demodulator;
+    /// @brief Searches since the carrier was last seen
+    uint32_t misses = 0;
+  };
+
+  /// @brief Run every channel over a block of audio, on the worker threads
+  void demodulate(const int16_t *samples, size_t num_samples);
+
+  /// @brief Find the carriers in spectrum_samples_ and start or drop channels
+  void detectCarriers();
+
+  /// @brief Measure the power of spectrum_samples_ in each bin
+  void measureSpectrum();
+
+  /// @brief Add a channel's text to the output
+  static bool takeChannelText(ChannelState &channel, bool active,
+                              std::vector<Channel> &output);
+
+  ChannelizerSettings settings_;
+
+  /// @brief The bins measured, enough either side of the passband for the
+  /// band around a carrier at either edge
+  uint32_t first_bin_;
+  uint32_t num_bins_;
+
+  /// @brief Bins either side of a carrier in it's band
+  uint32_t band_half_width_;
+
+  /// @brief The Hann window and the Goertzel coefficient of each bin
+  std::vector<float> window_{};
+  std::vector<float> coefficients_{};
+
+  /// @brief The power of each bin in the last spectrum measured, each search
+  /// starts over
+  std::vector<float> power_{};
+
+  /// @brief The first SPECTRUM_LENGTH samples of the detection interval
+  std::vector<int16_t> spectrum_samples_{};
+  uint32_t interval_position_ = 0;
+
+  std::vector<ChannelState> channels_{};
+  /// @brief Channels dropped, with text not yet taken
+  std::vector<Channel> dropped_{};
+  uint32_t next_id_ = 0;
+};
+
 } // namespace signal_easel::psk
 
 #endif /* SIGNAL_EASEL_PSK_HPP_ */
\ No newline at end of file
@@ -19,6 +19,8 @@
 
 #include <memory>
 
+#include <SignalEasel/pcm_stream.hpp>
+#include <SignalEasel/processing_stats.hpp>
 #include <SignalEasel/pulse_audio.hpp>
 #include <SignalEasel/settings.hpp>
 
@@ -31,19 +33,48 @@ public:
 
   virtual bool process() = 0;
 
+  /**
+   * @brief Receive audio from a raw PCM stream (ie. stdin piped from rtl_fm)
+   * instead of PulseAudio.
+   * @param pcm_stream_reader The stream to read from. process() returns false
+   * once the stream has ended.
+   */
+  void usePcmStream(std::unique_ptr<PcmStreamReader> pcm_stream_reader) {
+    pcm_stream_reader_ = std::move(pcm_stream_reader);
+  }
+
   uint64_t getLatency() const {
     return pulse_audio_reader_ ? pulse_audio_reader_->getLatency() : 0;
   }
 
   double getVolume() const {
+    if (pcm_stream_reader_) {
+      return pcm_stream_reader_->getVolume();
+    }
     return pulse_audio_reader_ ? pulse_audio_reader_->getVolume() : 0.0;
   }
 
+  /**
+   * @brief A snapshot of the per-stage timing, latency and overrun counters.
+   * @see ProcessingStats
+   */
+  ProcessingStats getProcessingStats() const { return processing_stats_; }
+
+  /// @brief Zero the processing stats, ie. to measure over a fixed window.
+  void resetProcessingStats() {
+    const bool enabled = processing_stats_.enabled;
+    processing_stats_ = ProcessingStats();
+    processing_stats_.enabled = enabled;
+  }
+
 protected:
   /// @brief Lazily constructed on first process() call so that tests can
   /// override process() without triggering a real PulseAudio connection.
   std::unique_ptr<PulseAudioReader> pulse_audio_reader_{};
+  /// @brief When set, audio is read from this stream instead of PulseAudio.
+  std::unique_ptr<PcmStreamReader> pcm_stream_reader_{};
   Settings settings_;
+  ProcessingStats processing_stats_{};
 };
 
 } // namespace signal_easel
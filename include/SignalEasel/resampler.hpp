@@ -0,0 +1,152 @@
+/**
+ * =*========SignalEasel========*=
+ * A friendly library for signal modulation and demodulation.
+ * https://github.com/joshua-jerred/Giraffe
+ * https://joshuajer.red/signal-easel
+ * =*===========================*=
+ *
+ * @file   resampler.hpp
+ * @date   2026-10-19
+ * @brief  Rational polyphase sample rate converter
+ *
+ * =*=======================*=
+ * @copyright  2026 Joshua Jerred
+ * @license    GNU GPLv3
+ */
+
+#ifndef SIGNAL_EASEL_RESAMPLER_HPP_
+#define SIGNAL_EASEL_RESAMPLER_HPP_
+
+#include <cstdint>
+#include <vector>
+
+namespace signal_easel {
+
+/**
+ * @brief The number of zero crossings of the windowed-sinc prototype filter on
+ * each side of it's center. Higher values give a sharper anti-aliasing filter
+ * at the cost of more multiply-adds per output sample.
+ */
+inline constexpr uint32_t RESAMPLER_FILTER_HALF_LENGTH = 16;
+
+/**
+ * @brief The cutoff of the anti-aliasing filter as a fraction of the lower of
+ * the two Nyquist frequencies. Leaves room for the transition band.
+ */
+inline constexpr double RESAMPLER_CUTOFF_RATIO = 0.9;
+
+/**
+ * @brief The Kaiser window beta used for the prototype filter (~80dB stop
+ * band).
+ */
+inline constexpr double RESAMPLER_KAISER_BETA = 8.0;
+
+/**
+ * @brief Converts audio between two sample rates by a rational factor L/M
+ * using a polyphase FIR filter.
+ * @details The filter table is computed once in the constructor and split
+ * into L phases so that each output sample is a single dot product over the
+ * input history; the zero-stuffed and discarded samples of the textbook
+ * upsample/filter/downsample chain are never computed. State is kept between
+ * calls to process() so the resampler can sit in a stream (ie. in front of a
+ * receiver or behind a modulator) without clicks at block boundaries.
+ *
+ * Example: 44100 -> 48000 is L/M = 160/147, 48000 -> 9600 is 1/5.
+ */
+class Resampler {
+public:
+  /**
+   * @brief Constructor
+   * @param input_rate The sample rate of the audio passed to process()
+   * @param output_rate The sample rate of the audio produced by process()
+   * @param filter_half_length See RESAMPLER_FILTER_HALF_LENGTH
+   * @exception signal_easel::Exception RESAMPLER_INVALID_SAMPLE_RATE
+   */
+  Resampler(uint32_t input_rate, uint32_t output_rate,
+            uint32_t filter_half_length = RESAMPLER_FILTER_HALF_LENGTH);
+
+  /**
+   * @brief Resample a block of audio.
+   * @param input Pointer to the first input sample
+   * @param num_samples The number of input samples
+   * @param output (out) The resampled audio is appended to this vector
+   */
+  void process(const int16_t *input, size_t num_samples,
+               std::vector<int16_t> &output);
+
+  /**
+   * @brief Resample a block of audio.
+   * @param input The input samples
+   * @param output (out) The resampled audio is appended to this vector
+   */
+  void process(const std::vector<int16_t> &input,
+               std::vector<int16_t> &output) {
+    process(input.data(), input.size(), output);
+  }
+
+  /**
+   * @brief Push silence through the filter to emit the samples that are still
+   * held back by the filter delay. Call at the end of a stream.
+   * @param output (out) The remaining audio is appended to this vector
+   */
+  void flush(std::vector<int16_t> &output);
+
+  /**
+   * @brief Clear the filter history so the next call to process() starts a
+   * new, unrelated, stream.
+   */
+  void reset();
+
+  /**
+   * @brief True if the input and output rates are the same, in which case
+   * samples are copied through untouched.
+   */
+  bool isPassthrough() const { return up_factor_ == 1 && down_factor_ == 1; }
+
+  /**
+   * @brief The delay introduced by the filter, in output samples.
+   */
+  size_t getDelay() const { return delay_; }
+
+  uint32_t getInputRate() const { return input_rate_; }
+  uint32_t getOutputRate() const { return output_rate_; }
+  uint32_t getUpFactor() const { return up_factor_; }
+  uint32_t getDownFactor() const { return down_factor_; }
+  size_t getTapsPerPhase() const { return taps_per_phase_; }
+
+private:
+  /**
+   * @brief Push one input sample into the history and emit every output
+   * sample that becomes available.
+   */
+  void pushSample(double sample, std::vector<int16_t> &output);
+
+  uint32_t input_rate_;
+  uint32_t output_rate_;
+
+  /// @brief L, the interpolation factor (number of filter phases)
+  uint32_t up_factor_ = 1;
+  /// @brief M, the decimation factor
+  uint32_t down_factor_ = 1;
+
+  size_t taps_per_phase_ = 0;
+  size_t delay_ = 0;
+
+  /// @brief The polyphase filter table, phase-major. Each phase is stored in
+  /// the order that matches the history buffer, so the inner loop is a plain
+  /// contiguous dot product.
+  std::vector<double> coefficients_ = {};
+
+  /// @brief The input history. Twice as long as a phase so that a contiguous
+  /// window always exists without wrapping (each sample is stored twice).
+  std::vector<double> history_ = {};
+  size_t history_position_ = 0;
+
+  /// @brief The phase of the next output sample relative to the most recent
+  /// input sample.
+  uint32_t phase_ = 0;
+};
+
+} // namespace signal_easel
+
+#endif /* SIGNAL_EASEL_RESAMPLER_HPP_ */
@@ -0,0 +1,151 @@
+/**
+ * =*========SignalEasel========*=
+ * A friendly library for signal modulation and demodulation.
+ * https://github.com/joshua-jerred/Giraffe
+ * https://joshuajer.red/signal-easel
+ * =*===========================*=
+ *
+ * @file   spectrum.hpp
+ * @date   2026-10-19
+ * @brief  Streaming power spectra, for waterfalls and band measurements
+ *
+ * =*=======================*=
+ * @copyright  2026 Joshua Jerred
+ * @license    GNU GPLv3
+ */
+
+#ifndef SIGNAL_EASEL_SPECTRUM_HPP_
+#define SIGNAL_EASEL_SPECTRUM_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace signal_easel {
+
+class RealFft;
+
+/// @brief The power reported for a bin with no power at all, in dBFS
+inline constexpr float SPECTRUM_FLOOR_DB = -200.0F;
+
+struct SpectrumSettings {
+  enum class Window { RECTANGULAR, HANN, BLACKMAN_HARRIS };
+
+  /**
+   * @brief The samples in each spectrum, a power of two from FFT_MIN_SIZE to
+   * FFT_MAX_SIZE. The bins are AUDIO_SAMPLE_RATE / fft_size Hz wide, 11.7 Hz
+   * at the default.
+   */
+  uint32_t fft_size = 4096;
+
+  /**
+   * @brief The samples between the starts of consecutive spectra. Less than
+   * fft_size overlaps them, more skips audio between them.
+   */
+  uint32_t hop = 1024;
+
+  /// @brief Hann is a good default, Blackman-Harris keeps weak signals next
+  /// to strong ones visible at the cost of wider peaks.
+  Window window = Window::HANN;
+};
+
+/**
+ * @brief Windowed power spectra of a stream of audio, at a fixed hop.
+ * @details Feed it audio as it arrives, in blocks of any size, and take the
+ * spectra that are complete. Each one is calibrated so a full scale sine
+ * centered on a bin reads 0 dBFS in that bin, which lines the rows of a
+ * waterfall up from one call to the next. getBandPower() corrects for the
+ * window's noise bandwidth, so the power of a signal or of the noise in a
+ * band can be compared directly for SNR. afsk::Receiver::enableSpectrum()
+ * feeds one with the audio a receiver reads.
+ */
+class SpectrumAnalyzer {
+public:
+  struct Spectrum {
+    /// @brief The stream position of the first sample in the spectrum
+    uint64_t start_sample = 0;
+    /// @brief The power of each of the fft_size / 2 + 1 bins, in dBFS
+    std::vector<float> power_db{};
+  };
+
+  /**
+   * @brief Constructor
+   * @param settings See SpectrumSettings
+   * @exception signal_easel::Exception VALIDATION_ERROR
+   */
+  explicit SpectrumAnalyzer(SpectrumSettings settings);
+  ~SpectrumAnalyzer();
+
+  SpectrumAnalyzer(const SpectrumAnalyzer &) = delete;
+  SpectrumAnalyzer &operator=(const SpectrumAnalyzer &) = delete;
+
+  /**
+   * @brief Add audio, computing every spectrum it completes.
+   * @param samples Pointer to the first sample, at AUDIO_SAMPLE_RATE
+   * @param num_samples The number of samples
+   */
+  void process(const int16_t *samples, size_t num_samples);
+
+  void process(const std::vector<int16_t> &samples) {
+    process(samples.data(), samples.size());
+  }
+
+  /**
+   * @brief Move the spectra computed since the last call into output, oldest
+   * first.
+   * @param output (out) Replaced with the spectra
+   * @return true if there were any
+   */
+  bool takeSpectra(std::vector<Spectrum> &output);
+
+  /**
+   * @brief The total power between two frequencies, in dBFS (a full scale
+   * sine is 0 dBFS).
+   * @param spectrum A spectrum from this analyzer
+   * @param low_frequency The lowest frequency, in Hz
+   * @param high_frequency The highest frequency, in Hz
+   */
+  double getBandPower(const Spectrum &spectrum, double low_frequency,
+                      double high_frequency) const;
+
+  /// @brief The frequency at the center of a bin, in Hz
+  double getBinFrequency(size_t bin) const { return bin * getBinWidth(); }
+  double getBinWidth() const;
+  size_t getNumBins() const { return settings_.fft_size / 2 + 1; }
+
+  /// @brief The window's equivalent noise bandwidth, in bins
+  double getNoiseBandwidth() const { return noise_bandwidth_; }
+
+  /**
+   * @brief Drop the buffered audio and any spectra not yet taken, and start
+   * the stream position over at 0.
+   */
+  void reset();
+
+private:
+  void computeSpectrum(const int16_t *samples);
+
+  SpectrumSettings settings_;
+  std::unique_ptr<RealFft> fft_;
+
+  std::vector<float> window_ = {};
+  /// @brief Scales the power of each bin to dBFS
+  double power_scale_db_ = 0.0;
+  double noise_bandwidth_ = 0.0;
+
+  /// @brief Audio not yet in a spectrum, starting at stream position
+  /// buffer_start_
+  std::vector<int16_t> buffer_ = {};
+  uint64_t buffer_start_ = 0;
+  /// @brief Samples still to be skipped when the hop is longer than fft_size
+  uint64_t skip_ = 0;
+
+  std::vector<float> frame_ = {};
+  std::vector<float> power_ = {};
+  std::vector<Spectrum> spectra_ = {};
+};
+
+} // namespace signal_easel
+
+#endif /* SIGNAL_EASEL_SPECTRUM_HPP_ */
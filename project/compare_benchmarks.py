@@ -0,0 +1,108 @@
+#!/usr/bin/env python3
+"""Compare a signal_easel_benchmarks JSON report against a saved baseline.
+
+Throughput counters (samples/sec, frames/sec) are compared when a benchmark
+reports them, otherwise the real time per iteration is. When the reports
+contain repetitions, the median is used. Benchmarks that report a
+success_rate (the packet success rate through the channel simulator) are also
+checked for lost sensitivity.
+
+Usage: compare_benchmarks.py <baseline.json> <results.json> [--threshold 10]
+                             [--success-threshold 0.05]
+
+Exits with 1 if any benchmark is slower than the baseline by more than the
+threshold (in percent), or decodes a smaller fraction of packets by more than
+the success threshold (absolute).
+"""
+
+import argparse
+import json
+import sys
+
+THROUGHPUT_COUNTERS = ("samples", "frames", "bytes_per_second")
+
+
+def load(path):
+    """Returns {benchmark name: entry}, preferring the median aggregate."""
+    with open(path) as file:
+        report = json.load(file)
+
+    results = {}
+    for entry in report["benchmarks"]:
+        name = entry.get("run_name", entry["name"])
+        if entry.get("run_type") == "aggregate":
+            if entry.get("aggregate_name") == "median":
+                results[name] = entry
+        elif name not in results:
+            results[name] = entry
+    return results
+
+
+def metric(entry):
+    """Returns (value, higher is better, unit) for a benchmark entry."""
+    for counter in THROUGHPUT_COUNTERS:
+        if counter in entry:
+            return entry[counter], True, counter + "/s"
+    return entry["real_time"], False, entry["time_unit"]
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    parser.add_argument("baseline")
+    parser.add_argument("results")
+    parser.add_argument("--threshold", type=float, default=10.0,
+                        help="allowed slow down in percent (default 10)")
+    parser.add_argument("--success-threshold", type=float, default=0.05,
+                        help="allowed drop in packet success rate, as a "
+                        "fraction (default 0.05)")
+    args = parser.parse_args()
+
+    baseline = load(args.baseline)
+    results = load(args.results)
+
+    regressions = []
+    print(f"{'Benchmark':<60} {'Baseline':>14} {'Current':>14} {'Change':>8}")
+    for name, entry in results.items():
+        if name not in baseline:
+            print(f"{name:<60} {'-':>14} {'(new)':>14}")
+            continue
+
+        current, higher_is_better, unit = metric(entry)
+        previous, _, _ = metric(baseline[name])
+        if previous == 0:
+            continue
+
+        change = (current - previous) / previous * 100.0
+        slower_by = -change if higher_is_better else change
+        flag = ""
+        if slower_by > args.threshold:
+            regressions.append(name)
+            flag = "  <-- slower"
+        print(f"{name:<60} {previous:>14.4g} {current:>14.4g} "
+              f"{change:>+7.1f}% {unit}{flag}")
+
+        if "success_rate" in entry and "success_rate" in baseline[name]:
+            current = entry["success_rate"]
+            previous = baseline[name]["success_rate"]
+            flag = ""
+            if previous - current > args.success_threshold:
+                if name not in regressions:
+                    regressions.append(name)
+                flag = "  <-- less sensitive"
+            print(f"{name + ' (success rate)':<60} {previous:>14.2f} "
+                  f"{current:>14.2f} {current - previous:>+8.2f}{flag}")
+
+    for name in baseline:
+        if name not in results:
+            print(f"{name:<60} {'(missing)':>14}")
+
+    if regressions:
+        print(f"\n{len(regressions)} benchmark(s) regressed by more than "
+              f"{args.threshold}% or lost more than "
+              f"{args.success_threshold:.0%} of their packets")
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,49 @@
+#!/bin/bash
+
+# Builds and runs the benchmarks, then compares the results against the saved
+# baseline (project/benchmark_baseline.json) if there is one.
+#
+# ./project/run_benchmarks.sh                  Run and compare
+# ./project/run_benchmarks.sh --save-baseline  Run and save as the new baseline
+#
+# Any other arguments are passed on to signal_easel_benchmarks, for example
+# --benchmark_filter=ToneDetector
+
+set -e
+
+BASELINE=project/benchmark_baseline.json
+RESULTS=build/benchmark_results.json
+
+SAVE_BASELINE=""
+if [ "$1" == "--save-baseline" ]; then
+  SAVE_BASELINE="yes"
+  shift
+fi
+
+mkdir -p build
+cd build
+
+# Configure
+cmake .. -DCMAKE_BUILD_TYPE=Release -DSIGNALEASEL_BENCHMARKS=ON
+
+# Build
+cmake --build . --target signal_easel_benchmarks
+
+# Run, repeated so the comparison can use the median
+./benchmarks/signal_easel_benchmarks \
+  --benchmark_repetitions=5 \
+  --benchmark_report_aggregates_only=true \
+  --benchmark_out=benchmark_results.json \
+  --benchmark_out_format=json \
+  "$@"
+
+cd ..
+
+if [ ! -z "$SAVE_BASELINE" ]; then
+  cp $RESULTS $BASELINE
+  echo "Saved the baseline to $BASELINE"
+elif [ -f $BASELINE ]; then
+  python3 ./project/compare_benchmarks.py $BASELINE $RESULTS
+else
+  echo "No baseline to compare against, create one with --save-baseline"
+fi
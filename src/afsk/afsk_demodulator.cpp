@@ -22,10 +22,52 @@
 #include <SignalEasel/afsk.hpp>
 #include <SignalEasel/exception.hpp>
 
-#include "band_pass_filter.hpp"
+#include "stage_timer.hpp"
+#include "tone_detector.hpp"
 
 namespace signal_easel {
 
+afsk::Demodulator::Demodulator(afsk::Settings settings)
+    : signal_easel::Demodulator(settings), afsk_settings_(std::move(settings)),
+      sample_rate_(afsk_settings_.demodulation_sample_rate) {
+  if (sample_rate_ < AFSK_MIN_DEMODULATION_SAMPLE_RATE ||
+      sample_rate_ > AUDIO_SAMPLE_RATE || sample_rate_ % AFSK_BAUD_RATE != 0 ||
+      (afsk_settings_.decimating_front_end &&
+       AUDIO_SAMPLE_RATE % sample_rate_ != 0)) {
+    throw Exception(Exception::Id::AFSK_INVALID_DEMODULATION_SAMPLE_RATE,
+                    std::to_string(sample_rate_));
+  }
+  validate(afsk_settings_.afc_range <= AFSK_AFC_MAX_RANGE,
+           "The AFC range must be at most AFSK_AFC_MAX_RANGE");
+
+  samples_per_symbol_ = static_cast<int32_t>(sample_rate_ / AFSK_BAUD_RATE);
+  resampler_ = Resampler(AUDIO_SAMPLE_RATE, sample_rate_,
+                         AFSK_RESAMPLER_FILTER_HALF_LENGTH);
+  tone_detector_ =
+      ToneDetector::create(sample_rate_, afsk_settings_.demodulation_engine,
+                           afsk_settings_.afc_range);
+}
+
+const std::vector<int16_t> &afsk::Demodulator::getDemodulationBuffer() {
+  if (resampler_.isPassthrough() || audio_at_demodulation_rate_) {
+    return getAudioBuffer();
+  }
+
+  // Each buffer is demodulated on it's own, so start from a clean history
+  resampled_audio_.clear();
+  resampler_.reset();
+  resampler_.process(getAudioBuffer(), resampled_audio_);
+  resampler_.flush(resampled_audio_);
+
+  // Line the output up with the original audio
+  const size_t delay = std::min(resampler_.getDelay(), resampled_audio_.size());
+  resampled_audio_.erase(resampled_audio_.begin(),
+                         resampled_audio_.begin() + delay);
+  return resampled_audio_;
+}
+
+afsk::Demodulator::~Demodulator() = default;
+
 afsk::Demodulator::ProcessResults afsk::Demodulator::processAudioBuffer() {
   afsk::Demodulator::ProcessResults results;
 
@@ -38,115 +80,21 @@ afsk::Demodulator::ProcessResults afsk::Demodulator::processAudioBuffer() {
 void afsk::Demodulator::audioBufferToBaseBandSignal(
     afsk::Demodulator::ProcessResults &results) {
   base_band_signal_.clear();
-  const auto &samples_buffer = getAudioBuffer();
-  std::vector<double> unfiltered(samples_buffer.begin(), samples_buffer.end());
-
-  auto filtered_audio =
-      bandPassFilter(unfiltered, AUDIO_SAMPLE_RATE_D, AFSK_BP_MARK_LOWER_CUTOFF,
-                     AFSK_BP_SPACE_UPPER_CUTOFF, AFSK_BP_FILTER_ORDER);
-
-  // calculate RMS for SNR
-  auto lower_audio =
-      bandPassFilter(unfiltered, AUDIO_SAMPLE_RATE_D, AFSK_BP_MARK_LOWER_CUTOFF,
-                     AFSK_BP_MARK_UPPER_CUTOFF, AFSK_BP_FILTER_ORDER);
-  auto upper_audio = bandPassFilter(
-      unfiltered, AUDIO_SAMPLE_RATE_D, AFSK_BP_SPACE_LOWER_CUTOFF,
-      AFSK_BP_SPACE_UPPER_CUTOFF, AFSK_BP_FILTER_ORDER);
-  if (lower_audio.size() != upper_audio.size()) {
-    throw Exception(Exception::Id::NON_MATCHING_FILTER_VECTORS);
-  }
-
-  double rms = 0;
-  for (size_t i = 0; i < lower_audio.size(); i++) {
-    double combined =
-        (lower_audio.at(i) + upper_audio.at(i)) / AFSK_BP_INCLUDED_BANDWIDTH;
-    rms += combined * combined;
-  }
-  rms = std::sqrt(rms / lower_audio.size());
-
-  // calculate the RMS for a wider signal
-  constexpr double WIDE_BAND_LOWER_CUTOFF = 500;
-  constexpr double WIDE_BAND_UPPER_CUTOFF = 2700;
-  constexpr double WIDE_BAND_INCLUDED_BANDWIDTH =
-      WIDE_BAND_UPPER_CUTOFF - WIDE_BAND_LOWER_CUTOFF;
-  constexpr double WIDE_BAND_RMS_ADDITIONAL_WEIGHT = 0.5;
-  auto wide_audio =
-      bandPassFilter(unfiltered, AUDIO_SAMPLE_RATE_D, WIDE_BAND_LOWER_CUTOFF,
-                     WIDE_BAND_UPPER_CUTOFF, AFSK_BP_FILTER_ORDER);
-  double wide_rms = 0;
-  for (double &sample : wide_audio) {
-    double adjusted = (sample / WIDE_BAND_INCLUDED_BANDWIDTH) +
-                      WIDE_BAND_RMS_ADDITIONAL_WEIGHT;
-    wide_rms += adjusted * adjusted;
-  }
-  wide_rms = std::sqrt(wide_rms / wide_audio.size());
-
-  // calculate SNR
-  results.rms = rms;
-  results.snr = 20 * std::log10(rms / wide_rms);
-
-  if (results.snr < AFSK_MINIMUM_SNR) {
-    results.snr = AFSK_MINIMUM_SNR;
-  }
-
-  const size_t k_number_of_samples = filtered_audio.size();
-
-  std::vector<double> mark_i(k_number_of_samples);
-  std::vector<double> mark_q(k_number_of_samples);
-  std::vector<double> space_i(k_number_of_samples);
-  std::vector<double> space_q(k_number_of_samples);
-
-  for (int i = 0; i < static_cast<int>(k_number_of_samples); i++) {
-    // normalized sample (between -1 and 1)
-    double sample =
-        filtered_audio.at(i) / static_cast<double>(MAX_SAMPLE_VALUE);
-
-    mark_i.at(i) =
-        sample *
-        std::sin(TWO_PI_VAL * i * (AFSK_MARK_FREQUENCY / AUDIO_SAMPLE_RATE_D));
-    mark_q.at(i) =
-        sample *
-        std::cos(TWO_PI_VAL * i * (AFSK_MARK_FREQUENCY / AUDIO_SAMPLE_RATE_D));
-    space_i.at(i) =
-        sample *
-        std::sin(TWO_PI_VAL * i * (AFSK_SPACE_FREQUENCY / AUDIO_SAMPLE_RATE_D));
-    space_q.at(i) =
-        sample *
-        std::cos(TWO_PI_VAL * i * (AFSK_SPACE_FREQUENCY / AUDIO_SAMPLE_RATE_D));
-
-    double mark_i_integ = 0;
-    double mark_q_integ = 0;
-    double space_i_integ = 0;
-    double space_q_integ = 0;
-
-    for (int j = 0;
-         j < static_cast<int>(AUDIO_SAMPLE_RATE / AFSK_MARK_FREQUENCY); j++) {
-      auto index = i - j;
-      if (index > 0) {
-        mark_i_integ += mark_i.at(index);
-        mark_q_integ += mark_q.at(index);
-        space_i_integ += space_i.at(index);
-        space_q_integ += space_q.at(index);
-      }
-    }
-
-    double correlator_mark =
-        mark_i_integ * mark_i_integ + mark_q_integ * mark_q_integ;
-    double correlator_space =
-        space_i_integ * space_i_integ + space_q_integ * space_q_integ;
-    double result = correlator_mark - correlator_space;
-
-    base_band_signal_.push_back(result > 0.0 ? 0xff : 0x00);
+  const std::vector<int16_t> *audio = nullptr;
+  {
+    StageTimer timer(results.filter_time);
+    audio = &getDemodulationBuffer();
   }
+  tone_detector_->process(*audio, base_band_signal_, results);
 }
 
 void afsk::Demodulator::baseBandToBitStream(
     afsk::Demodulator::ProcessResults &results) {
-  (void)results;
-  output_bit_stream_ = BitStream();
-  /// @brief The sample clock counts up to 40 and then resets.
-  /// @details Symbols are 40 samples long. This clock is used to determine when
-  /// to add a bit to the bit stream.
+  StageTimer timer(results.clock_recovery_time);
+  output_bit_stream_.clear();
+  /// @brief The sample clock counts up to samples_per_symbol_ and then resets.
+  /// @details Symbols are 40 samples long at 48kHz. This clock is used to
+  /// determine when to add a bit to the bit stream.
   int32_t sample_clock = 0;
   /// @brief Used to detect the actual symbol boundary.
   uint8_t previous_sample = 0;
@@ -172,16 +120,25 @@ void afsk::Demodulator::baseBandToBitStream(
   constexpr double CLOCK_SKEW_ALPHA = 0.5;
   double clock_skew_accumulator = 0;
 
-  constexpr int32_t MIN_SAMPLES_BETWEEN_CLOCK_ADJUSTMENTS = 10;
+  // The clock recovery thresholds were tuned at 48kHz (40 samples per symbol),
+  // scale them to the demodulation rate.
+  const int32_t half_symbol = samples_per_symbol_ / 2;
+  const double symbol_scale = samples_per_symbol_ / 40.0;
+  const double clock_skew_threshold = 7 * symbol_scale;
+  const double clock_skew_jump_threshold = 15 * symbol_scale;
+  const int32_t clock_skew_jump =
+      static_cast<int32_t>(std::lround(15 * symbol_scale));
+  const int32_t min_samples_between_clock_adjustments =
+      static_cast<int32_t>(std::lround(10 * symbol_scale));
   int32_t samples_since_last_clock_adjustment = 0;
 
   for (uint8_t sample : base_band_signal_) {
     sample_clock++;
     samples_since_last_clock_adjustment++;
 
-    // trigger a reading of the current symbol's value. True every 40
-    // samples.
-    if (sample_clock % static_cast<int32_t>(AFSK_SAMPLES_PER_SYMBOL) == 0) {
+    // trigger a reading of the current symbol's value. True every
+    // samples_per_symbol_ samples.
+    if (sample_clock % samples_per_symbol_ == 0) {
       /// @todo some form of 'confidence rating' could be helpful here
       // int8_t bit = sample > 0 ? 0xff : 0;
       output_bit_stream_.addBits((unsigned char *)&sample, 1);
@@ -198,7 +155,8 @@ void afsk::Demodulator::baseBandToBitStream(
       mean_samples_between_boundaries =
           samples_since_last_boundary_sum / num_boundaries;
 
-      int timing_error_num_samples = sample_clock % 40 - 20;
+      int timing_error_num_samples =
+          sample_clock % samples_per_symbol_ - half_symbol;
       // ahead = timing_error_num_samples > 0;
       timing_error_num_samples = std::abs(timing_error_num_samples);
 
@@ -224,12 +182,12 @@ void afsk::Demodulator::baseBandToBitStream(
     previous_sample = sample;
 
     // adjust the sample clock in an attempt to synchronize
-    if (clock_skew_accumulator > 7 &&
+    if (clock_skew_accumulator > clock_skew_threshold &&
         samples_since_last_clock_adjustment >
-            MIN_SAMPLES_BETWEEN_CLOCK_ADJUSTMENTS) {
+            min_samples_between_clock_adjustments) {
       samples_since_last_clock_adjustment = 0;
-      if (clock_skew_accumulator > 15) {
-        sample_clock += 15;
+      if (clock_skew_accumulator > clock_skew_jump_threshold) {
+        sample_clock += clock_skew_jump;
         num_clock_syncs++;
       } else {
         // if (ahead) {
@@ -249,36 +207,71 @@ void afsk::Demodulator::baseBandToBitStream(
   output_bit_stream_.pushBufferToBitStream();
 }
 
-afsk::Demodulator::AsciiResult
-afsk::Demodulator::lookForString(std::string &output) {
-  output.clear();
-
-  const auto &bit_vector = output_bit_stream_.getBitVector();
-
+bool afsk::Demodulator::alignOnPreamble() {
   constexpr uint8_t SYN_CHAR = 0x16;
+  constexpr uint8_t STX_CHAR = 0x02;
+  /// @brief The most bits the clock can slip by and still be re-aligned, a
+  /// bit gained or lost either way
+  constexpr int MAX_PREAMBLE_SLIP = 7;
+
+  // detect syn character, burning off the bits before it
+  while (output_bit_stream_.peakNextByte() != SYN_CHAR) {
+    if (output_bit_stream_.popNextBit() == -1) {
+      return false;
+    }
+  }
 
-  // detect syn character
-  int8_t char_offset = -1;
-  for (uint32_t word : bit_vector) {
-    for (int8_t i = 0; i < 32; i++) {
-      uint8_t byte = (word >> (24 - i)) & 0xFF;
-      if (byte == SYN_CHAR) {
-        char_offset = i;
-        break;
+  /// @brief A SYN followed by another SYN or the STX, a single SYN could be
+  /// the bits of the text after the preamble
+  const auto continues_preamble = [](BitStream stream) {
+    if (stream.peakNextByte() != SYN_CHAR) {
+      return false;
+    }
+    for (int i = 0; i < 8; i++) {
+      stream.popNextBit();
+    }
+    const int next_byte = stream.peakNextByte();
+    return next_byte == SYN_CHAR || next_byte == STX_CHAR;
+  };
+
+  // Follow the preamble to it's end, re-aligning whenever the clock slipped.
+  // That is checked before taking an STX at face value, as the end of one
+  // SYN and the start of the next can read as one.
+  while (true) {
+    const int next_byte = output_bit_stream_.peakNextByte();
+    if (next_byte == SYN_CHAR) {
+      for (int i = 0; i < 8; i++) {
+        output_bit_stream_.popNextBit();
       }
+      continue;
+    }
+    if (next_byte == -1) {
+      return true;
     }
+
+    BitStream look_ahead = output_bit_stream_;
+    bool slipped = false;
+    for (int slip = 0; slip < MAX_PREAMBLE_SLIP && !slipped; slip++) {
+      look_ahead.popNextBit();
+      slipped = continues_preamble(look_ahead);
+    }
+    if (!slipped) {
+      return true; // end of the preamble
+    }
+    output_bit_stream_ = look_ahead;
   }
+}
+
+afsk::Demodulator::AsciiResult
+afsk::Demodulator::lookForString(std::string &output) {
+  output.clear();
 
-  if (char_offset == -1) { // no syn character found/couldn't synchronize
+  if (!alignOnPreamble()) {
+    // no syn character found/couldn't synchronize
     return afsk::Demodulator::AsciiResult::NO_SYN;
   }
 
   size_t num_bits = output_bit_stream_.getBitStreamLength();
-  while (char_offset > 0) { // burn off the bits before the first syn character
-    output_bit_stream_.popNextBit();
-    char_offset--;
-  }
-
   while (num_bits > 0) {
     uint8_t byte = 0;
     int8_t bit_buffer = 0;
@@ -62,6 +62,53 @@ void afsk::Modulator::encodeBytes(const std::vector<uint8_t> &input_bytes) {
     throw Exception(Exception::Id::NO_DATA_TO_WRITE);
   }
 
+  // A new transmission can start at any phase, start it at zero. Within a
+  // transmission keep the phase, but with the integrator in one turn.
+  if (audio_buffer_.empty()) {
+    integral_value_ = 0;
+  }
+  integral_value_ = (integral_value_ % INTEGRAL_PERIOD_ + INTEGRAL_PERIOD_) %
+                    INTEGRAL_PERIOD_;
+
+  if (audio_cache_ == nullptr) {
+    renderBytes(input_bytes);
+    return;
+  }
+
+  buildCacheKey(input_bytes);
+  const auto cached = audio_cache_->find(cache_key_);
+  if (cached != nullptr) {
+    audio_buffer_.insert(audio_buffer_.end(), cached->samples.begin(),
+                         cached->samples.end());
+    integral_value_ += static_cast<int32_t>(cached->state_change);
+    return;
+  }
+
+  const size_t first_sample = audio_buffer_.size();
+  const int32_t first_integral_value = integral_value_;
+  renderBytes(input_bytes);
+
+  CachedAudio audio;
+  audio.samples.assign(audio_buffer_.begin() + first_sample,
+                       audio_buffer_.end());
+  audio.state_change = integral_value_ - first_integral_value;
+  audio_cache_->insert(cache_key_, std::move(audio));
+}
+
+void afsk::Modulator::buildCacheKey(const std::vector<uint8_t> &input_bytes) {
+  auto append = [this](const auto &value) {
+    cache_key_.append(reinterpret_cast<const char *>(&value), sizeof(value));
+  };
+
+  cache_key_.clear();
+  append(settings_.amplitude);
+  append(settings_.bit_encoding);
+  append(settings_.include_ascii_padding);
+  append(integral_value_);
+  cache_key_.append(input_bytes.begin(), input_bytes.end());
+}
+
+void afsk::Modulator::renderBytes(const std::vector<uint8_t> &input_bytes) {
   std::vector<uint8_t> bytes;
 
   if (settings_.include_ascii_padding) {
@@ -85,49 +132,60 @@ void afsk::Modulator::encodeBytes(const std::vector<uint8_t> &input_bytes) {
   //   }
   // }
 
-  const uint32_t NUM_BITS_TO_ENCODE = bytes.size() * 8;
-
-  /// @brief "index" is the used to determine when to go to the next bit. It is
-  /// not actually used as an index.
-  int index = 0;
-  /// @brief "prev_index" is the previous value of "index"
-  int prev_index = 0;
-
-  /// @brief The index of the current bit in the vector of bytes
-  size_t bit_index = 0;
-
-  // get the first bit bp bit
-  current_bipolar_bit_ = getBpBitAtIndex(bytes, bit_index);
-  bit_index++;
-
-  uint32_t iterations = NUM_BITS_TO_ENCODE * SAMPLES_PER_SYMBOL_;
-  for (uint32_t i = 2; i < iterations; i++) {
-    index = std::floor((float)i / (float)SAMPLES_PER_SYMBOL_);
-    prev_index = std::floor((float)(i - 1) / (float)SAMPLES_PER_SYMBOL_);
-
-    if (index != prev_index) { // Go to the next bit
-      previous_bipolar_bit_ = current_bipolar_bit_;
-      current_bipolar_bit_ = getBpBitAtIndex(bytes, bit_index);
-      bit_index++;
+  const size_t num_bits = bytes.size() * 8;
+  audio_buffer_.reserve(audio_buffer_.size() +
+                        num_bits * OUTPUT_SAMPLES_PER_SYMBOL_);
+
+  // The phase at oversampled step 1, the step before the first one rendered
+  uint32_t phase =
+      (CENTER_PHASE_STEP_ +
+       static_cast<uint32_t>(integral_value_) * DELTA_PHASE_STEP_) %
+      TONE_TABLE_SIZE_;
+
+  /// @brief Adds a whole number of oversampled steps to the phase, where the
+  /// integrator moves by integral_step each step.
+  auto advance = [&phase](uint32_t steps, int32_t integral_step) {
+    phase += steps * getPhaseStep(integral_step);
+    phase %= TONE_TABLE_SIZE_;
+  };
+
+  int8_t previous_bipolar_bit = 0;
+  for (size_t bit_index = 0; bit_index < num_bits; bit_index++) {
+    const int8_t bipolar_bit = getBpBitAtIndex(bytes, bit_index);
+
+    // Step to the symbol's first sample. The first symbol starts at step 2,
+    // so it's first sample (step 4) is three steps in and the one at step 0
+    // is never rendered. Every other symbol starts on a sample, and the
+    // integrator only moves across the boundary if the tone doesn't change.
+    uint32_t first_sample = 0;
+    if (bit_index == 0) {
+      first_sample = 1;
+      advance(OVER_SAMPLE_FACTOR_ - 1, bipolar_bit);
+      integral_value_ += (OVER_SAMPLE_FACTOR_ - 1) * bipolar_bit;
     } else {
-      previous_bipolar_bit_ = current_bipolar_bit_;
+      const int32_t boundary_step = (bipolar_bit + previous_bipolar_bit) / 2;
+      advance(1, boundary_step);
+      integral_value_ += boundary_step;
     }
 
-    // Integrate the bipolar bit
-    integral_value_ += ((current_bipolar_bit_ + previous_bipolar_bit_) / 2);
-
-    // Only write the OVER_SAMPLE_FACTOR_'th sample
-    if (i % OVER_SAMPLE_FACTOR_ == 0) {
-      constexpr double LHS_MULTIPLIER = TWO_PI_VAL * CENTER_OVER_SAMPLE_FREQ_;
-      constexpr double RHS_MULTIPLIER = TWO_PI_VAL * DELTA_OVER_SAMPLE_FREQ_;
-      double lhs = LHS_MULTIPLIER * static_cast<double>(i);
-      double rhs = RHS_MULTIPLIER * static_cast<double>(integral_value_);
-      int16_t sample = static_cast<int16_t>(
-          MAX_SAMPLE_VALUE * (std::cos(lhs + rhs) * settings_.amplitude));
+    // Walk the tone table one output sample at a time, for the tone
+    const uint32_t sample_step =
+        OVER_SAMPLE_FACTOR_ * getPhaseStep(bipolar_bit);
+    for (uint32_t sample = first_sample; sample < OUTPUT_SAMPLES_PER_SYMBOL_;
+         sample++) {
+      if (sample != first_sample) {
+        phase += sample_step;
+        if (phase >= TONE_TABLE_SIZE_) {
+          phase -= TONE_TABLE_SIZE_;
+        }
+      }
+      int16_t audio_sample = tone_table_[phase];
 
 #ifdef NOISE_SIMULATION
 
       // Add noise
+      const uint32_t i = (bit_index * OUTPUT_SAMPLES_PER_SYMBOL_ + sample) *
+                         OVER_SAMPLE_FACTOR_;
       constexpr double k_noise_amplitude = 0.70;
       constexpr double k_noise_frequency_1 = 500;
       constexpr double k_noise_frequency_2 = 3200;
@@ -139,12 +197,30 @@ void afsk::Modulator::encodeBytes(const std::vector<uint8_t> &input_bytes) {
           k_noise_amplitude *
           std::sin(TWO_PI_VAL * k_noise_frequency_2 * static_cast<double>(i) /
                    static_cast<double>(SAMPLE_FREQUENCY_));
-      sample += static_cast<int16_t>(MAX_SAMPLE_VALUE * noise1 * noise2);
+      audio_sample += static_cast<int16_t>(MAX_SAMPLE_VALUE * noise1 * noise2);
 
 #endif // NOISE_SIMULATION
 
-      addAudioSample(sample);
+      addAudioSample(audio_sample);
     }
+
+    // The steps after the last sample, up to the next symbol
+    advance(OVER_SAMPLE_FACTOR_ - 1, bipolar_bit);
+    integral_value_ +=
+        static_cast<int32_t>(OVER_SAMPLE_FACTOR_ * (OUTPUT_SAMPLES_PER_SYMBOL_ -
+                                                    first_sample - 1) +
+                             OVER_SAMPLE_FACTOR_ - 1) *
+        bipolar_bit;
+
+    previous_bipolar_bit = bipolar_bit;
+  }
+}
+
+void afsk::Modulator::buildToneTable() {
+  for (uint32_t i = 0; i < TONE_TABLE_SIZE_; i++) {
+    const double phase = TWO_PI_VAL * static_cast<double>(i) / TONE_TABLE_SIZE_;
+    tone_table_[i] = static_cast<int16_t>(
+        MAX_SAMPLE_VALUE * (std::cos(phase) * settings_.amplitude));
   }
 }
 
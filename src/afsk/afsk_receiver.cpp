@@ -19,48 +19,121 @@
 #include <iomanip>
 #include <iostream>
 
+#include "snr_estimator.hpp"
+#include "stage_timer.hpp"
+
 namespace signal_easel {
 
+afsk::Receiver::Receiver(afsk::Settings settings)
+    : signal_easel::Receiver(settings), demodulator_(settings),
+      afsk_settings_(std::move(settings)),
+      snr_estimator_(std::make_unique<SnrEstimator>(
+          AUDIO_SAMPLE_RATE, afsk_settings_.afc_range)) {
+  processing_stats_.enabled = INSTRUMENTATION_ENABLED;
+
+  if (!afsk_settings_.decimating_front_end) {
+    return;
+  }
+
+  const uint32_t sample_rate = afsk_settings_.demodulation_sample_rate;
+  const uint32_t factor = AUDIO_SAMPLE_RATE / sample_rate;
+  front_end_ = Resampler(AUDIO_SAMPLE_RATE, sample_rate,
+                         AFSK_RESAMPLER_FILTER_HALF_LENGTH);
+  demodulator_.audio_at_demodulation_rate_ = true;
+  snr_estimator_ =
+      std::make_unique<SnrEstimator>(sample_rate, afsk_settings_.afc_range);
+
+  received_min_samples_ = AFSK_RECEIVED_MIN_SAMPLES / factor;
+  periodic_decode_sample_count_ = PERIODIC_DECODE_SAMPLE_COUNT / factor;
+  decode_tail_sample_count_ = DECODE_TAIL_SAMPLE_COUNT / factor;
+}
+
+afsk::Receiver::~Receiver() = default;
+
 bool afsk::Receiver::process() {
+  if (pcm_stream_reader_) {
+    if (!pcm_stream_reader_->process()) {
+      if (pcm_stream_reader_->isEndOfStream()) {
+        flushReceiveBuffer();
+      }
+      return false;
+    }
+    const auto &audio_buffer = pcm_stream_reader_->getAudioBuffer();
+    detectSignal(audio_buffer.data(), audio_buffer.size());
+    return true;
+  }
+
   if (!pulse_audio_reader_) {
     pulse_audio_reader_ = std::make_unique<PulseAudioReader>();
   }
   if (!pulse_audio_reader_->process()) {
     return false;
   }
+  if (INSTRUMENTATION_ENABLED &&
+      pulse_audio_reader_->getLatency() > AUDIO_BACKLOG_OVERRUN_MS) {
+    processing_stats_.audio_overruns++;
+  }
   detectSignal(pulse_audio_reader_->getAudioBuffer());
   return true;
 }
 
-bool afsk::Receiver::detectSignal(const PulseAudioBuffer &audio_buffer) {
-  demodulator_.audio_buffer_.clear();
-  demodulator_.audio_buffer_ =
-      std::vector<int16_t>(audio_buffer.begin(), audio_buffer.end());
+bool afsk::Receiver::detectSignal(const int16_t *samples, size_t num_samples) {
+  StageTimer processing_timer(processing_stats_.processing_time);
+  StageTimer::Clock::time_point arrival{};
+  if constexpr (INSTRUMENTATION_ENABLED) {
+    arrival = StageTimer::Clock::now();
+    processing_stats_.audio_samples += num_samples;
+  }
+
+  if (spectrum_analyzer_) {
+    spectrum_analyzer_->process(samples, num_samples);
+  }
 
   afsk::Demodulator::ProcessResults results{};
-  demodulator_.audioBufferToBaseBandSignal(results);
+  {
+    StageTimer timer(results.filter_time);
+    if (afsk_settings_.decimating_front_end) {
+      // Decimate once here so that nothing downstream touches the full rate
+      front_end_buffer_.clear();
+      front_end_.process(samples, num_samples, front_end_buffer_);
+      samples = front_end_buffer_.data();
+      num_samples = front_end_buffer_.size();
+    }
+
+    // A partial Goertzel block carries over into the next block of audio
+    snr_estimator_->process(samples, num_samples);
+    snr_estimator_->estimate(results);
+  }
+  if constexpr (INSTRUMENTATION_ENABLED) {
+    auto &filter = processing_stats_.getStage(ProcessingStage::FILTER);
+    filter.calls++;
+    filter.items += num_samples;
+    filter.time += results.filter_time;
+  }
 
   const bool signal_detected = results.snr > AFSK_SNR_THRESHOLD;
   live_snr_ = results.snr;
   if (signal_detected) {
-    receive_buffer_.insert(receive_buffer_.end(), audio_buffer.begin(),
-                           audio_buffer.end());
+    last_signal_arrival_ = arrival;
+
+    receive_buffer_.insert(receive_buffer_.end(), samples,
+                           samples + num_samples);
 
     // If the signal is sustained (e.g. back-to-back packets with no gap),
     // periodically decode so that the receive buffer doesn't grow without
     // bound and so that packets are delivered in a timely fashion. After
     // decoding, keep a tail of audio samples so that a packet straddling
     // the decode boundary can still be recovered on the next decode.
-    if (receive_buffer_.size() >= PERIODIC_DECODE_SAMPLE_COUNT) {
+    if (receive_buffer_.size() >= periodic_decode_sample_count_) {
       demodulator_.audio_buffer_ = receive_buffer_;
       decode();
       retainTailSamples();
     }
-  } else if (receive_buffer_.size() > AFSK_RECEIVED_MIN_SAMPLES) {
+  } else if (receive_buffer_.size() > received_min_samples_) {
     // Signal dropped after we had been receiving: treat as end-of-burst and
     // decode everything we've accumulated.
-    receive_buffer_.insert(receive_buffer_.end(), audio_buffer.begin(),
-                           audio_buffer.end());
+    receive_buffer_.insert(receive_buffer_.end(), samples,
+                           samples + num_samples);
     demodulator_.audio_buffer_ = receive_buffer_;
     decode();
     receive_buffer_.clear();
@@ -72,21 +145,87 @@ bool afsk::Receiver::detectSignal(const PulseAudioBuffer &audio_buffer) {
   return signal_detected;
 }
 
+void afsk::Receiver::enableSpectrum(SpectrumSettings settings) {
+  spectrum_analyzer_ = std::make_unique<SpectrumAnalyzer>(settings);
+}
+
+bool afsk::Receiver::takeSpectra(
+    std::vector<SpectrumAnalyzer::Spectrum> &spectra) {
+  if (!spectrum_analyzer_) {
+    spectra.clear();
+    return false;
+  }
+  return spectrum_analyzer_->takeSpectra(spectra);
+}
+
+void afsk::Receiver::flushReceiveBuffer() {
+  StageTimer processing_timer(processing_stats_.processing_time);
+  if (afsk_settings_.decimating_front_end && !receive_buffer_.empty()) {
+    front_end_.flush(receive_buffer_);
+  }
+  front_end_.reset();
+  snr_estimator_->reset();
+
+  if (receive_buffer_.size() > received_min_samples_) {
+    demodulator_.audio_buffer_ = receive_buffer_;
+    decode();
+  }
+  receive_buffer_.clear();
+}
+
 void afsk::Receiver::retainTailSamples() {
-  if (receive_buffer_.size() <= DECODE_TAIL_SAMPLE_COUNT) {
+  if (receive_buffer_.size() <= decode_tail_sample_count_) {
     receive_buffer_.clear();
     return;
   }
-  const size_t drop_count = receive_buffer_.size() - DECODE_TAIL_SAMPLE_COUNT;
+  const size_t drop_count = receive_buffer_.size() - decode_tail_sample_count_;
   receive_buffer_.erase(receive_buffer_.begin(),
                         receive_buffer_.begin() + drop_count);
 }
 
+void afsk::Receiver::recordDemodulation(
+    const afsk::Demodulator::ProcessResults &results, bool clock_recovery) {
+  if constexpr (!INSTRUMENTATION_ENABLED) {
+    return;
+  }
+
+  const uint64_t num_samples = demodulator_.base_band_signal_.size();
+  auto add = [&](ProcessingStage stage, std::chrono::nanoseconds time) {
+    auto &stage_stats = processing_stats_.getStage(stage);
+    stage_stats.calls++;
+    stage_stats.items += num_samples;
+    stage_stats.time += time;
+  };
+
+  add(ProcessingStage::FILTER, results.filter_time);
+  add(ProcessingStage::CORRELATOR, results.correlator_time);
+  if (clock_recovery) {
+    add(ProcessingStage::CLOCK_RECOVERY, results.clock_recovery_time);
+  }
+}
+
+void afsk::Receiver::recordPacketDelivered() {
+  if constexpr (INSTRUMENTATION_ENABLED) {
+    processing_stats_.latency.add(StageTimer::Clock::now() -
+                                  last_signal_arrival_);
+  }
+}
+
 void afsk::Receiver::decode() {
-  demodulator_.processAudioBuffer();
+  const auto results = demodulator_.processAudioBuffer();
+  recordDemodulation(results, true);
+  frequency_offset_ = results.frequency_offset;
 
+  auto &deframe = processing_stats_.getStage(ProcessingStage::DEFRAME);
   std::string out_str;
-  demodulator_.lookForString(out_str);
+  {
+    StageTimer timer(deframe.time);
+    demodulator_.lookForString(out_str);
+  }
+  if constexpr (INSTRUMENTATION_ENABLED) {
+    deframe.calls++;
+    deframe.items += demodulator_.output_bit_stream_.getBitStreamLength();
+  }
 }
 
 } // namespace signal_easel
\ No newline at end of file
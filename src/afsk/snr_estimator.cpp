@@ -0,0 +1,172 @@
+/**
+ * =*========SignalEasel========*=
+ * A friendly library for signal modulation and demodulation.
+ * https://github.com/joshua-jerred/Giraffe
+ * https://joshuajer.red/signal-easel
+ * =*===========================*=
+ *
+ * @file   snr_estimator.cpp
+ * @date   2026-10-19
+ * @brief  Incremental AFSK SNR and carrier detection
+ *
+ * =*=======================*=
+ * @copyright  2026 Joshua Jerred
+ * @license    GNU GPLv3
+ */
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+#include "snr_estimator.hpp"
+
+namespace signal_easel::afsk {
+
+namespace {
+
+/// @brief The spacing of the Goertzel bins, 10 ms blocks. The tones are
+/// whole bins.
+constexpr uint32_t BIN_WIDTH = 100;
+
+/// @brief The noise bins' frequencies, where an AFSK signal is over 25 dB
+/// down but still inside of a radio's 300-3000 Hz audio.
+constexpr std::array<double, 2> NOISE_FREQUENCIES = {500.0, 2900.0};
+
+/// @brief With automatic frequency control, the spacing of the tone offsets
+/// searched, in Hz. Half a bin keeps a tone between two of them within 0.4 dB
+/// of it's power.
+constexpr uint32_t AFC_SEARCH_STEP = BIN_WIDTH / 2;
+
+/// @brief The fraction of an AX.25 packet's power in the mark and space bins,
+/// and in each of the noise bins. Measured from NRZI encoded packets, the
+/// leakage is the smallest that keeps strong signals from reading high.
+constexpr double SIGNAL_FRACTION = 0.45;
+constexpr double SIGNAL_LEAKAGE = 0.002;
+
+/// @brief The Hann window's equivalent noise bandwidth, in bins
+constexpr double WINDOW_NOISE_BANDWIDTH = 1.5;
+
+/// @brief The band the noise is measured over for the SNR, in Hz
+constexpr double NOISE_BANDWIDTH =
+    AFSK_BP_SPACE_UPPER_CUTOFF - AFSK_BP_MARK_LOWER_CUTOFF;
+
+} // namespace
+
+SnrEstimator::SnrEstimator(uint32_t sample_rate, uint32_t afc_range)
+    : block_length_(sample_rate / BIN_WIDTH), window_(block_length_) {
+  double window_sum = 0.0;
+  for (uint32_t i = 0; i < block_length_; i++) {
+    const double value = 0.5 - 0.5 * std::cos(TWO_PI_VAL * i / block_length_);
+    window_sum += value;
+    window_[i] = static_cast<float>(value);
+  }
+  // Scaled so a tone centered on a bin reads it's power, A^2 / 2
+  const auto scale = static_cast<float>(std::sqrt(2.0) / window_sum);
+  for (float &value : window_) {
+    value *= scale;
+  }
+
+  // Bins between whole ones are fine, the window takes care of the leakage
+  auto addBin = [this](double frequency) {
+    const double bin = frequency / BIN_WIDTH;
+    coefficients_.push_back(
+        static_cast<float>(2.0 * std::cos(TWO_PI_VAL * bin / block_length_)));
+  };
+  for (double frequency : NOISE_FREQUENCIES) {
+    addBin(frequency);
+  }
+  const auto steps =
+      static_cast<int32_t>((afc_range + AFC_SEARCH_STEP - 1) / AFC_SEARCH_STEP);
+  for (int32_t step = -steps; step <= steps; step++) {
+    const double offset = step * static_cast<double>(AFC_SEARCH_STEP);
+    addBin(AFSK_MARK_FREQUENCY + offset);
+    addBin(AFSK_SPACE_FREQUENCY + offset);
+  }
+
+  s1_.resize(coefficients_.size());
+  s2_.resize(coefficients_.size());
+  power_.resize(coefficients_.size());
+}
+
+void SnrEstimator::process(const int16_t *samples, size_t num_samples) {
+  const size_t num_bins = coefficients_.size();
+  const float *coefficients = coefficients_.data();
+  float *s1 = s1_.data();
+  float *s2 = s2_.data();
+
+  for (size_t n = 0; n < num_samples; n++) {
+    const float sample = samples[n];
+    energy_ += static_cast<double>(sample) * sample;
+
+    // The bins are independent lanes for the vectorizer
+    const float windowed = window_[block_position_] * sample;
+    for (size_t i = 0; i < num_bins; i++) {
+      const float s = windowed + coefficients[i] * s1[i] - s2[i];
+      s2[i] = s1[i];
+      s1[i] = s;
+    }
+
+    if (++block_position_ < block_length_) {
+      continue;
+    }
+    for (size_t i = 0; i < num_bins; i++) {
+      const double last = s1[i];
+      const double before = s2[i];
+      power_[i] +=
+          last * last + before * before - coefficients[i] * last * before;
+    }
+    std::fill(s1_.begin(), s1_.end(), 0.0F);
+    std::fill(s2_.begin(), s2_.end(), 0.0F);
+    block_position_ = 0;
+    num_blocks_++;
+  }
+  num_samples_ += num_samples;
+}
+
+void SnrEstimator::estimate(Demodulator::ProcessResults &results) {
+  results.rms = num_samples_ > 0 ? std::sqrt(energy_ / num_samples_) : 0.0;
+  results.snr = AFSK_MINIMUM_SNR;
+
+  if (num_blocks_ > 0) {
+    const double noise_bins = (power_[0] + power_[1]) / 2.0 / num_blocks_;
+    double tones = 0.0;
+    for (size_t i = NUM_NOISE_BINS_; i < power_.size(); i += 2) {
+      tones = std::max(tones, power_[i] + power_[i + 1]);
+    }
+    tones /= num_blocks_;
+
+    // The tone bins hold a bin's worth of noise on top of the signal, and
+    // the noise bins a little of the signal's skirts on top of the noise.
+    const double signal =
+        std::max(0.0, tones - 2.0 * noise_bins) /
+        (SIGNAL_FRACTION - 2.0 * SIGNAL_LEAKAGE);
+    const double noise = noise_bins - SIGNAL_LEAKAGE * signal;
+    const double band_noise =
+        noise * NOISE_BANDWIDTH / (BIN_WIDTH * WINDOW_NOISE_BANDWIDTH);
+    if (noise > 0.0) {
+      const double snr = 10.0 * std::log10(signal / band_noise);
+      if (snr >= AFSK_MINIMUM_SNR) { // also catches NaN
+        results.snr = std::min(snr, AFSK_MAXIMUM_SNR);
+      }
+    } else if (signal > 0.0) {
+      results.snr = AFSK_MAXIMUM_SNR;
+    } // else silence, which stays at the minimum
+  }
+
+  std::fill(power_.begin(), power_.end(), 0.0);
+  num_blocks_ = 0;
+  energy_ = 0.0;
+  num_samples_ = 0;
+}
+
+void SnrEstimator::reset() {
+  std::fill(s1_.begin(), s1_.end(), 0.0F);
+  std::fill(s2_.begin(), s2_.end(), 0.0F);
+  block_position_ = 0;
+  std::fill(power_.begin(), power_.end(), 0.0);
+  num_blocks_ = 0;
+  energy_ = 0.0;
+  num_samples_ = 0;
+}
+
+} // namespace signal_easel::afsk
@@ -0,0 +1,101 @@
+/**
+ * =*========SignalEasel========*=
+ * A friendly library for signal modulation and demodulation.
+ * https://github.com/joshua-jerred/Giraffe
+ * https://joshuajer.red/signal-easel
+ * =*===========================*=
+ *
+ * @file   snr_estimator.hpp
+ * @date   2026-10-19
+ * @brief  Incremental AFSK SNR and carrier detection
+ *
+ * =*=======================*=
+ * @copyright  2026 Joshua Jerred
+ * @license    GNU GPLv3
+ */
+
+#ifndef SIGNAL_EASEL_AFSK_SNR_ESTIMATOR_HPP_
+#define SIGNAL_EASEL_AFSK_SNR_ESTIMATOR_HPP_
+
+#include <cstdint>
+#include <vector>
+
+#include <SignalEasel/afsk.hpp>
+
+namespace signal_easel::afsk {
+
+/**
+ * @brief Estimates the SNR of an AFSK signal from a handful of Goertzel bins.
+ * @details The audio is cut into blocks of 10 ms, and the power of each block
+ * is measured with a Hann windowed Goertzel filter at the mark and space
+ * tones, and at two noise bins outside of the signal's band. The noise bins
+ * give the noise density, which is taken out of the tone bins to leave the
+ * signal.
+ *
+ * The SNR is the signal's power over the noise power between
+ * AFSK_BP_MARK_LOWER_CUTOFF and AFSK_BP_SPACE_UPPER_CUTOFF, in dB. The tone
+ * bins only see part of the signal's power, the part an AX.25 packet puts
+ * there, so an ASCII mode signal reads a couple dB low.
+ *
+ * With automatic frequency control the tones can be off by up to the AFC
+ * range, so pairs of tone bins are measured every half a bin across it and
+ * the pair with the most power is used.
+ *
+ * Audio can be passed in blocks of any size, a partial Goertzel block is
+ * carried into the next call.
+ */
+class SnrEstimator {
+public:
+  /**
+   * @brief Constructor
+   * @param sample_rate The sample rate of the audio, a multiple of 100 Hz
+   * @param afc_range See Settings::afc_range
+   */
+  explicit SnrEstimator(uint32_t sample_rate, uint32_t afc_range = 0);
+
+  /**
+   * @brief Add audio to the estimate.
+   * @param samples Pointer to the first sample
+   * @param num_samples The number of samples
+   */
+  void process(const int16_t *samples, size_t num_samples);
+
+  /**
+   * @brief Set the SNR and RMS of the audio since the last estimate, then
+   * start the next estimate.
+   * @param results (out) The snr and rms are set, AFSK_MINIMUM_SNR if no
+   * Goertzel block was completed.
+   */
+  void estimate(Demodulator::ProcessResults &results);
+
+  /// @brief Drop the audio since the last estimate, including any partial
+  /// block.
+  void reset();
+
+private:
+  /// @brief The two noise bins come first, then a mark and space bin for each
+  /// of the tone offsets searched
+  static constexpr size_t NUM_NOISE_BINS_ = 2;
+
+  const uint32_t block_length_;
+
+  std::vector<float> window_;
+  std::vector<float> coefficients_ = {};
+
+  /// @brief The Goertzel state of the block being measured
+  std::vector<float> s1_ = {};
+  std::vector<float> s2_ = {};
+  uint32_t block_position_ = 0;
+
+  /// @brief The power of each bin summed over the completed blocks
+  std::vector<double> power_ = {};
+  uint32_t num_blocks_ = 0;
+
+  /// @brief For the RMS, every sample since the last estimate
+  double energy_ = 0.0;
+  uint64_t num_samples_ = 0;
+};
+
+} // namespace signal_easel::afsk
+
+#endif /* SIGNAL_EASEL_AFSK_SNR_ESTIMATOR_HPP_ */
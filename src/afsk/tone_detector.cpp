@@ -0,0 +1,329 @@
+/**
+ * =*========SignalEasel========*=
+ * A friendly library for signal modulation and demodulation.
+ * https://github.com/joshua-jerred/Giraffe
+ * https://joshuajer.red/signal-easel
+ * =*===========================*=
+ *
+ * @file   tone_detector.cpp
+ * @date   2026-10-19
+ * @brief  Turns AFSK audio into the mark/space base band signal
+ *
+ * =*=======================*=
+ * @copyright  2026 Joshua Jerred
+ * @license    GNU GPLv3
+ */
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <complex>
+#include <numeric>
+
+#include "stage_timer.hpp"
+#include "tone_detector.hpp"
+
+namespace signal_easel::afsk {
+
+#if defined(SIGNAL_EASEL_DSP_FIXED_POINT)
+using DspSample = FixedSample;
+#elif defined(SIGNAL_EASEL_DSP_FLOAT)
+using DspSample = float;
+#else
+using DspSample = double;
+#endif
+
+/// @brief The frequency offset is only measured from samples where one tone
+/// has this many times the power of the other, a symbol apart
+inline constexpr double AFC_TONE_DOMINANCE = 4.0;
+
+/// @brief The most times a buffer is retuned and demodulated again
+inline constexpr size_t AFC_MAX_RETUNES = 3;
+
+/// @brief The fewest symbols of a tone a buffer's offset is measured from
+inline constexpr size_t AFC_MIN_SYMBOLS = 8;
+
+/// @brief How consistent the phase turns must be, the magnitude of their sum
+/// over the sum of their magnitudes. Every turn is over a single tone, so a
+/// real offset scores close to 1. A tone that only passes
+/// AFC_TONE_DOMINANCE on the noise of an empty buffer turns at random, and
+/// scores near 0 over the thousands of turns in a buffer.
+inline constexpr double AFC_MIN_COHERENCE = 0.5;
+
+/**
+ * @brief Builds a table holding a whole number of periods of a local
+ * oscillator.
+ */
+template <typename Coefficient>
+static std::vector<Coefficient>
+makeOscillatorTable(uint32_t frequency, uint32_t sample_rate, bool cosine,
+                    Coefficient (*convert)(double)) {
+  const size_t length = sample_rate / std::gcd(sample_rate, frequency);
+  std::vector<Coefficient> table(length);
+  for (size_t i = 0; i < length; i++) {
+    const double angle = TWO_PI_VAL * static_cast<double>(i) * frequency /
+                         static_cast<double>(sample_rate);
+    table[i] = convert(cosine ? std::cos(angle) : std::sin(angle));
+  }
+  return table;
+}
+
+/**
+ * @brief Multiplies the input by a repeating oscillator table. The inner loop
+ * is a plain element-wise product, which the compiler can vectorize.
+ */
+template <typename T, typename Coefficient>
+static void mixWithTable(const std::vector<T> &input,
+                         const std::vector<Coefficient> &table,
+                         std::vector<T> &output) {
+  using Traits = SampleTraits<T>;
+  output.resize(input.size());
+  const size_t table_length = table.size();
+  for (size_t start = 0; start < input.size(); start += table_length) {
+    const size_t count = std::min(table_length, input.size() - start);
+    const T *in = input.data() + start;
+    T *out = output.data() + start;
+    for (size_t i = 0; i < count; i++) {
+      out[i] = Traits::fromAccumulator(Traits::multiply(table[i], in[i]));
+    }
+  }
+}
+
+std::unique_ptr<ToneDetector>
+ToneDetector::create(uint32_t sample_rate, Settings::DemodulationEngine engine,
+                     uint32_t afc_range) {
+  return std::make_unique<BasicToneDetector<DspSample>>(sample_rate, engine,
+                                                        afc_range);
+}
+
+template <typename T>
+BasicToneDetector<T>::BasicToneDetector(uint32_t sample_rate,
+                                        Settings::DemodulationEngine engine,
+                                        uint32_t afc_range)
+    : engine_(engine), sample_rate_(sample_rate),
+      window_(sample_rate / AFSK_MARK_FREQUENCY),
+      leak_shift_(std::max(
+          1, static_cast<int>(std::lround(std::log2(window_ / 2.0))))),
+      afc_range_(static_cast<int32_t>(afc_range)),
+      signal_filter_(designButterworthBandPass(
+          sample_rate, AFSK_BP_MARK_LOWER_CUTOFF, AFSK_BP_SPACE_UPPER_CUTOFF,
+          AFSK_BP_FILTER_ORDER)),
+      snr_estimator_(sample_rate, afc_range) {
+  tune(0);
+}
+
+template <typename T> void BasicToneDetector<T>::tune(int32_t offset) {
+  tuned_offset_ = offset;
+  const auto mark = static_cast<uint32_t>(
+      static_cast<int32_t>(AFSK_MARK_FREQUENCY) + offset);
+  const auto space = static_cast<uint32_t>(
+      static_cast<int32_t>(AFSK_SPACE_FREQUENCY) + offset);
+  mark_sin_ =
+      makeOscillatorTable(mark, sample_rate_, false, &Traits::coefficient);
+  mark_cos_ =
+      makeOscillatorTable(mark, sample_rate_, true, &Traits::coefficient);
+  space_sin_ =
+      makeOscillatorTable(space, sample_rate_, false, &Traits::coefficient);
+  space_cos_ =
+      makeOscillatorTable(space, sample_rate_, true, &Traits::coefficient);
+}
+
+template <typename T>
+void BasicToneDetector<T>::process(const std::vector<int16_t> &audio,
+                                   std::vector<uint8_t> &base_band,
+                                   Demodulator::ProcessResults &results) {
+  {
+    StageTimer timer(results.filter_time);
+    input_.resize(audio.size());
+    std::transform(audio.begin(), audio.end(), input_.begin(),
+                   &Traits::fromPcm);
+
+    signal_filter_.process(input_, filtered_);
+
+    // Each buffer is measured on it's own
+    snr_estimator_.reset();
+    snr_estimator_.process(audio.data(), audio.size());
+    snr_estimator_.estimate(results);
+  }
+
+  StageTimer timer(results.correlator_time);
+  mixDown();
+  detect(base_band);
+
+  // Retuning redoes this buffer, so a packet is caught in the same pass the
+  // offset is found in. The measurement reads low further from the tuning,
+  // so it is repeated from the new tuning a few times.
+  double offset = 0.0;
+  for (size_t retunes = 0;
+       retunes < AFC_MAX_RETUNES && afc_range_ > 0 &&
+       results.snr > AFSK_SNR_THRESHOLD && measureFrequencyOffset(offset);
+       retunes++) {
+    frequency_offset_ =
+        std::clamp(tuned_offset_ + offset, static_cast<double>(-afc_range_),
+                   static_cast<double>(afc_range_));
+    const auto step = static_cast<int32_t>(AFSK_AFC_STEP);
+    const auto tuning =
+        static_cast<int32_t>(std::lround(frequency_offset_ / step)) * step;
+    if (tuning == tuned_offset_) {
+      break;
+    }
+    tune(tuning);
+    mixDown();
+    detect(base_band);
+  }
+  results.frequency_offset = frequency_offset_;
+}
+
+template <typename T>
+void BasicToneDetector<T>::detect(std::vector<uint8_t> &base_band) {
+  if (engine_ == Settings::DemodulationEngine::QUADRATURE_MIXER) {
+    lowPass(base_band);
+  } else {
+    correlate(base_band);
+  }
+}
+
+template <typename T>
+bool BasicToneDetector<T>::measureFrequencyOffset(double &offset) const {
+  // A tone off from it's oscillator leaves the mixer output (low-passed over
+  // a symbol) turning at the offset. The turn over a symbol is measured
+  // wherever the same tone was received a symbol earlier, and averaged.
+  const size_t lag = window_;
+  const size_t num_samples = filtered_.size();
+  if (num_samples < 2 * lag) {
+    return false;
+  }
+
+  auto toDouble = [](T sample) {
+    return Traits::sumToDouble(Traits::toSum(sample));
+  };
+  std::vector<std::complex<double>> previous_mark(lag);
+  std::vector<std::complex<double>> previous_space(lag);
+  double mark_i = 0.0;
+  double mark_q = 0.0;
+  double space_i = 0.0;
+  double space_q = 0.0;
+  std::complex<double> turn{};
+  double total = 0.0;
+  size_t count = 0;
+  for (size_t i = 0; i < num_samples; i++) {
+    mark_i += toDouble(mark_i_[i]);
+    mark_q += toDouble(mark_q_[i]);
+    space_i += toDouble(space_i_[i]);
+    space_q += toDouble(space_q_[i]);
+    if (i >= lag) {
+      mark_i -= toDouble(mark_i_[i - lag]);
+      mark_q -= toDouble(mark_q_[i - lag]);
+      space_i -= toDouble(space_i_[i - lag]);
+      space_q -= toDouble(space_q_[i - lag]);
+    }
+
+    // x cos(wt) - j x sin(wt), turning at the tone minus the oscillator
+    const std::complex<double> mark(mark_q, -mark_i);
+    const std::complex<double> space(space_q, -space_i);
+    std::complex<double> &mark_before = previous_mark[i % lag];
+    std::complex<double> &space_before = previous_space[i % lag];
+    if (i + 1 >= 2 * lag) {
+      std::complex<double> step{};
+      if (std::norm(mark) > AFC_TONE_DOMINANCE * std::norm(space) &&
+          std::norm(mark_before) >
+              AFC_TONE_DOMINANCE * std::norm(space_before)) {
+        step = mark * std::conj(mark_before);
+      } else if (std::norm(space) > AFC_TONE_DOMINANCE * std::norm(mark) &&
+                 std::norm(space_before) >
+                     AFC_TONE_DOMINANCE * std::norm(mark_before)) {
+        step = space * std::conj(space_before);
+      }
+      if (step != std::complex<double>{}) {
+        turn += step;
+        total += std::abs(step);
+        count++;
+      }
+    }
+    mark_before = mark;
+    space_before = space;
+  }
+
+  if (count < AFC_MIN_SYMBOLS * lag ||
+      std::abs(turn) < AFC_MIN_COHERENCE * total) {
+    return false;
+  }
+  offset = std::arg(turn) * sample_rate_ / (TWO_PI_VAL * lag);
+  return true;
+}
+
+template <typename T>
+std::vector<double> BasicToneDetector<T>::getFilteredSignal() const {
+  std::vector<double> output;
+  output.reserve(filtered_.size());
+  for (T sample : filtered_) {
+    output.push_back(Traits::sumToDouble(Traits::toSum(sample)));
+  }
+  return output;
+}
+
+template <typename T> void BasicToneDetector<T>::mixDown() {
+  mixWithTable(filtered_, mark_sin_, mark_i_);
+  mixWithTable(filtered_, mark_cos_, mark_q_);
+  mixWithTable(filtered_, space_sin_, space_i_);
+  mixWithTable(filtered_, space_cos_, space_q_);
+}
+
+template <typename T>
+void BasicToneDetector<T>::correlate(std::vector<uint8_t> &base_band) {
+  const size_t num_samples = filtered_.size();
+  base_band.resize(num_samples);
+
+  for (size_t i = 0; i < num_samples; i++) {
+    Sum mark_i = 0;
+    Sum mark_q = 0;
+    Sum space_i = 0;
+    Sum space_q = 0;
+
+    const size_t first = i + 1 >= window_ ? i + 1 - window_ : 0;
+    for (size_t j = first; j <= i; j++) {
+      mark_i += Traits::toSum(mark_i_[j]);
+      mark_q += Traits::toSum(mark_q_[j]);
+      space_i += Traits::toSum(space_i_[j]);
+      space_q += Traits::toSum(space_q_[j]);
+    }
+
+    base_band[i] = Traits::power(mark_i, mark_q) >
+                           Traits::power(space_i, space_q)
+                       ? 0xff
+                       : 0x00;
+  }
+}
+
+template <typename T>
+void BasicToneDetector<T>::lowPass(std::vector<uint8_t> &base_band) {
+  const size_t num_samples = filtered_.size();
+  base_band.resize(num_samples);
+
+  // Two leaky integrators per arm, s += (x - s) / 2^n, with a time constant
+  // of about half a symbol each. Unlike the correlator's boxcar nothing but
+  // the current mixer output is read, at the cost of letting more noise and
+  // the last symbol through.
+  const std::array<const std::vector<T> *, 4> arms = {&mark_i_, &mark_q_,
+                                                      &space_i_, &space_q_};
+  std::array<Sum, 4> first{};
+  std::array<Sum, 4> second{};
+  for (size_t i = 0; i < num_samples; i++) {
+    for (size_t arm = 0; arm < arms.size(); arm++) {
+      first[arm] += Traits::shiftDown(
+          Traits::toSum((*arms[arm])[i]) - first[arm], leak_shift_);
+      second[arm] += Traits::shiftDown(first[arm] - second[arm], leak_shift_);
+    }
+
+    base_band[i] = Traits::power(second[0], second[1]) >
+                           Traits::power(second[2], second[3])
+                       ? 0xff
+                       : 0x00;
+  }
+}
+
+template class BasicToneDetector<double>;
+template class BasicToneDetector<float>;
+template class BasicToneDetector<FixedSample>;
+
+} // namespace signal_easel::afsk
@@ -0,0 +1,146 @@
+/**
+ * =*========SignalEasel========*=
+ * A friendly library for signal modulation and demodulation.
+ * https://github.com/joshua-jerred/Giraffe
+ * https://joshuajer.red/signal-easel
+ * =*===========================*=
+ *
+ * @file   tone_detector.hpp
+ * @date   2026-10-19
+ * @brief  Turns AFSK audio into the mark/space base band signal
+ *
+ * =*=======================*=
+ * @copyright  2026 Joshua Jerred
+ * @license    GNU GPLv3
+ */
+
+#ifndef SIGNAL_EASEL_AFSK_TONE_DETECTOR_HPP_
+#define SIGNAL_EASEL_AFSK_TONE_DETECTOR_HPP_
+
+#include <memory>
+#include <vector>
+
+#include <SignalEasel/afsk.hpp>
+
+#include "biquad_filter.hpp"
+#include "sample_traits.hpp"
+#include "snr_estimator.hpp"
+
+namespace signal_easel::afsk {
+
+/**
+ * @brief The filter, SNR and tone detection stages of the AFSK demodulator.
+ * @details The sample type the stages run on is picked at compile time with
+ * the SIGNALEASEL_DSP_SAMPLE_TYPE CMake option (double, float or fixed), see
+ * create().
+ */
+class ToneDetector {
+public:
+  virtual ~ToneDetector() = default;
+
+  /**
+   * @brief Converts a buffer of audio into the base band signal.
+   * @param audio The audio, at the demodulation sample rate
+   * @param base_band (out) 0xff for mark, 0x00 for space, one per sample
+   * @param results (out) The RMS, SNR and frequency offset of the buffer
+   */
+  virtual void process(const std::vector<int16_t> &audio,
+                       std::vector<uint8_t> &base_band,
+                       Demodulator::ProcessResults &results) = 0;
+
+  /**
+   * @brief Creates a tone detector using the sample type the library was
+   * built with.
+   * @param sample_rate The demodulation sample rate
+   * @param engine The tone detection engine
+   * @param afc_range See Settings::afc_range
+   */
+  static std::unique_ptr<ToneDetector>
+  create(uint32_t sample_rate, Settings::DemodulationEngine engine,
+         uint32_t afc_range = 0);
+};
+
+/**
+ * @brief The tone detector for a specific sample type (double, float or
+ * FixedSample).
+ */
+template <typename T> class BasicToneDetector : public ToneDetector {
+public:
+  BasicToneDetector(uint32_t sample_rate, Settings::DemodulationEngine engine,
+                    uint32_t afc_range = 0);
+
+  void process(const std::vector<int16_t> &audio,
+               std::vector<uint8_t> &base_band,
+               Demodulator::ProcessResults &results) override;
+
+  /// @brief The band-pass filtered signal from the last call to process(),
+  /// normalized to -1.0 to 1.0. For the parity tests.
+  std::vector<double> getFilteredSignal() const;
+
+private:
+  using Traits = SampleTraits<T>;
+  using Coefficient = typename Traits::Coefficient;
+  using Sum = typename Traits::Sum;
+
+  /// @brief Build the oscillator tables for the tones moved by offset Hz
+  void tune(int32_t offset);
+
+  /// @brief Mixes filtered_ down with each of the oscillator tables
+  void mixDown();
+
+  /// @brief Runs the engine over the mixer outputs
+  void detect(std::vector<uint8_t> &base_band);
+
+  /**
+   * @brief Measures how far the tones are from the ones the tables are tuned
+   * to, from the mixer outputs.
+   * @param offset (out) The offset in Hz
+   * @return false if there was too little of a tone in the buffer to tell
+   */
+  bool measureFrequencyOffset(double &offset) const;
+
+  /// @brief Settings::DemodulationEngine::CORRELATOR
+  void correlate(std::vector<uint8_t> &base_band);
+
+  /// @brief Settings::DemodulationEngine::QUADRATURE_MIXER
+  void lowPass(std::vector<uint8_t> &base_band);
+
+  Settings::DemodulationEngine engine_;
+  uint32_t sample_rate_;
+  /// @brief One symbol, the length of the correlator window
+  size_t window_;
+  /// @brief The low-pass time constant, 2^leak_shift_ samples, the power of
+  /// two closest to a symbol
+  int leak_shift_;
+
+  /// @brief See Settings::afc_range
+  int32_t afc_range_;
+  /// @brief The offset the oscillator tables are tuned to, a multiple of
+  /// AFSK_AFC_STEP, and the last offset measured, in Hz
+  int32_t tuned_offset_ = 0;
+  double frequency_offset_ = 0.0;
+
+  BiquadFilter<T> signal_filter_;
+  SnrEstimator snr_estimator_;
+
+  /// @brief Whole periods of each tone's local oscillator
+  std::vector<Coefficient> mark_sin_ = {};
+  std::vector<Coefficient> mark_cos_ = {};
+  std::vector<Coefficient> space_sin_ = {};
+  std::vector<Coefficient> space_cos_ = {};
+
+  std::vector<T> input_ = {};
+  std::vector<T> filtered_ = {};
+  std::vector<T> mark_i_ = {};
+  std::vector<T> mark_q_ = {};
+  std::vector<T> space_i_ = {};
+  std::vector<T> space_q_ = {};
+};
+
+extern template class BasicToneDetector<double>;
+extern template class BasicToneDetector<float>;
+extern template class BasicToneDetector<FixedSample>;
+
+} // namespace signal_easel::afsk
+
+#endif /* SIGNAL_EASEL_AFSK_TONE_DETECTOR_HPP_ */
@@ -14,8 +14,8 @@
  * @license    GNU GPLv3
  */
 
-#include <cmath>
 #include <stdexcept>
+#include <utility>
 #include <vector>
 
 #include <SignalEasel/aprs.hpp>
@@ -24,25 +24,23 @@
 namespace signal_easel::aprs {
 
 std::vector<uint8_t> base91Encode(int value, unsigned int num_bytes) {
-  std::vector<uint8_t> encoded;
-
-  for (int i = num_bytes - 1; i > -1; i--) {
-    char c = value / (int)(std::pow(91, i));
-    value = value % (int)(std::pow(91, i));
-    encoded.push_back(c + 33);
-  }
-
-  if (encoded.size() != num_bytes) {
+  if (value < 0 || num_bytes == 0 || num_bytes > BASE91_MAX_WIDTH ||
+      static_cast<uint32_t>(value) >= BASE91_POWERS.at(num_bytes)) {
     throw Exception(Exception::Id::BASE_91_ENCODE_VALUE_NOT_CORRECT_SIZE);
   }
 
+  std::vector<uint8_t> encoded(num_bytes);
+  for (size_t i = num_bytes; i > 0; i--) {
+    encoded[i - 1] = static_cast<uint8_t>(value % 91 + BASE91_OFFSET);
+    value /= 91;
+  }
   return encoded;
 }
 
-int base91Decode(std::vector<uint8_t> encoded) {
+int base91Decode(const std::vector<uint8_t> &encoded) {
   int value = 0;
-  for (size_t i = 0; i < encoded.size(); i++) {
-    value += (encoded.at(i) - 33) * (int)(std::pow(91, encoded.size() - i - 1));
+  for (uint8_t character : encoded) {
+    value = value * 91 + (character - BASE91_OFFSET);
   }
   return value;
 }
@@ -140,4 +138,12 @@ std::vector<uint8_t> encodePacket(const aprs::Packet &required_fields,
   return vec;
 }
 
+ax25::Frame buildPacketFrame(const aprs::Packet &required_fields,
+                             std::vector<uint8_t> info) {
+  ax25::Frame frame;
+  AddRequiredFields(required_fields, frame);
+  frame.setInformation(std::move(info));
+  return frame;
+}
+
 } // namespace signal_easel::aprs
\ No newline at end of file
@@ -6,7 +6,8 @@
  * @copyright Copyright (c) 2024
  */
 
-#include <cmath>
+#include <algorithm>
+#include <string_view>
 
 #include <SignalEasel/aprs.hpp>
 
@@ -17,28 +18,31 @@ void Demodulator::printFrame() {
 }
 
 static aprs::Packet::Type classifyFrameType(const ax25::Frame &frame) {
-  auto info = frame.getInformation();
+  const auto &info = frame.getInformationRef();
   if (info.empty()) {
     return aprs::Packet::Type::UNKNOWN;
   }
 
   uint8_t first_byte = info.at(0);
-  switch (first_byte) {
-  case '@':
-  case '/':
+  if (isPositionDataType(static_cast<char>(first_byte))) {
     return aprs::Packet::Type::POSITION;
+  }
+
+  switch (first_byte) {
   case ':': {
     // Telemetry messages that describe the telemetry data report are in the
     // APRS message format. Ex: ":NOCALL-1 :BITS.xxx"
     if (info.size() > 15 && info.at(15) == '.') {
-      std::string message_type(info.begin() + 11, info.begin() + 15);
-      if (message_type == "PARM") {
+      auto message_type_is = [&info](const char *type) {
+        return std::equal(info.begin() + 11, info.begin() + 15, type);
+      };
+      if (message_type_is("PARM")) {
         return aprs::Packet::Type::TELEMETRY_PARAMETER_NAME;
-      } else if (message_type == "UNIT") {
+      } else if (message_type_is("UNIT")) {
         return aprs::Packet::Type::TELEMETRY_PARAMETER_UNIT;
-      } else if (message_type == "EQNS") {
+      } else if (message_type_is("EQNS")) {
         return aprs::Packet::Type::TELEMETRY_COEFFICIENT;
-      } else if (message_type == "BITS") {
+      } else if (message_type_is("BITS")) {
         return aprs::Packet::Type::TELEMETRY_BIT_SENSE_PROJ_NAME;
       }
     }
@@ -70,18 +74,18 @@ bool Demodulator::lookForAx25Packet() {
 }
 
 bool Demodulator::lookForNextAx25Packet(BitStream &nrzi_decoded_stream) {
-  ax25::Frame frame;
-  if (!frame.parseNrziDecodedBitStream(nrzi_decoded_stream)) {
+  if (!candidate_frame_.parseNrziDecodedBitStream(nrzi_decoded_stream,
+                                                  frame_buffer_)) {
     type_ = aprs::Packet::Type::UNKNOWN;
     return false;
   }
 
-  type_ = classifyFrameType(frame);
+  type_ = classifyFrameType(candidate_frame_);
   if (type_ == aprs::Packet::Type::UNKNOWN) {
     return false;
   }
 
-  frame_ = frame;
+  std::swap(frame_, candidate_frame_);
   return true;
 }
 
@@ -91,9 +95,9 @@ bool Demodulator::parseMessagePacket(aprs::MessagePacket &message_packet) {
   }
   populateGenericFields(message_packet);
 
-  auto info = frame_.getInformation();
+  const auto &info = frame_.getInformationRef();
 
-  constexpr size_t k_min_message_length = 10;
+  constexpr size_t k_min_message_length = 11;
 
   if (info.size() < k_min_message_length) {
     return false;
@@ -104,16 +108,15 @@ bool Demodulator::parseMessagePacket(aprs::MessagePacket &message_packet) {
     return false;
   }
 
-  message_packet.addressee = std::string(info.begin() + 1, info.begin() + 10);
+  message_packet.addressee.assign(info.begin() + 1, info.begin() + 10);
 
-  std::string content(info.begin() + 11, info.end());
-  size_t message_end = content.find('{');
-  if (message_end == std::string::npos) {
+  const auto message_end = std::find(info.begin() + 11, info.end(), '{');
+  if (message_end == info.end()) {
     return false;
   }
-  message_packet.message = content.substr(0, message_end);
-  if (message_end + 1 < content.length()) {
-    message_packet.message_id = content.substr(message_end + 1);
+  message_packet.message.assign(info.begin() + 11, message_end);
+  if (message_end + 1 < info.end()) {
+    message_packet.message_id.assign(message_end + 1, info.end());
   }
 
   return true;
@@ -125,70 +128,18 @@ bool Demodulator::parsePositionPacket(aprs::PositionPacket &position) {
   }
   populateGenericFields(position);
 
-  auto info_vec = frame_.getInformation();
-  std::string info(info_vec.begin(), info_vec.end());
-
-  if (info.length() < 27) {
-    return false;
-  }
-
-  // leading '@' or '/'
-  if (info.at(0) != '@' && info.at(0) != '/') {
-    return false;
-  }
-
-  // time code
-  position.time_code = info.substr(1, 6); // ddhhmmz, ignore the z
-
-  // Symbol Table ID
-  if (info.at(8) == '/') {
-    position.symbol_table = aprs::Packet::SymbolTable::PRIMARY;
-  } else if (info.at(8) == '\\') {
-    position.symbol_table = aprs::Packet::SymbolTable::SECONDARY;
-  } else {
-    return false;
-  }
-
-  // Latitude
-  std::string lat_str = info.substr(9, 4);
-  int lat = base91Decode(std::vector<uint8_t>(lat_str.begin(), lat_str.end()));
-  position.latitude = 90 - ((float)lat / 380926);
-
-  // Longitude
-  std::string lon_str = info.substr(13, 4);
-  int lon = base91Decode(std::vector<uint8_t>(lon_str.begin(), lon_str.end()));
-  position.longitude = ((float)lon / 190463) - 180;
-
-  // Symbol
-  position.symbol = info.at(17);
-
-  // Course
-  position.course = (info.at(18) - 33) * 4;
-
-  // Speed
-  const double speed_divisor = 0.076961;
-  position.speed = std::exp((info.at(19) - 33) * speed_divisor) - 1;
-
-  // Compression Type
-  if (info.at(20) < 33) {
-    return false;
-  }
-
-  // Altitude
-  std::string alt_prefix = info.substr(21, 2);
-  if (alt_prefix != "/A") {
-    return false;
-  }
-
-  std::string alt_str = info.substr(24, 6);
-  position.altitude = std::stoi(alt_str);
+  const auto &info_vec = frame_.getInformationRef();
+  const std::string_view info(reinterpret_cast<const char *>(info_vec.data()),
+                              info_vec.size());
 
-  // Comment
-  if (info.length() > 30) {
-    position.comment = info.substr(29);
+  if (info.at(0) == '`' || info.at(0) == '\'' || info.at(0) == 0x1c ||
+      info.at(0) == 0x1d) {
+    // Six characters, fits in the small string buffer
+    const std::string destination =
+        frame_.getDestinationAddress().getAddressString();
+    return parseMicEInformation(destination, info, position);
   }
-
-  return true;
+  return parsePositionInformation(info, position);
 }
 
 bool Demodulator::parseExperimentalPacket(
@@ -200,7 +151,7 @@ bool Demodulator::parseExperimentalPacket(
 
   populateGenericFields(experimental);
 
-  auto info = frame_.getInformation();
+  const auto &info = frame_.getInformationRef();
   if (info.size() < 3) {
     return false;
   }
@@ -212,11 +163,7 @@ bool Demodulator::parseExperimentalPacket(
 
   experimental.packet_type_char = info.at(2);
 
-  if (info.size() < 4) {
-    experimental.data = std::vector<uint8_t>();
-    return true;
-  }
-  experimental.data = std::vector<uint8_t>(info.begin() + 3, info.end());
+  experimental.data.assign(info.begin() + 3, info.end());
   return true;
 }
 
@@ -34,18 +34,23 @@ std::vector<uint8_t> PositionPacket::encode() const {
     info.push_back('\\');
   }
 
+  // Out of range (or NaN) coordinates would not fit in the base-91 fields
+  if (!std::isfinite(latitude) || !std::isfinite(longitude) ||
+      latitude < -90 || latitude > 90 || longitude < -180 || longitude > 180) {
+    throw Exception(Exception::Id::APRS_INVALID_LOCATION_DATA);
+  }
+
   // Latitude
-  int uncompressed_lat = (int)(380926 * (90 - latitude));
-  std::vector<uint8_t> compressed_lat = base91Encode(uncompressed_lat, 4);
-  for (int i = 0; i < 4; i++) {
-    info.push_back(compressed_lat[i]); // YYYY
+  const auto uncompressed_lat = static_cast<uint32_t>(380926 * (90 - latitude));
+  for (uint8_t c : base91EncodeFixed<4>(uncompressed_lat)) {
+    info.push_back(c); // YYYY
   }
 
   // Longitude
-  int uncompressed_lon = (int)(190463 * (180 + longitude));
-  std::vector<uint8_t> compressed_lon = base91Encode(uncompressed_lon, 4);
-  for (int i = 0; i < 4; i++) {
-    info.push_back(compressed_lon[i]); // XXXX
+  const auto uncompressed_lon =
+      static_cast<uint32_t>(190463 * (180 + longitude));
+  for (uint8_t c : base91EncodeFixed<4>(uncompressed_lon)) {
+    info.push_back(c); // XXXX
   }
 
   // Symbol
@@ -6,7 +6,12 @@
  * @copyright Copyright (c) 2024
  */
 
+#include <algorithm>
+#include <exception>
+#include <thread>
+
 #include <SignalEasel/aprs.hpp>
+#include <SignalEasel/exception.hpp>
 
 namespace signal_easel::aprs {
 
@@ -43,4 +48,92 @@ void Modulator::encode(const aprs::TelemetryPacket &packet) {
   afsk::Modulator::encodeBytes(output_bytes);
 }
 
+void Modulator::encodeFrames(std::vector<ax25::Frame> &frames,
+                             const BatchSettings &batch_settings) {
+  if (frames.empty()) {
+    throw Exception(Exception::Id::NO_DATA_TO_WRITE);
+  }
+
+  constexpr size_t SAMPLES_PER_BYTE = 8 * afsk::AFSK_SAMPLES_PER_SYMBOL;
+
+  if (batch_settings.separation == BatchSettings::Separation::FLAG_FILL) {
+    std::vector<uint8_t> burst;
+    ax25::encodeFrames(frames, batch_settings.fill_flags, burst);
+    audio_buffer_.reserve(audio_buffer_.size() +
+                          burst.size() * SAMPLES_PER_BYTE);
+    afsk::Modulator::encodeBytes(burst);
+    return;
+  }
+
+  std::vector<std::vector<uint8_t>> encoded_frames(frames.size());
+  size_t num_samples = (frames.size() - 1) * batch_settings.silence_samples;
+  for (size_t i = 0; i < frames.size(); i++) {
+    frames[i].encodeFrame(encoded_frames[i]);
+    num_samples += encoded_frames[i].size() * SAMPLES_PER_BYTE;
+  }
+  audio_buffer_.reserve(audio_buffer_.size() + num_samples);
+
+  const size_t num_threads = std::clamp<size_t>(batch_settings.threads, 1,
+                                                encoded_frames.size());
+  if (num_threads == 1) {
+    for (size_t i = 0; i < encoded_frames.size(); i++) {
+      if (i > 0) {
+        addSilence(batch_settings.silence_samples);
+      }
+      encodeTransmission(encoded_frames[i]);
+    }
+    return;
+  }
+
+  // Each thread renders a contiguous run of the frames with it's own
+  // modulator, then the runs are joined in order.
+  std::vector<Modulator> workers(num_threads, Modulator(settings_));
+  std::vector<std::exception_ptr> errors(num_threads);
+  std::vector<std::thread> threads;
+  threads.reserve(num_threads);
+  for (size_t worker = 0; worker < num_threads; worker++) {
+    const size_t first = encoded_frames.size() * worker / num_threads;
+    const size_t last = encoded_frames.size() * (worker + 1) / num_threads;
+    workers[worker].useAudioCache(getAudioCache());
+    threads.emplace_back([&, worker, first, last]() {
+      try {
+        size_t worker_samples =
+            (last - first - 1) * batch_settings.silence_samples;
+        for (size_t i = first; i < last; i++) {
+          worker_samples += encoded_frames[i].size() * SAMPLES_PER_BYTE;
+        }
+        workers[worker].audio_buffer_.reserve(worker_samples);
+
+        for (size_t i = first; i < last; i++) {
+          if (i > first) {
+            workers[worker].addSilence(batch_settings.silence_samples);
+          }
+          workers[worker].encodeTransmission(encoded_frames[i]);
+        }
+      } catch (...) {
+        errors[worker] = std::current_exception();
+      }
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+
+  for (size_t worker = 0; worker < num_threads; worker++) {
+    if (errors[worker]) {
+      std::rethrow_exception(errors[worker]);
+    }
+    if (worker > 0) {
+      addSilence(batch_settings.silence_samples);
+    }
+    const auto &audio = workers[worker].getAudioBuffer();
+    audio_buffer_.insert(audio_buffer_.end(), audio.begin(), audio.end());
+  }
+}
+
+void Modulator::encodeTransmission(const std::vector<uint8_t> &encoded_frame) {
+  resetPhase();
+  afsk::Modulator::encodeBytes(encoded_frame);
+}
+
 } // namespace signal_easel::aprs
\ No newline at end of file
@@ -20,15 +20,45 @@
 #include <iomanip>
 #include <iostream>
 
+#include "stage_timer.hpp"
+
 namespace signal_easel::aprs {
 
+namespace {
+/// @brief The number of packets that may wait in each queue
+constexpr size_t MAX_FRAMES = 10;
+
+/**
+ * @brief Drops the oldest packets from a queue holding more than MAX_FRAMES.
+ * @return The number of packets dropped
+ */
+template <typename Packet> size_t dropOldest(std::vector<Packet> &queue) {
+  if (queue.size() <= MAX_FRAMES) {
+    return 0;
+  }
+  const auto excess = static_cast<std::ptrdiff_t>(queue.size() - MAX_FRAMES);
+  queue.erase(queue.begin(), queue.begin() + excess);
+  return static_cast<size_t>(excess);
+}
+} // namespace
+
+Receiver::Receiver(aprs::Settings settings) : afsk::Receiver(settings) {
+  // The queues keep their capacity as packets are taken out, so once they
+  // are reserved a decode pass only allocates for the packets it keeps.
+  aprs_messages_.reserve(MAX_FRAMES + 1);
+  aprs_positions_.reserve(MAX_FRAMES + 1);
+  aprs_experimental_.reserve(MAX_FRAMES + 1);
+  aprs_telemetry_.reserve(MAX_FRAMES + 1);
+  other_aprs_packets_.reserve(MAX_FRAMES + 1);
+}
+
 bool Receiver::getAprsMessage(aprs::MessagePacket &message_packet,
                               ax25::Frame &frame) {
   if (aprs_messages_.empty()) {
     return false;
   }
-  frame = aprs_messages_.back().first;
-  message_packet = aprs_messages_.back().second;
+  frame = std::move(aprs_messages_.back().first);
+  message_packet = std::move(aprs_messages_.back().second);
   aprs_messages_.pop_back();
   return true;
 }
@@ -38,8 +68,8 @@ bool Receiver::getAprsPosition(aprs::PositionPacket &position_packet,
   if (aprs_positions_.empty()) {
     return false;
   }
-  frame = aprs_positions_.back().first;
-  position_packet = aprs_positions_.back().second;
+  frame = std::move(aprs_positions_.back().first);
+  position_packet = std::move(aprs_positions_.back().second);
   aprs_positions_.pop_back();
   return true;
 }
@@ -49,8 +79,8 @@ bool Receiver::getAprsExperimental(
   if (aprs_experimental_.empty()) {
     return false;
   }
-  frame = aprs_experimental_.back().first;
-  experimental_packet = aprs_experimental_.back().second;
+  frame = std::move(aprs_experimental_.back().first);
+  experimental_packet = std::move(aprs_experimental_.back().second);
   aprs_experimental_.pop_back();
   return true;
 }
@@ -60,8 +90,8 @@ bool Receiver::getAprsTelemetry(aprs::TelemetryPacket &telemetry_packet,
   if (aprs_telemetry_.empty()) {
     return false;
   }
-  frame = aprs_telemetry_.back().first;
-  telemetry_packet = aprs_telemetry_.back().second;
+  frame = std::move(aprs_telemetry_.back().first);
+  telemetry_packet = std::move(aprs_telemetry_.back().second);
   aprs_telemetry_.pop_back();
   return true;
 }
@@ -70,7 +100,7 @@ bool Receiver::getOtherAprsPacket(ax25::Frame &frame) {
   if (other_aprs_packets_.empty()) {
     return false;
   }
-  frame = other_aprs_packets_.back();
+  frame = std::move(other_aprs_packets_.back());
   other_aprs_packets_.pop_back();
   return true;
 }
@@ -82,11 +112,13 @@ void Receiver::processDecodedFrame() {
   case aprs::Packet::Type::MESSAGE: {
     aprs::MessagePacket message_packet;
     if (aprs_demodulator_.parseMessagePacket(message_packet)) {
-      aprs_messages_.emplace_back(aprs_demodulator_.frame_, message_packet);
+      aprs_messages_.emplace_back(std::move(aprs_demodulator_.frame_),
+                                  std::move(message_packet));
+      recordPacketDelivered();
       stats_.total_message_packets++;
     } else {
       stats_.num_message_packets_failed++;
-      other_aprs_packets_.push_back(aprs_demodulator_.frame_);
+      other_aprs_packets_.push_back(std::move(aprs_demodulator_.frame_));
       stats_.total_other_packets++;
     }
     break;
@@ -95,11 +127,13 @@ void Receiver::processDecodedFrame() {
     aprs::PositionPacket position_packet;
     if (aprs_demodulator_.parsePositionPacket(position_packet)) {
       position_packet.decoded_timestamp.setToNow();
-      aprs_positions_.emplace_back(aprs_demodulator_.frame_, position_packet);
+      aprs_positions_.emplace_back(std::move(aprs_demodulator_.frame_),
+                                   std::move(position_packet));
+      recordPacketDelivered();
       stats_.total_position_packets++;
     } else {
       stats_.num_position_packets_failed++;
-      other_aprs_packets_.push_back(aprs_demodulator_.frame_);
+      other_aprs_packets_.push_back(std::move(aprs_demodulator_.frame_));
       stats_.total_other_packets++;
     }
     break;
@@ -107,12 +141,13 @@ void Receiver::processDecodedFrame() {
   case aprs::Packet::Type::EXPERIMENTAL: {
     aprs::ExperimentalPacket experimental_packet;
     if (aprs_demodulator_.parseExperimentalPacket(experimental_packet)) {
-      aprs_experimental_.emplace_back(aprs_demodulator_.frame_,
-                                      experimental_packet);
+      aprs_experimental_.emplace_back(std::move(aprs_demodulator_.frame_),
+                                      std::move(experimental_packet));
+      recordPacketDelivered();
       stats_.total_experimental_packets++;
     } else {
       stats_.num_experimental_packets_failed++;
-      other_aprs_packets_.push_back(aprs_demodulator_.frame_);
+      other_aprs_packets_.push_back(std::move(aprs_demodulator_.frame_));
       stats_.total_other_packets++;
     }
     break;
@@ -124,17 +159,19 @@ void Receiver::processDecodedFrame() {
   case aprs::Packet::Type::TELEMETRY_BIT_SENSE_PROJ_NAME: {
     aprs::TelemetryPacket telemetry_packet;
     if (aprs_demodulator_.parseTelemetryPacket(telemetry_packet)) {
-      aprs_telemetry_.emplace_back(aprs_demodulator_.frame_, telemetry_packet);
+      aprs_telemetry_.emplace_back(std::move(aprs_demodulator_.frame_),
+                                   std::move(telemetry_packet));
+      recordPacketDelivered();
       stats_.total_telemetry_packets++;
     } else {
       stats_.num_telemetry_packets_failed++;
-      other_aprs_packets_.push_back(aprs_demodulator_.frame_);
+      other_aprs_packets_.push_back(std::move(aprs_demodulator_.frame_));
       stats_.total_other_packets++;
     }
     break;
   }
   default:
-    other_aprs_packets_.push_back(aprs_demodulator_.frame_);
+    other_aprs_packets_.push_back(std::move(aprs_demodulator_.frame_));
     stats_.total_other_packets++;
     break;
   }
@@ -142,43 +179,66 @@ void Receiver::processDecodedFrame() {
 
 void Receiver::decode() {
   demodulation_res_ = demodulator_.processAudioBuffer();
+  recordDemodulation(demodulation_res_, true);
+  frequency_offset_ = demodulation_res_.frequency_offset;
+
+  auto &deframe = processing_stats_.getStage(ProcessingStage::DEFRAME);
+  auto &parse = processing_stats_.getStage(ProcessingStage::PARSE);
 
   // NRZI-decode the bit stream once, then repeatedly extract frames from
   // the resulting stream. This allows multiple AX.25 frames that were
   // captured in a single receive buffer (back-to-back packets) to all be
   // decoded, instead of only the first one.
   aprs_demodulator_.output_bit_stream_ = demodulator_.output_bit_stream_;
-  BitStream nrzi_stream =
-      ax25::decodeNrzi(aprs_demodulator_.output_bit_stream_);
+  {
+    StageTimer timer(deframe.time);
+    ax25::decodeNrzi(aprs_demodulator_.output_bit_stream_, nrzi_stream_);
+  }
+  if constexpr (INSTRUMENTATION_ENABLED) {
+    deframe.calls++;
+    deframe.items += nrzi_stream_.getBitStreamLength();
+  }
 
   int frame_count = 0;
-  while (nrzi_stream.getBitStreamLength() > 0) {
-    const int bits_before = nrzi_stream.getBitStreamLength();
+  while (nrzi_stream_.getBitStreamLength() > 0) {
+    const int bits_before = nrzi_stream_.getBitStreamLength();
     bool res = false;
     try {
-      res = aprs_demodulator_.lookForNextAx25Packet(nrzi_stream);
+      StageTimer timer(deframe.time);
+      res = aprs_demodulator_.lookForNextAx25Packet(nrzi_stream_);
     } catch (...) {
-      if (nrzi_stream.getBitStreamLength() == bits_before) {
+      if (nrzi_stream_.getBitStreamLength() == bits_before) {
         break; // no progress; avoid infinite loop
       }
       continue;
     }
-    if (nrzi_stream.getBitStreamLength() == bits_before) {
+    if (nrzi_stream_.getBitStreamLength() == bits_before) {
       break; // no progress; avoid infinite loop
     }
     if (res) {
       frame_count++;
+      StageTimer timer(parse.time);
       processDecodedFrame();
     }
     // if !res but bits were consumed, a false-positive flag was rejected;
     // keep scanning for the next real flag
   }
 
-  constexpr size_t MAX_FRAMES = 10;
+  if constexpr (INSTRUMENTATION_ENABLED) {
+    parse.calls++;
+    parse.items += static_cast<uint64_t>(frame_count);
+  }
+
   if (aprs_messages_.size() > MAX_FRAMES) {
+    processing_stats_.queue_overruns++;
     throw Exception(Exception::Id::APRS_RECEIVER_BUFFER_FULL);
   }
 
+  // Only messages have to be read, the other queues keep the newest packets
+  processing_stats_.queue_overruns +=
+      dropOldest(aprs_positions_) + dropOldest(aprs_experimental_) +
+      dropOldest(aprs_telemetry_) + dropOldest(other_aprs_packets_);
+
   stats_.current_message_packets_in_queue = aprs_messages_.size();
   stats_.current_position_packets_in_queue = aprs_positions_.size();
   stats_.current_experimental_packets_in_queue = aprs_experimental_.size();
@@ -0,0 +1,453 @@
+/**
+ * =*========SignalEasel========*=
+ * A friendly library for signal modulation and demodulation.
+ * https://signaleasel.joshuajer.red/
+ * https://github.com/joshua-jerred/SignalEasel
+ * =*=======================*=
+ * @file       position_parser.cpp
+ * @date       2026-10-19
+ * =*=======================*=
+ * @copyright  2026 Joshua Jerred
+ * @license    GNU GPLv3
+ */
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+#include <SignalEasel/aprs/base91.hpp>
+#include <SignalEasel/aprs/position_parser.hpp>
+
+namespace signal_easel::aprs {
+
+namespace {
+
+/// @brief Compressed latitude is 380926 * (90 - lat), longitude is
+/// 190463 * (180 + lon).
+constexpr float COMPRESSED_LATITUDE_DIVISOR = 380926.0F;
+constexpr float COMPRESSED_LONGITUDE_DIVISOR = 190463.0F;
+
+/// @brief ln(1.002), compressed altitude is 1.002^cs feet
+constexpr double COMPRESSED_ALTITUDE_LOG_BASE = 0.001998002662673058;
+
+/// @brief Hundredths of a minute in a degree
+constexpr float HUNDREDTHS_PER_DEGREE = 6000.0F;
+
+/// @brief Mic-E altitudes are in meters, offset so that sea level is 10000.
+constexpr int32_t MIC_E_ALTITUDE_OFFSET = 10000;
+constexpr float FEET_PER_METER = 3.28084F;
+
+/// @brief Compressed speed is 1.08^s - 1 knots, s in [0, 90]. Built by
+/// repeated multiplication so it is a constant expression.
+constexpr std::array<float, 91> makeCompressedSpeedTable() {
+  std::array<float, 91> table{};
+  double power = 1.0;
+  for (size_t i = 0; i < table.size(); i++) {
+    table[i] = static_cast<float>(power - 1.0);
+    power *= 1.08;
+  }
+  return table;
+}
+constexpr std::array<float, 91> COMPRESSED_SPEED_TABLE =
+    makeCompressedSpeedTable();
+
+/// @brief The length of the fields after the data type identifier
+constexpr size_t TIME_CODE_LENGTH = 7;
+constexpr size_t UNCOMPRESSED_POSITION_LENGTH = 19;
+constexpr size_t COMPRESSED_POSITION_LENGTH = 13;
+constexpr size_t COURSE_SPEED_LENGTH = 7;
+constexpr size_t ALTITUDE_LENGTH = 9; // "/A=123456" or "/A=-12345"
+constexpr size_t MIC_E_MIN_LENGTH = 9;
+constexpr size_t MIC_E_DESTINATION_LENGTH = 6;
+
+bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+/// @brief Reads an unsigned decimal field. Spaces (position ambiguity) are
+/// read as zeros when allowed.
+bool parseDigits(std::string_view field, int32_t &value,
+                 bool allow_spaces = false) {
+  value = 0;
+  for (char c : field) {
+    if (isDigit(c)) {
+      value = value * 10 + (c - '0');
+    } else if (allow_spaces && c == ' ') {
+      value *= 10;
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool parseBase91(std::string_view field, int32_t &value) {
+  uint32_t decoded = 0;
+  if (!base91Decode(field, decoded)) {
+    return false;
+  }
+  value = static_cast<int32_t>(decoded);
+  return true;
+}
+
+void clearPosition(PositionPacket &position) {
+  position.time_code.clear();
+  position.latitude = 0.0F;
+  position.longitude = 0.0F;
+  position.altitude = 0;
+  position.speed = 0.0F;
+  position.course = 0;
+  position.comment.clear();
+}
+
+/// @brief '/' is the primary table, '\' and overlay characters (digits and
+/// letters, lower case in compressed reports) are the secondary.
+bool parseSymbolTable(char table, bool compressed, PositionPacket &position) {
+  if (table == '/') {
+    position.symbol_table = Packet::SymbolTable::PRIMARY;
+    return true;
+  }
+  const bool overlay = compressed
+                           ? (table >= 'A' && table <= 'Z') ||
+                                 (table >= 'a' && table <= 'j')
+                           : (table >= 'A' && table <= 'Z') || isDigit(table);
+  if (table == '\\' || overlay) {
+    position.symbol_table = Packet::SymbolTable::SECONDARY;
+    return true;
+  }
+  return false;
+}
+
+/// @brief "ddhhmmz", "ddhhmm/" or "hhmmssh", the indicator is dropped.
+bool parseTimeCode(std::string_view field, PositionPacket &position) {
+  const char indicator = field[6];
+  if (indicator != 'z' && indicator != '/' && indicator != 'h') {
+    return false;
+  }
+  int32_t unused = 0;
+  if (!parseDigits(field.substr(0, 6), unused)) {
+    return false;
+  }
+  position.time_code.assign(field.data(), 6);
+  return true;
+}
+
+/// @brief "ddmm.hhN/dddmm.hhW$"
+bool parseUncompressedPosition(std::string_view field,
+                               PositionPacket &position) {
+  int32_t lat_degrees = 0;
+  int32_t lat_minutes = 0;
+  int32_t lat_hundredths = 0;
+  int32_t lon_degrees = 0;
+  int32_t lon_minutes = 0;
+  int32_t lon_hundredths = 0;
+  if (!parseDigits(field.substr(0, 2), lat_degrees) ||
+      !parseDigits(field.substr(2, 2), lat_minutes, true) || field[4] != '.' ||
+      !parseDigits(field.substr(5, 2), lat_hundredths, true) ||
+      !parseDigits(field.substr(9, 3), lon_degrees) ||
+      !parseDigits(field.substr(12, 2), lon_minutes, true) ||
+      field[14] != '.' ||
+      !parseDigits(field.substr(15, 2), lon_hundredths, true)) {
+    return false;
+  }
+
+  const char north_south = field[7];
+  const char east_west = field[17];
+  if ((north_south != 'N' && north_south != 'S') ||
+      (east_west != 'E' && east_west != 'W') || lat_degrees > 90 ||
+      lon_degrees > 180 || lat_minutes > 59 || lon_minutes > 59) {
+    return false;
+  }
+
+  if (!parseSymbolTable(field[8], false, position)) {
+    return false;
+  }
+  position.symbol = field[18];
+
+  const int32_t lat = (lat_degrees * 60 + lat_minutes) * 100 + lat_hundredths;
+  const int32_t lon = (lon_degrees * 60 + lon_minutes) * 100 + lon_hundredths;
+  position.latitude = static_cast<float>(lat) / HUNDREDTHS_PER_DEGREE;
+  position.longitude = static_cast<float>(lon) / HUNDREDTHS_PER_DEGREE;
+  if (north_south == 'S') {
+    position.latitude = -position.latitude;
+  }
+  if (east_west == 'W') {
+    position.longitude = -position.longitude;
+  }
+  return true;
+}
+
+/// @brief "/YYYYXXXX$csT"
+bool parseCompressedPosition(std::string_view field,
+                             PositionPacket &position) {
+  int32_t lat = 0;
+  int32_t lon = 0;
+  if (!parseSymbolTable(field[0], true, position) ||
+      !parseBase91(field.substr(1, 4), lat) ||
+      !parseBase91(field.substr(5, 4), lon)) {
+    return false;
+  }
+  position.latitude = 90.0F - static_cast<float>(lat) /
+                                  COMPRESSED_LATITUDE_DIVISOR;
+  position.longitude = static_cast<float>(lon) /
+                           COMPRESSED_LONGITUDE_DIVISOR -
+                       180.0F;
+  position.symbol = field[9];
+
+  const char c = field[10];
+  if (c == ' ') {
+    return true; // no course/speed, range or altitude
+  }
+
+  int32_t c_value = 0;
+  int32_t s_value = 0;
+  int32_t t_value = 0;
+  if (!parseBase91(field.substr(10, 1), c_value) ||
+      !parseBase91(field.substr(11, 1), s_value) ||
+      !parseBase91(field.substr(12, 1), t_value)) {
+    return false;
+  }
+
+  constexpr int32_t NMEA_SOURCE_MASK = 0b11000;
+  constexpr int32_t NMEA_SOURCE_GGA = 0b10000;
+  if ((t_value & NMEA_SOURCE_MASK) == NMEA_SOURCE_GGA) {
+    // Altitude in feet, 1.002^cs. Only a GGA fix gives an altitude.
+    position.altitude = static_cast<int>(std::lround(
+        std::exp(COMPRESSED_ALTITUDE_LOG_BASE * (c_value * 91 + s_value))));
+  } else if (c != '{') { // '{' is a radio range, not a course/speed
+    if (c_value > 89) {
+      return false;
+    }
+    position.course = c_value * 4;
+    position.speed = COMPRESSED_SPEED_TABLE[static_cast<size_t>(s_value)];
+  }
+  return true;
+}
+
+/// @brief Takes a "/A=dddddd" altitude out of the comment, if there is one.
+/// The comment is assigned without it.
+void parseComment(std::string_view comment, PositionPacket &position) {
+  const size_t altitude_start = comment.find("/A=");
+  int32_t altitude = 0;
+  if (altitude_start == std::string_view::npos ||
+      comment.size() - altitude_start < ALTITUDE_LENGTH) {
+    position.comment.assign(comment.data(), comment.size());
+    return;
+  }
+
+  const std::string_view digits = comment.substr(altitude_start + 3, 6);
+  const bool negative = digits[0] == '-';
+  if (!parseDigits(negative ? digits.substr(1) : digits, altitude)) {
+    position.comment.assign(comment.data(), comment.size());
+    return;
+  }
+  position.altitude = negative ? -altitude : altitude;
+
+  const std::string_view after = comment.substr(altitude_start +
+                                                ALTITUDE_LENGTH);
+  position.comment.assign(comment.data(), altitude_start);
+  position.comment.append(after.data(), after.size());
+}
+
+/// @brief The destination address digits are 0-9, A-J (custom message bit),
+/// P-Y (standard message bit) and K, L or Z for an ambiguous digit, read as a
+/// zero. The flag is set for P-Z.
+bool parseMicEDestinationDigit(char c, int32_t &digit, bool &flag) {
+  flag = c >= 'P' && c <= 'Z';
+  if (isDigit(c)) {
+    digit = c - '0';
+  } else if (c >= 'A' && c <= 'J') {
+    digit = c - 'A';
+  } else if (c >= 'P' && c <= 'Y') {
+    digit = c - 'P';
+  } else if (c == 'K' || c == 'L' || c == 'Z') {
+    digit = 0;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+} // namespace
+
+bool isPositionDataType(char data_type) {
+  switch (data_type) {
+  case '!':
+  case '=':
+  case '/':
+  case '@':
+  case '`':
+  case '\'':
+  case 0x1c:
+  case 0x1d:
+    return true;
+  default:
+    return false;
+  }
+}
+
+bool parsePositionInformation(std::string_view info,
+                              PositionPacket &position) {
+  clearPosition(position);
+  if (info.empty()) {
+    return false;
+  }
+
+  size_t index = 1;
+  const char data_type = info[0];
+  if (data_type == '/' || data_type == '@') {
+    if (info.size() < index + TIME_CODE_LENGTH ||
+        !parseTimeCode(info.substr(index, TIME_CODE_LENGTH), position)) {
+      return false;
+    }
+    index += TIME_CODE_LENGTH;
+  } else if (data_type != '!' && data_type != '=') {
+    return false;
+  }
+
+  if (info.size() <= index) {
+    return false;
+  }
+
+  if (isDigit(info[index])) {
+    if (info.size() < index + UNCOMPRESSED_POSITION_LENGTH ||
+        !parseUncompressedPosition(
+            info.substr(index, UNCOMPRESSED_POSITION_LENGTH), position)) {
+      return false;
+    }
+    position.format = PositionPacket::Format::UNCOMPRESSED;
+    index += UNCOMPRESSED_POSITION_LENGTH;
+
+    // Optional "ccc/sss" course and speed data extension
+    int32_t course = 0;
+    int32_t speed = 0;
+    if (info.size() >= index + COURSE_SPEED_LENGTH && info[index + 3] == '/' &&
+        parseDigits(info.substr(index, 3), course) &&
+        parseDigits(info.substr(index + 4, 3), speed) && course <= 360) {
+      position.course = course;
+      position.speed = static_cast<float>(speed);
+      index += COURSE_SPEED_LENGTH;
+    }
+  } else {
+    if (info.size() < index + COMPRESSED_POSITION_LENGTH ||
+        !parseCompressedPosition(
+            info.substr(index, COMPRESSED_POSITION_LENGTH), position)) {
+      return false;
+    }
+    position.format = PositionPacket::Format::COMPRESSED;
+    index += COMPRESSED_POSITION_LENGTH;
+  }
+
+  parseComment(info.substr(index), position);
+  return true;
+}
+
+bool parseMicEInformation(std::string_view destination, std::string_view info,
+                          PositionPacket &position) {
+  clearPosition(position);
+  if (destination.size() != MIC_E_DESTINATION_LENGTH ||
+      info.size() < MIC_E_MIN_LENGTH || !isPositionDataType(info[0])) {
+    return false;
+  }
+
+  // Latitude digits "ddmmhh" and the N/S, longitude offset and E/W flags.
+  std::array<int32_t, MIC_E_DESTINATION_LENGTH> digits{};
+  std::array<bool, MIC_E_DESTINATION_LENGTH> flags{};
+  for (size_t i = 0; i < MIC_E_DESTINATION_LENGTH; i++) {
+    bool flag = false;
+    if (!parseMicEDestinationDigit(destination[i], digits[i], flag)) {
+      return false;
+    }
+    flags[i] = flag;
+  }
+  const bool north = flags[3];
+  const bool longitude_offset = flags[4];
+  const bool west = flags[5];
+
+  const int32_t lat_degrees = digits[0] * 10 + digits[1];
+  const int32_t lat_minutes = digits[2] * 10 + digits[3];
+  const int32_t lat_hundredths = digits[4] * 10 + digits[5];
+  if (lat_degrees > 90 || lat_minutes > 59) {
+    return false;
+  }
+
+  // Longitude, each byte is offset by 28
+  int32_t lon_degrees = info[1] - 28;
+  int32_t lon_minutes = info[2] - 28;
+  const int32_t lon_hundredths = info[3] - 28;
+  if (longitude_offset) {
+    lon_degrees += 100;
+  }
+  if (lon_degrees >= 180 && lon_degrees <= 189) {
+    lon_degrees -= 80;
+  } else if (lon_degrees >= 190 && lon_degrees <= 199) {
+    lon_degrees -= 190;
+  }
+  if (lon_minutes >= 60) {
+    lon_minutes -= 60;
+  }
+  if (lon_degrees < 0 || lon_degrees > 179 || lon_minutes < 0 ||
+      lon_minutes > 59 || lon_hundredths < 0 || lon_hundredths > 99) {
+    return false;
+  }
+
+  // Speed and course: SP = speed / 10, DC = (speed % 10) * 10 + course / 100,
+  // SE = course % 100
+  const int32_t sp = info[4] - 28;
+  const int32_t dc = info[5] - 28;
+  const int32_t se = info[6] - 28;
+  if (sp < 0 || dc < 0 || se < 0) {
+    return false;
+  }
+  int32_t speed = sp * 10 + dc / 10;
+  int32_t course = (dc % 10) * 100 + se;
+  if (speed >= 800) {
+    speed -= 800;
+  }
+  if (course >= 400) {
+    course -= 400;
+  }
+  if (course > 360) {
+    return false;
+  }
+
+  const char table = info[8];
+  if (table != '/' && table != '\\' && !(table >= 'A' && table <= 'Z') &&
+      !isDigit(table)) {
+    return false;
+  }
+  position.symbol_table = table == '/' ? Packet::SymbolTable::PRIMARY
+                                       : Packet::SymbolTable::SECONDARY;
+  position.symbol = info[7];
+
+  const int32_t lat = (lat_degrees * 60 + lat_minutes) * 100 + lat_hundredths;
+  const int32_t lon = (lon_degrees * 60 + lon_minutes) * 100 + lon_hundredths;
+  position.latitude = static_cast<float>(lat) / HUNDREDTHS_PER_DEGREE;
+  position.longitude = static_cast<float>(lon) / HUNDREDTHS_PER_DEGREE;
+  if (!north) {
+    position.latitude = -position.latitude;
+  }
+  if (west) {
+    position.longitude = -position.longitude;
+  }
+  position.speed = static_cast<float>(speed);
+  position.course = course;
+  position.format = PositionPacket::Format::MIC_E;
+
+  // The status text may start with a radio type byte, then a "xxx}" base-91
+  // altitude.
+  std::string_view status = info.substr(MIC_E_MIN_LENGTH);
+  if (!status.empty() && (status[0] == '>' || status[0] == ']' ||
+                          status[0] == '`' || status[0] == '\'')) {
+    status.remove_prefix(1);
+  }
+  int32_t altitude = 0;
+  if (status.size() >= 4 && status[3] == '}' &&
+      parseBase91(status.substr(0, 3), altitude)) {
+    position.altitude = static_cast<int>(std::lround(
+        (altitude - MIC_E_ALTITUDE_OFFSET) * FEET_PER_METER));
+    status.remove_prefix(4);
+  }
+  position.comment.assign(status.data(), status.size());
+  return true;
+}
+
+} // namespace signal_easel::aprs
@@ -0,0 +1,80 @@
+/**
+ * =*========SignalEasel========*=
+ * A friendly library for signal modulation and demodulation.
+ * https://github.com/joshua-jerred/Giraffe
+ * https://joshuajer.red/signal-easel
+ * =*===========================*=
+ *
+ * @file   audio_cache.cpp
+ * @date   2026-10-19
+ * @brief  LRU cache of rendered modulator audio implementation
+ *
+ * =*=======================*=
+ * @copyright  2026 Joshua Jerred
+ * @license    GNU GPLv3
+ */
+
+#include <SignalEasel/audio_cache.hpp>
+
+namespace signal_easel {
+
+std::shared_ptr<const CachedAudio> AudioCache::find(const std::string &key) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = index_.find(key);
+  if (it == index_.end()) {
+    stats_.misses++;
+    return nullptr;
+  }
+  stats_.hits++;
+  entries_.splice(entries_.begin(), entries_, it->second);
+  return it->second->audio;
+}
+
+void AudioCache::insert(const std::string &key, CachedAudio audio) {
+  Entry entry{key, std::make_shared<const CachedAudio>(std::move(audio))};
+  const size_t entry_bytes = getEntryBytes(entry);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto existing = index_.find(key);
+  if (existing != index_.end()) {
+    stats_.bytes -= getEntryBytes(*existing->second);
+    entries_.erase(existing->second);
+    index_.erase(existing);
+  }
+
+  if (entry_bytes > max_bytes_) {
+    stats_.entries = entries_.size();
+    return;
+  }
+
+  evict(entry_bytes);
+  entries_.push_front(std::move(entry));
+  index_.emplace(key, entries_.begin());
+  stats_.bytes += entry_bytes;
+  stats_.entries = entries_.size();
+}
+
+void AudioCache::clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  entries_.clear();
+  index_.clear();
+  stats_.bytes = 0;
+  stats_.entries = 0;
+}
+
+AudioCache::Stats AudioCache::getStats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stats_;
+}
+
+void AudioCache::evict(size_t bytes_needed) {
+  while (!entries_.empty() && stats_.bytes + bytes_needed > max_bytes_) {
+    const Entry &oldest = entries_.back();
+    stats_.bytes -= getEntryBytes(oldest);
+    index_.erase(oldest.key);
+    entries_.pop_back();
+    stats_.evictions++;
+  }
+}
+
+} // namespace signal_easel
@@ -45,6 +45,12 @@ void print_hex(uint8_t byte) {
  */
 BitStream decodeNrzi(BitStream &bit_stream) {
   BitStream nrzi_bit_stream;
+  decodeNrzi(bit_stream, nrzi_bit_stream);
+  return nrzi_bit_stream;
+}
+
+void decodeNrzi(BitStream &bit_stream, BitStream &output) {
+  output.clear();
   int8_t previous_bit = 0;
   size_t num_bits = bit_stream.getBitStreamLength();
   while (num_bits > 0) {
@@ -53,15 +59,14 @@ BitStream decodeNrzi(BitStream &bit_stream) {
       break;
     }
     if (bit == previous_bit) {
-      nrzi_bit_stream.addOneBit();
+      output.addOneBit();
     } else {
-      nrzi_bit_stream.addZeroBit();
+      output.addZeroBit();
     }
     previous_bit = bit;
     num_bits--;
   }
-  nrzi_bit_stream.pushBufferToBitStream();
-  return nrzi_bit_stream;
+  output.pushBufferToBitStream();
 }
 
 /**
@@ -117,6 +122,13 @@ int findStartFlags(BitStream &bit_stream) {
 
 std::vector<uint8_t> deStuffBytes(BitStream &bit_stream) {
   std::vector<uint8_t> destuffed_bytes;
+  deStuffBytes(bit_stream, destuffed_bytes);
+  return destuffed_bytes;
+}
+
+void deStuffBytes(BitStream &bit_stream,
+                  std::vector<uint8_t> &destuffed_bytes) {
+  destuffed_bytes.clear();
   int consecutive_ones = 0;
   int num_bits = bit_stream.getBitStreamLength();
   uint8_t byte_buffer = 0;
@@ -131,7 +143,7 @@ std::vector<uint8_t> deStuffBytes(BitStream &bit_stream) {
           // std::cout << "Found stuffed bit" << std::endl;
         } else {
           // std::cout << "Found end flag" << std::endl;
-          return destuffed_bytes;
+          return;
         }
       }
 
@@ -141,7 +153,7 @@ std::vector<uint8_t> deStuffBytes(BitStream &bit_stream) {
         // std::cout << "Ran out of bits" << std::endl;
         // return false;
         num_bits = 0;
-        return destuffed_bytes;
+        return;
       }
       if (next_bit == 1) {
         consecutive_ones++;
@@ -153,7 +165,6 @@ std::vector<uint8_t> deStuffBytes(BitStream &bit_stream) {
     }
     destuffed_bytes.push_back(reverse_bits(byte_buffer));
   }
-  return destuffed_bytes;
 }
 
 bool Frame::parseBitStream(BitStream &bit_stream) {
@@ -162,6 +173,12 @@ bool Frame::parseBitStream(BitStream &bit_stream) {
 }
 
 bool Frame::parseNrziDecodedBitStream(BitStream &nrzi_bit_stream) {
+  std::vector<uint8_t> frame_buffer;
+  return parseNrziDecodedBitStream(nrzi_bit_stream, frame_buffer);
+}
+
+bool Frame::parseNrziDecodedBitStream(BitStream &nrzi_bit_stream,
+                                      std::vector<uint8_t> &destuffed_bytes) {
   // Only one flag byte is guaranteed before the frame (in particular, a
   // closing flag of a previous frame may double as the opening flag of the
   // next). Requiring two consecutive preamble flags caused back-to-back
@@ -183,7 +200,7 @@ bool Frame::parseNrziDecodedBitStream(BitStream &nrzi_bit_stream) {
     return false;
   }
 
-  std::vector<uint8_t> destuffed_bytes = deStuffBytes(nrzi_bit_stream);
+  deStuffBytes(nrzi_bit_stream, destuffed_bytes);
 
   if (destuffed_bytes.size() < MIN_BYTES) {
     return false;
@@ -257,9 +274,13 @@ bool Frame::parseNrziDecodedBitStream(BitStream &nrzi_bit_stream) {
 
   // parse the information
   const size_t k_fcs_length = 2;
-  for (; iterator < destuffed_bytes.size() - k_fcs_length;) {
-    this->information_.push_back(destuffed_bytes.at(iterator++));
+  if (iterator + k_fcs_length > destuffed_bytes.size()) {
+    return false;
   }
+  const size_t information_end = destuffed_bytes.size() - k_fcs_length;
+  information_.assign(destuffed_bytes.begin() + iterator,
+                      destuffed_bytes.begin() + information_end);
+  iterator = information_end;
 
   // parse the FCS
   fcs_ = 0;
@@ -17,6 +17,7 @@
 #include <type_traits>
 
 #include <SignalEasel/ax25.hpp>
+#include <SignalEasel/exception.hpp>
 
 namespace signal_easel::ax25 {
 
@@ -83,7 +84,7 @@ bool Frame::isFrameValid() {
   return true;
 }
 
-std::vector<uint8_t> Frame::buildFrame() {
+const std::vector<uint8_t> &Frame::buildFrame() {
   if (!isFrameValid()) {
     throw std::runtime_error("Frame is not valid");
   }
@@ -145,92 +146,147 @@ std::vector<uint8_t> Frame::buildFrame() {
   return build_buffer_;
 }
 
-std::vector<uint8_t> Frame::encodeFrame() {
-  BitStream bit_stream = BitStream();
+namespace {
 
-  // Add the flag(s)
-  for (size_t i = 0; i < K_PREAMBLE_LENGTH; i++) {
-    uint8_t byte[1] = {K_FLAG};
-    bit_stream.addBits(byte, 8);
+/**
+ * @brief NRZI encode a byte, MSB first, from a starting level.
+ * @details A 0 is a change of level, a 1 is no change.
+ * @param byte The byte to encode
+ * @param level The level before the first bit
+ * @return uint8_t The levels of the 8 bits, MSB first
+ */
+constexpr uint8_t nrziEncodeByte(uint8_t byte, bool level) {
+  uint8_t encoded = 0;
+  for (int i = 7; i >= 0; i--) {
+    if (((byte >> i) & 1) == 0) {
+      level = !level;
+    }
+    encoded |= static_cast<uint8_t>(level) << i;
   }
+  return encoded;
+}
 
-  // Start Bit Stuffing
-  int consecutive_ones = 0;
+/// @brief A flag, NRZI encoded from each starting level. A flag has an even
+/// number of zeros, so it leaves the level where it found it.
+constexpr uint8_t K_NRZI_FLAG[2] = {nrziEncodeByte(K_FLAG, false),
+                                    nrziEncodeByte(K_FLAG, true)};
+static_assert((K_NRZI_FLAG[0] & 1) == 0 && (K_NRZI_FLAG[1] & 1) == 1);
+
+/**
+ * @brief NRZI encodes bits and packs them MSB first onto the end of a byte
+ * vector. Bits that don't fill the last byte are dropped.
+ */
+class NrziWriter {
+public:
+  explicit NrziWriter(std::vector<uint8_t> &output) : output_(output) {}
+
+  void writeFlag() { writeEncodedByte(K_NRZI_FLAG[level_]); }
+
+  /// @brief Write a bit of data, LSB first order is up to the caller
+  void writeBit(bool bit) {
+    if (!bit) {
+      level_ = !level_;
+    }
+    pending_ = (pending_ << 1) | level_;
+    if (++num_pending_ == 8) {
+      output_.push_back(static_cast<uint8_t>(pending_));
+      pending_ = 0;
+      num_pending_ = 0;
+    }
+  }
+
+private:
+  void writeEncodedByte(uint8_t encoded) {
+    pending_ = (pending_ << 8) | encoded;
+    output_.push_back(static_cast<uint8_t>(pending_ >> num_pending_));
+    pending_ &= (1U << num_pending_) - 1;
+  }
+
+  std::vector<uint8_t> &output_;
+  bool level_ = false;
+  uint32_t pending_ = 0;
+  uint32_t num_pending_ = 0;
+};
 
-  // Add the contents of the frame
-  // first, reverse the bytes
-  for (uint8_t byte : buildFrame()) {
-    uint8_t reversed_byte = byte; // reverseByte(byte);
+/**
+ * @brief Write the contents of a frame, LSB first, with a 0 stuffed after any
+ * five 1s in a row.
+ */
+void writeStuffedFrame(NrziWriter &writer, const std::vector<uint8_t> &frame) {
+  int consecutive_ones = 0;
+  for (uint8_t byte : frame) {
     for (int i = 0; i <= 7; i++) {
-      bool bit = (reversed_byte >> i) & 1;
-      if (bit) {
-        consecutive_ones++;
-        bit_stream.addOneBit();
-      } else {
-        consecutive_ones = 0;
-        bit_stream.addZeroBit();
-      }
+      const bool bit = (byte >> i) & 1;
+      writer.writeBit(bit);
+      consecutive_ones = bit ? consecutive_ones + 1 : 0;
 
       if (consecutive_ones == 5) {
-        bit_stream.addZeroBit();
+        writer.writeBit(false);
         consecutive_ones = 0;
       }
     }
   }
+}
 
-  // Add the FCS
-  // for (int i = 15; i >= 0; i--) {
-  //   bool bit = (fcs_ >> i) & 1;
-  //   if (bit) {
-  //     consecutive_ones++;
-  //     bit_stream.addOneBit();
-  //   } else {
-  //     consecutive_ones = 0;
-  //     bit_stream.addZeroBit();
-  //   }
-
-  //   if (consecutive_ones == 5) {
-  //     bit_stream.addZeroBit();
-  //     consecutive_ones = 0;
-  //   }
-  // }
-
-  // Add the flag(s)
-  for (size_t i = 0; i < K_POSTAMBLE_LENGTH; i++) {
-    uint8_t byte[1] = {K_FLAG};
-    bit_stream.addBits(byte, 8);
-  }
+/// @brief Stuffing adds at most one bit for every five
+size_t getMaxStuffedSize(size_t frame_size) { return frame_size * 6 / 5 + 1; }
+
+} // namespace
 
-  // NRZI encode the bit stream into a vector of bytes
+std::vector<uint8_t> Frame::encodeFrame() {
   std::vector<uint8_t> encoded_frame{};
+  encodeFrame(encoded_frame);
+  return encoded_frame;
+}
 
-  // Used for NRZI encoding. If we encounter a 0, we flip the bit.
-  bool previous_bit = 0;
-  size_t byte_index = 0;
-  uint8_t byte_buffer = 0;
+void Frame::encodeFrame(std::vector<uint8_t> &encoded_frame) {
+  const std::vector<uint8_t> &frame = buildFrame();
 
-  while (bit_stream.getBitStreamLength() > 0) {
-    int8_t bit = bit_stream.popNextBit();
-    if (bit == -1) {
-      break; // allow for the last byte to be incomplete
-    }
+  encoded_frame.clear();
+  encoded_frame.reserve(K_PREAMBLE_LENGTH + K_POSTAMBLE_LENGTH +
+                        getMaxStuffedSize(frame.size()));
 
-    if (bit == 1) {
-      byte_buffer |= previous_bit << (7 - byte_index);
-    } else {
-      byte_buffer |= (!previous_bit) << (7 - byte_index);
-      previous_bit = !previous_bit;
-    }
+  NrziWriter writer(encoded_frame);
+  for (size_t i = 0; i < K_PREAMBLE_LENGTH; i++) {
+    writer.writeFlag();
+  }
+  writeStuffedFrame(writer, frame);
+  for (size_t i = 0; i < K_POSTAMBLE_LENGTH; i++) {
+    writer.writeFlag();
+  }
+}
 
-    byte_index++;
-    if (byte_index == 8) {
-      encoded_frame.push_back(byte_buffer);
-      byte_buffer = 0;
-      byte_index = 0;
-    }
+void encodeFrames(std::vector<Frame> &frames, size_t fill_flags,
+                  std::vector<uint8_t> &encoded) {
+  if (fill_flags == 0) {
+    throw Exception(Exception::Id::AX25_INVALID_FLAG_FILL);
   }
 
-  return encoded_frame;
+  // Addresses, control, PID and FCS, at most
+  constexpr size_t K_MAX_HEADER_SIZE =
+      (2 + K_MAX_REPEATER_ADDRESSES) * (K_ADDRESS_CHARS_LENGTH + 1) + 4;
+  size_t max_size = K_PREAMBLE_LENGTH + K_POSTAMBLE_LENGTH;
+  for (const Frame &frame : frames) {
+    const size_t frame_size =
+        K_MAX_HEADER_SIZE + frame.getInformationRef().size();
+    max_size += fill_flags + getMaxStuffedSize(frame_size);
+  }
+  encoded.clear();
+  encoded.reserve(max_size);
+
+  NrziWriter writer(encoded);
+  for (size_t i = 0; i < K_PREAMBLE_LENGTH; i++) {
+    writer.writeFlag();
+  }
+  for (size_t frame = 0; frame < frames.size(); frame++) {
+    for (size_t i = 0; frame > 0 && i < fill_flags; i++) {
+      writer.writeFlag();
+    }
+    writeStuffedFrame(writer, frames[frame].buildFrame());
+  }
+  for (size_t i = 0; i < K_POSTAMBLE_LENGTH; i++) {
+    writer.writeFlag();
+  }
 }
 
 void Frame::addToBuildBuffer(uint8_t byte, bool reverse) {
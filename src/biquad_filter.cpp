@@ -0,0 +1,116 @@
+/**
+ * =*========SignalEasel========*=
+ * A friendly library for signal modulation and demodulation.
+ * https://github.com/joshua-jerred/Giraffe
+ * https://joshuajer.red/signal-easel
+ * =*===========================*=
+ *
+ * @file   biquad_filter.cpp
+ * @date   2026-10-19
+ * @brief  Cascaded biquad (second order section) IIR filters
+ *
+ * =*=======================*=
+ * @copyright  2026 Joshua Jerred
+ * @license    GNU GPLv3
+ */
+
+#include <complex>
+
+#include <SignalEasel/constants.hpp>
+#include <SignalEasel/exception.hpp>
+
+#include "biquad_filter.hpp"
+
+namespace signal_easel {
+
+std::vector<BiquadCoefficients>
+designButterworthBandPass(double sample_rate, double lower_cutoff,
+                          double upper_cutoff, size_t order) {
+  validate(order > 0, "Filter order must be non-zero");
+  validate(lower_cutoff > 0.0 && lower_cutoff < upper_cutoff &&
+               upper_cutoff < sample_rate / 2.0,
+           "Band-pass cutoffs must be ordered and below Nyquist");
+
+  // Pre-warp the band edges for the bilinear transform
+  const double two_fs = 2.0 * sample_rate;
+  const double lower = two_fs * std::tan(PI_VAL * lower_cutoff / sample_rate);
+  const double upper = two_fs * std::tan(PI_VAL * upper_cutoff / sample_rate);
+  const double bandwidth = upper - lower;
+  const double center_squared = lower * upper;
+  const double center = 2.0 * std::atan(std::sqrt(center_squared) / two_fs);
+
+  std::vector<BiquadCoefficients> sections;
+  for (size_t k = 0; k < order; k++) {
+    // Low-pass prototype pole, transformed to a pair of band-pass poles
+    const std::complex<double> prototype = std::polar(
+        1.0, PI_VAL * static_cast<double>(2 * k + order + 1) / (2.0 * order));
+    const std::complex<double> half = prototype * bandwidth / 2.0;
+    const std::complex<double> root = std::sqrt(half * half - center_squared);
+
+    for (const auto &pole : {half + root, half - root}) {
+      const std::complex<double> z = (two_fs + pole) / (two_fs - pole);
+      if (z.imag() <= 0.0) {
+        continue; // the conjugate makes up the other half of the section
+      }
+
+      // Zeros at z = 1 and z = -1, normalized at the center frequency
+      BiquadCoefficients section;
+      section.a1 = -2.0 * z.real();
+      section.a2 = std::norm(z);
+      const std::complex<double> z1 = std::polar(1.0, -center);
+      const std::complex<double> z2 = z1 * z1;
+      const double gain =
+          std::abs(1.0 + section.a1 * z1 + section.a2 * z2) /
+          std::abs(1.0 - z2);
+      section.b0 = gain;
+      section.b2 = -gain;
+      sections.push_back(section);
+    }
+  }
+
+  return sections;
+}
+
+template <typename T>
+BiquadFilter<T>::BiquadFilter(const std::vector<BiquadCoefficients> &sections) {
+  for (const auto &section : sections) {
+    sections_.push_back({Traits::coefficient(section.b0),
+                         Traits::coefficient(section.b1),
+                         Traits::coefficient(section.b2),
+                         Traits::coefficient(section.a1),
+                         Traits::coefficient(section.a2)});
+  }
+}
+
+template <typename T>
+void BiquadFilter<T>::process(const std::vector<T> &input,
+                              std::vector<T> &output) const {
+  output = input;
+
+  // One section at a time over the whole buffer (direct form I)
+  for (const auto &section : sections_) {
+    T x1 = 0;
+    T x2 = 0;
+    T y1 = 0;
+    T y2 = 0;
+    for (T &sample : output) {
+      const T x0 = sample;
+      const Accumulator sum =
+          Traits::multiply(section.b0, x0) + Traits::multiply(section.b1, x1) +
+          Traits::multiply(section.b2, x2) - Traits::multiply(section.a1, y1) -
+          Traits::multiply(section.a2, y2);
+      const T y0 = Traits::fromAccumulator(sum);
+      x2 = x1;
+      x1 = x0;
+      y2 = y1;
+      y1 = y0;
+      sample = y0;
+    }
+  }
+}
+
+template class BiquadFilter<double>;
+template class BiquadFilter<float>;
+template class BiquadFilter<FixedSample>;
+
+} // namespace signal_easel
@@ -0,0 +1,93 @@
+/**
+ * =*========SignalEasel========*=
+ * A friendly library for signal modulation and demodulation.
+ * https://github.com/joshua-jerred/Giraffe
+ * https://joshuajer.red/signal-easel
+ * =*===========================*=
+ *
+ * @file   biquad_filter.hpp
+ * @date   2026-10-19
+ * @brief  Cascaded biquad (second order section) IIR filters
+ *
+ * =*=======================*=
+ * @copyright  2026 Joshua Jerred
+ * @license    GNU GPLv3
+ */
+
+#ifndef SIGNAL_EASEL_BIQUAD_FILTER_HPP_
+#define SIGNAL_EASEL_BIQUAD_FILTER_HPP_
+
+#include <vector>
+
+#include "sample_traits.hpp"
+
+namespace signal_easel {
+
+/**
+ * @brief The coefficients of one second order section,
+ * H(z) = (b0 + b1 z^-1 + b2 z^-2) / (1 + a1 z^-1 + a2 z^-2)
+ */
+struct BiquadCoefficients {
+  double b0 = 0.0;
+  double b1 = 0.0;
+  double b2 = 0.0;
+  double a1 = 0.0;
+  double a2 = 0.0;
+};
+
+/**
+ * @brief Designs a Butterworth band-pass filter as a cascade of second order
+ * sections.
+ * @details The band edges are pre-warped for the bilinear transform. Split
+ * into sections so it stays well conditioned with narrow bands at high
+ * sample rates, and so it can run in single precision or fixed point. Each
+ * section is normalized to unity gain at the center frequency to keep the
+ * intermediate values in range.
+ * @param sample_rate The sample rate of the signal to filter
+ * @param lower_cutoff The lower -3dB frequency
+ * @param upper_cutoff The upper -3dB frequency
+ * @param order The order of the low-pass prototype, one section per order
+ * @return The sections, in the order they should be applied
+ */
+std::vector<BiquadCoefficients>
+designButterworthBandPass(double sample_rate, double lower_cutoff,
+                          double upper_cutoff, size_t order);
+
+/**
+ * @brief A cascade of biquads running on samples of type T (double, float or
+ * FixedSample).
+ */
+template <typename T> class BiquadFilter {
+public:
+  explicit BiquadFilter(const std::vector<BiquadCoefficients> &sections);
+
+  /**
+   * @brief Filters a buffer, starting from a zero state.
+   * @param input The input signal
+   * @param output (out) The filtered signal, same length as the input
+   */
+  void process(const std::vector<T> &input, std::vector<T> &output) const;
+
+private:
+  using Traits = SampleTraits<T>;
+  using Coefficient = typename Traits::Coefficient;
+  using Accumulator = typename Traits::Accumulator;
+
+  struct Section {
+    Coefficient b0;
+    Coefficient b1;
+    Coefficient b2;
+    Coefficient a1;
+    Coefficient a2;
+  };
+
+  std::vector<Section> sections_ = {};
+};
+
+extern template class BiquadFilter<double>;
+extern template class BiquadFilter<float>;
+extern template class BiquadFilter<FixedSample>;
+
+} // namespace signal_easel
+
+#endif /* SIGNAL_EASEL_BIQUAD_FILTER_HPP_ */
@@ -23,7 +23,8 @@ void BitStream::addBits(const unsigned char *data, int num_bits) {
       buffer_space = 32;
     }
 
-    if (buffer_space >= num_bits && num_bits > 8) { // Write a byte at a time
+    if (buffer_space >= num_bits && num_bits > 8 &&
+        bit_index == 0) { // Write a byte at a time
       // std::cout << "Writing a byte at a time" << std::endl;
       bit_stream_buffer_ |= (data[data_index] << (32 - bit_stream_offset_ - 8));
       bit_stream_offset_ += 8;
@@ -44,6 +45,32 @@ void BitStream::addBits(const unsigned char *data, int num_bits) {
   }
 }
 
+void BitStream::addWord(uint32_t bits, int num_bits) {
+  if (num_bits <= 0) {
+    return;
+  }
+  if (bit_stream_offset_ == 32) { // buffer is full, write to bit stream
+    bit_stream_.push_back(bit_stream_buffer_);
+    bit_stream_buffer_ = 0;
+    bit_stream_offset_ = 0;
+  }
+
+  // Line the bits up after the buffer's in a 64 bit word, the top half goes
+  // into the buffer and the bottom half is whatever spilled over.
+  const uint64_t mask = (uint64_t{1} << num_bits) - 1;
+  const uint64_t aligned = (bits & mask)
+                           << (64 - bit_stream_offset_ - num_bits);
+  bit_stream_buffer_ |= static_cast<uint32_t>(aligned >> 32);
+  bit_stream_offset_ += num_bits;
+  bit_stream_length_ += num_bits;
+
+  if (bit_stream_offset_ > 32) {
+    bit_stream_.push_back(bit_stream_buffer_);
+    bit_stream_buffer_ = static_cast<uint32_t>(aligned);
+    bit_stream_offset_ -= 32;
+  }
+}
+
 /**
  * @brief After adding all of the data to the bit stream, this method will
  * write the data left in the buffer
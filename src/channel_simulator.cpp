@@ -0,0 +1,259 @@
+/**
+ * =*========SignalEasel========*=
+ * A friendly library for signal modulation and demodulation.
+ * https://github.com/joshua-jerred/Giraffe
+ * https://joshuajer.red/signal-easel
+ * =*===========================*=
+ *
+ * @file   channel_simulator.cpp
+ * @date   2026-10-19
+ * @brief  Synthetic radio channel implementation
+ *
+ * =*=======================*=
+ * @copyright  2026 Joshua Jerred
+ * @license    GNU GPLv3
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include <SignalEasel/afsk.hpp>
+#include <SignalEasel/channel_simulator.hpp>
+#include <SignalEasel/constants.hpp>
+#include <SignalEasel/exception.hpp>
+
+namespace signal_easel {
+
+namespace {
+
+/// @brief The frequencies the twist slope is held flat beyond, so the gain
+/// doesn't run away outside of the audio band.
+constexpr double TWIST_MIN_FREQUENCY = 300.0;
+constexpr double TWIST_MAX_FREQUENCY = 3300.0;
+
+/// @brief The number of points used to integrate the twist response
+constexpr size_t TWIST_DESIGN_POINTS = 4096;
+
+double blackman(size_t n, size_t length) {
+  const double x = TWO_PI_VAL * static_cast<double>(n) / (length - 1);
+  return 0.42 - 0.5 * std::cos(x) + 0.08 * std::cos(2.0 * x);
+}
+
+/**
+ * @brief Convolve with an odd length, linear phase, filter and remove it's
+ * delay, so the output lines up with the input.
+ */
+std::vector<double> filterZeroDelay(const std::vector<double> &signal,
+                                    const std::vector<double> &taps) {
+  const size_t half = taps.size() / 2;
+  std::vector<double> output(signal.size(), 0.0);
+  for (size_t i = 0; i < signal.size(); i++) {
+    double sum = 0.0;
+    const size_t first =
+        i + half >= signal.size() ? i + half - signal.size() + 1 : 0;
+    const size_t last = std::min(taps.size(), i + half + 1);
+    for (size_t k = first; k < last; k++) {
+      sum += taps[k] * signal[i + half - k];
+    }
+    output[i] = sum;
+  }
+  return output;
+}
+
+} // namespace
+
+ChannelSimulator::ChannelSimulator() : ChannelSimulator(Settings()) {}
+
+ChannelSimulator::ChannelSimulator(Settings settings)
+    : settings_(std::move(settings)), random_(settings_.seed) {
+  validate(settings_.bit_rate > 0, "Channel bit rate must be non-zero");
+  validate(std::isfinite(settings_.eb_n0_db), "Channel Eb/N0 must be finite");
+  validate(std::abs(settings_.frequency_offset) < AUDIO_SAMPLE_RATE / 4.0,
+           "Channel frequency offset out of range");
+  validate(std::abs(settings_.clock_drift_ppm) < 100000.0,
+           "Channel clock drift out of range");
+  validate(std::abs(settings_.twist_db) <= 40.0,
+           "Channel twist out of range");
+  validate(settings_.dropout_rate >= 0.0 && settings_.dropout_duration >= 0.0,
+           "Channel dropout settings must not be negative");
+
+  if (settings_.frequency_offset != 0.0) {
+    // Windowed ideal Hilbert transformer, odd taps are 2/(pi*n)
+    const size_t half = CHANNEL_SIMULATOR_HILBERT_TAPS / 2;
+    hilbert_taps_.assign(CHANNEL_SIMULATOR_HILBERT_TAPS, 0.0);
+    for (size_t n = 0; n < CHANNEL_SIMULATOR_HILBERT_TAPS; n++) {
+      const int offset = static_cast<int>(n) - static_cast<int>(half);
+      if (offset % 2 != 0) {
+        hilbert_taps_[n] = 2.0 / (PI_VAL * offset) *
+                           blackman(n, CHANNEL_SIMULATOR_HILBERT_TAPS);
+      }
+    }
+  }
+
+  if (settings_.twist_db != 0.0) {
+    // Frequency sampling design of a linear in dB slope
+    const size_t half = CHANNEL_SIMULATOR_TWIST_TAPS / 2;
+    const double nyquist = AUDIO_SAMPLE_RATE / 2.0;
+    const double step = nyquist / TWIST_DESIGN_POINTS;
+    const double db_per_hz =
+        settings_.twist_db /
+        (afsk::AFSK_SPACE_FREQUENCY - afsk::AFSK_MARK_FREQUENCY);
+    twist_taps_.assign(CHANNEL_SIMULATOR_TWIST_TAPS, 0.0);
+    for (size_t p = 0; p < TWIST_DESIGN_POINTS; p++) {
+      const double frequency = (p + 0.5) * step;
+      const double clamped =
+          std::clamp(frequency, TWIST_MIN_FREQUENCY, TWIST_MAX_FREQUENCY);
+      const double gain = std::pow(
+          10.0, db_per_hz * (clamped - CHANNEL_SIMULATOR_TWIST_CENTER) / 20.0);
+      for (size_t n = 0; n < CHANNEL_SIMULATOR_TWIST_TAPS; n++) {
+        const double offset = static_cast<double>(n) - half;
+        twist_taps_[n] += 2.0 * gain * step / AUDIO_SAMPLE_RATE *
+                          std::cos(TWO_PI_VAL * frequency * offset /
+                                   AUDIO_SAMPLE_RATE);
+      }
+    }
+    for (size_t n = 0; n < CHANNEL_SIMULATOR_TWIST_TAPS; n++) {
+      twist_taps_[n] *= blackman(n, CHANNEL_SIMULATOR_TWIST_TAPS);
+    }
+
+    // The window smooths the slope, which raises the gain at the center. Put
+    // it back to unity (the response is real, the filter is symmetric).
+    double center_gain = 0.0;
+    for (size_t n = 0; n < CHANNEL_SIMULATOR_TWIST_TAPS; n++) {
+      const double offset = static_cast<double>(n) - half;
+      center_gain += twist_taps_[n] *
+                     std::cos(TWO_PI_VAL * CHANNEL_SIMULATOR_TWIST_CENTER *
+                              offset / AUDIO_SAMPLE_RATE);
+    }
+    for (double &tap : twist_taps_) {
+      tap /= center_gain;
+    }
+  }
+}
+
+void ChannelSimulator::process(const std::vector<int16_t> &input,
+                               std::vector<int16_t> &output) {
+  std::vector<double> signal(input.begin(), input.end());
+
+  double signal_power = 0.0;
+  for (double sample : signal) {
+    signal_power += sample * sample;
+  }
+  signal_power = signal.empty() ? 0.0 : signal_power / signal.size();
+
+  applyTwist(signal);
+  applyClockDrift(signal);
+  applyFrequencyOffset(signal);
+  applyDropouts(signal);
+  addNoise(signal, signal_power);
+
+  output.resize(signal.size());
+  for (size_t i = 0; i < signal.size(); i++) {
+    output[i] = static_cast<int16_t>(
+        std::clamp(std::round(signal[i]), -32768.0, 32767.0));
+  }
+}
+
+void ChannelSimulator::applyTwist(std::vector<double> &signal) const {
+  if (twist_taps_.empty()) {
+    return;
+  }
+  signal = filterZeroDelay(signal, twist_taps_);
+}
+
+void ChannelSimulator::applyClockDrift(std::vector<double> &signal) const {
+  if (settings_.clock_drift_ppm == 0.0 || signal.size() < 2) {
+    return;
+  }
+
+  // Output sample n is taken at time n * ratio of the input, with cubic
+  // (Catmull-Rom) interpolation between the input samples.
+  const double ratio = 1.0 + settings_.clock_drift_ppm * 1e-6;
+  const size_t last = signal.size() - 1;
+  const size_t output_length =
+      static_cast<size_t>(std::floor(static_cast<double>(last) / ratio)) + 1;
+
+  auto at = [&](int64_t index) {
+    return signal[static_cast<size_t>(
+        std::clamp<int64_t>(index, 0, static_cast<int64_t>(last)))];
+  };
+
+  std::vector<double> output(output_length);
+  for (size_t n = 0; n < output_length; n++) {
+    const double time = static_cast<double>(n) * ratio;
+    const int64_t index = static_cast<int64_t>(std::floor(time));
+    const double t = time - static_cast<double>(index);
+
+    const double p0 = at(index - 1);
+    const double p1 = at(index);
+    const double p2 = at(index + 1);
+    const double p3 = at(index + 2);
+    output[n] = p1 + 0.5 * t *
+                         (p2 - p0 +
+                          t * (2.0 * p0 - 5.0 * p1 + 4.0 * p2 - p3 +
+                               t * (3.0 * (p1 - p2) + p3 - p0)));
+  }
+  signal = std::move(output);
+}
+
+void ChannelSimulator::applyFrequencyOffset(std::vector<double> &signal) const {
+  if (hilbert_taps_.empty()) {
+    return;
+  }
+
+  // Single sideband shift: Re{(x + jH{x}) * e^(jwt)}
+  const std::vector<double> quadrature = filterZeroDelay(signal, hilbert_taps_);
+  const double delta =
+      TWO_PI_VAL * settings_.frequency_offset / AUDIO_SAMPLE_RATE;
+  for (size_t i = 0; i < signal.size(); i++) {
+    const double phase = delta * static_cast<double>(i);
+    signal[i] = signal[i] * std::cos(phase) - quadrature[i] * std::sin(phase);
+  }
+}
+
+void ChannelSimulator::applyDropouts(std::vector<double> &signal) {
+  if (settings_.dropout_rate <= 0.0 || settings_.dropout_duration <= 0.0) {
+    return;
+  }
+
+  const double mean_gap = AUDIO_SAMPLE_RATE / settings_.dropout_rate;
+  const size_t length = static_cast<size_t>(
+      std::round(settings_.dropout_duration * AUDIO_SAMPLE_RATE));
+
+  double position = -mean_gap * std::log(uniform());
+  while (position < static_cast<double>(signal.size())) {
+    const size_t start = static_cast<size_t>(position);
+    const size_t end = std::min(signal.size(), start + length);
+    std::fill(signal.begin() + start, signal.begin() + end, 0.0);
+    position += static_cast<double>(length) - mean_gap * std::log(uniform());
+  }
+}
+
+void ChannelSimulator::addNoise(std::vector<double> &signal,
+                                double signal_power) {
+  noise_level_ = 0.0;
+  if (!settings_.add_noise) {
+    return;
+  }
+
+  // Eb = P / Rb and N0 = sigma^2 / (fs / 2), so
+  // sigma^2 = P * fs / (2 * Rb * Eb/N0)
+  const double eb_n0 = std::pow(10.0, settings_.eb_n0_db / 10.0);
+  noise_level_ = std::sqrt(signal_power * AUDIO_SAMPLE_RATE /
+                           (2.0 * settings_.bit_rate * eb_n0));
+  for (double &sample : signal) {
+    sample += noise_level_ * gaussian();
+  }
+}
+
+double ChannelSimulator::uniform() {
+  // std::uniform_real_distribution is implementation defined, this isn't
+  return (static_cast<double>(random_()) + 0.5) / 4294967296.0;
+}
+
+double ChannelSimulator::gaussian() {
+  return std::sqrt(-2.0 * std::log(uniform())) *
+         std::cos(TWO_PI_VAL * uniform());
+}
+
+} // namespace signal_easel
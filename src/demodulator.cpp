@@ -19,6 +19,7 @@
 
 #include <SignalEasel/demodulator.hpp>
 #include <SignalEasel/exception.hpp>
+#include <SignalEasel/pcm_stream.hpp>
 
 namespace signal_easel {
 
@@ -35,4 +36,9 @@ void Demodulator::loadAudioFromFile(const std::string &file_name) {
   }
 }
 
+void Demodulator::loadAudioFromPcmStream(PcmStreamReader &reader) {
+  audio_buffer_.clear();
+  reader.readAll(audio_buffer_);
+}
+
 } // namespace signal_easel
@@ -0,0 +1,241 @@
+/**
+ * =*========SignalEasel========*=
+ * A friendly library for signal modulation and demodulation.
+ * https://github.com/joshua-jerred/Giraffe
+ * https://joshuajer.red/signal-easel
+ * =*===========================*=
+ *
+ * @file   fft.cpp
+ * @date   2026-10-19
+ * @brief  Radix-2/4 real FFT implementation
+ *
+ * =*=======================*=
+ * @copyright  2026 Joshua Jerred
+ * @license    GNU GPLv3
+ */
+
+#include <cmath>
+#include <map>
+#include <mutex>
+
+#include <SignalEasel/constants.hpp>
+#include <SignalEasel/exception.hpp>
+
+#include "fft.hpp"
+
+namespace signal_easel {
+
+namespace {
+
+/**
+ * @brief The butterflies of one group of a radix-4 stage, two radix-2 stages
+ * fused so the four points are loaded and stored once. The second stage's
+ * twiddles are w2 and -j w2.
+ * @details The quarters of the group never overlap, saying so with restrict
+ * lets the compiler run the loop over k in SIMD registers.
+ * @param span The length of each quarter, m
+ * @param w1_re,w1_im e^(-j 2 pi k / 2m), the first stage's twiddles
+ * @param w2_re,w2_im e^(-j 2 pi k / 4m), the second stage's twiddles
+ */
+void radix4Butterflies(size_t span, const float *__restrict w1_re,
+                       const float *__restrict w1_im,
+                       const float *__restrict w2_re,
+                       const float *__restrict w2_im, float *__restrict re0,
+                       float *__restrict im0, float *__restrict re1,
+                       float *__restrict im1, float *__restrict re2,
+                       float *__restrict im2, float *__restrict re3,
+                       float *__restrict im3) {
+  for (size_t k = 0; k < span; k++) {
+    float t_re = w1_re[k] * re1[k] - w1_im[k] * im1[k];
+    float t_im = w1_re[k] * im1[k] + w1_im[k] * re1[k];
+    const float b0_re = re0[k] + t_re;
+    const float b0_im = im0[k] + t_im;
+    const float b1_re = re0[k] - t_re;
+    const float b1_im = im0[k] - t_im;
+
+    t_re = w1_re[k] * re3[k] - w1_im[k] * im3[k];
+    t_im = w1_re[k] * im3[k] + w1_im[k] * re3[k];
+    const float b2_re = re2[k] + t_re;
+    const float b2_im = im2[k] + t_im;
+    const float b3_re = re2[k] - t_re;
+    const float b3_im = im2[k] - t_im;
+
+    t_re = w2_re[k] * b2_re - w2_im[k] * b2_im;
+    t_im = w2_re[k] * b2_im + w2_im[k] * b2_re;
+    re0[k] = b0_re + t_re;
+    im0[k] = b0_im + t_im;
+    re2[k] = b0_re - t_re;
+    im2[k] = b0_im - t_im;
+
+    // -j (w2 b3)
+    t_re = w2_re[k] * b3_im + w2_im[k] * b3_re;
+    t_im = w2_im[k] * b3_im - w2_re[k] * b3_re;
+    re1[k] = b1_re + t_re;
+    im1[k] = b1_im + t_im;
+    re3[k] = b1_re - t_re;
+    im3[k] = b1_im - t_im;
+  }
+}
+
+} // namespace
+
+struct RealFft::Plan {
+  /// @brief The length of the complex transform, half the real one
+  size_t length = 0;
+
+  /// @brief Where each packed sample goes so the stages run in order
+  std::vector<uint32_t> bit_reverse{};
+
+  /// @brief True if the first stage is radix-2, when log2(length) is odd
+  bool radix_2_stage = false;
+
+  /// @brief For each radix-4 stage of span m, e^(-j 2 pi k / 2m) then
+  /// e^(-j 2 pi k / 4m) for k = 0..m-1, the stages one after another
+  std::vector<float> twiddle_real{};
+  std::vector<float> twiddle_imaginary{};
+
+  /// @brief e^(-j 2 pi k / 2 length), to split the packed transform into
+  /// the real one
+  std::vector<float> split_real{};
+  std::vector<float> split_imaginary{};
+};
+
+std::shared_ptr<const RealFft::Plan> RealFft::getPlan(size_t size) {
+  static std::mutex mutex;
+  static std::map<size_t, std::shared_ptr<const Plan>> plans;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  auto &cached = plans[size];
+  if (cached != nullptr) {
+    return cached;
+  }
+
+  auto plan = std::make_shared<Plan>();
+  const size_t length = size / 2;
+  plan->length = length;
+
+  uint32_t bits = 0;
+  while ((size_t{1} << bits) < length) {
+    bits++;
+  }
+  plan->bit_reverse.resize(length);
+  for (size_t i = 0; i < length; i++) {
+    uint32_t reversed = 0;
+    for (uint32_t bit = 0; bit < bits; bit++) {
+      reversed |= ((i >> bit) & 1U) << (bits - 1 - bit);
+    }
+    plan->bit_reverse[i] = reversed;
+  }
+
+  plan->radix_2_stage = bits % 2 == 1;
+  for (size_t span = plan->radix_2_stage ? 2 : 1; span < length; span *= 4) {
+    for (size_t stage_length : {2 * span, 4 * span}) {
+      for (size_t k = 0; k < span; k++) {
+        const double angle = -TWO_PI_VAL * k / stage_length;
+        plan->twiddle_real.push_back(static_cast<float>(std::cos(angle)));
+        plan->twiddle_imaginary.push_back(static_cast<float>(std::sin(angle)));
+      }
+    }
+  }
+
+  plan->split_real.resize(length + 1);
+  plan->split_imaginary.resize(length + 1);
+  for (size_t k = 0; k <= length; k++) {
+    const double angle = -TWO_PI_VAL * k / size;
+    plan->split_real[k] = static_cast<float>(std::cos(angle));
+    plan->split_imaginary[k] = static_cast<float>(std::sin(angle));
+  }
+
+  cached = std::move(plan);
+  return cached;
+}
+
+RealFft::RealFft(size_t size)
+    : size_(size), plan_(), real_(), imaginary_(), bin_real_(),
+      bin_imaginary_() {
+  validate(isValidSize(size),
+           "The FFT size must be a power of two from FFT_MIN_SIZE to "
+           "FFT_MAX_SIZE");
+  plan_ = getPlan(size);
+  real_.resize(plan_->length);
+  imaginary_.resize(plan_->length);
+  bin_real_.resize(getNumBins());
+  bin_imaginary_.resize(getNumBins());
+}
+
+void RealFft::transformPacked(const float *input) {
+  const size_t length = plan_->length;
+  float *re = real_.data();
+  float *im = imaginary_.data();
+
+  for (size_t i = 0; i < length; i++) {
+    const uint32_t to = plan_->bit_reverse[i];
+    re[to] = input[2 * i];
+    im[to] = input[2 * i + 1];
+  }
+
+  size_t span = 1;
+  if (plan_->radix_2_stage) {
+    for (size_t i = 0; i < length; i += 2) {
+      const float r = re[i + 1];
+      const float m = im[i + 1];
+      re[i + 1] = re[i] - r;
+      im[i + 1] = im[i] - m;
+      re[i] += r;
+      im[i] += m;
+    }
+    span = 2;
+  }
+
+  const float *twiddle_re = plan_->twiddle_real.data();
+  const float *twiddle_im = plan_->twiddle_imaginary.data();
+  for (; span < length; span *= 4) {
+    for (size_t group = 0; group < length; group += 4 * span) {
+      float *group_re = re + group;
+      float *group_im = im + group;
+      radix4Butterflies(span, twiddle_re, twiddle_im, twiddle_re + span,
+                        twiddle_im + span, group_re, group_im,
+                        group_re + span, group_im + span,
+                        group_re + 2 * span, group_im + 2 * span,
+                        group_re + 3 * span, group_im + 3 * span);
+    }
+    twiddle_re += 2 * span;
+    twiddle_im += 2 * span;
+  }
+}
+
+void RealFft::transform(const float *input, float *real, float *imaginary) {
+  transformPacked(input);
+
+  // Z[k] holds the even samples' transform E[k] in it's conjugate symmetric
+  // part and the odd samples' O[k] in the rest, X[k] = E[k] + W^k O[k].
+  const size_t length = plan_->length;
+  const float *split_re = plan_->split_real.data();
+  const float *split_im = plan_->split_imaginary.data();
+  for (size_t k = 0; k <= length; k++) {
+    const size_t forward = k == length ? 0 : k;
+    const size_t mirror = k == 0 ? 0 : length - k;
+    const float z_re = real_[forward];
+    const float z_im = imaginary_[forward];
+    const float c_re = real_[mirror];
+    const float c_im = -imaginary_[mirror];
+
+    const float even_re = 0.5F * (z_re + c_re);
+    const float even_im = 0.5F * (z_im + c_im);
+    const float odd_re = 0.5F * (z_im - c_im);
+    const float odd_im = -0.5F * (z_re - c_re);
+
+    real[k] = even_re + split_re[k] * odd_re - split_im[k] * odd_im;
+    imaginary[k] = even_im + split_re[k] * odd_im + split_im[k] * odd_re;
+  }
+}
+
+void RealFft::power(const float *input, float *power) {
+  transform(input, bin_real_.data(), bin_imaginary_.data());
+  for (size_t k = 0; k < bin_real_.size(); k++) {
+    power[k] = bin_real_[k] * bin_real_[k] +
+               bin_imaginary_[k] * bin_imaginary_[k];
+  }
+}
+
+} // namespace signal_easel
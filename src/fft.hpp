@@ -0,0 +1,104 @@
+/**
+ * =*========SignalEasel========*=
+ * A friendly library for signal modulation and demodulation.
+ * https://github.com/joshua-jerred/Giraffe
+ * https://joshuajer.red/signal-easel
+ * =*===========================*=
+ *
+ * @file   fft.hpp
+ * @date   2026-10-19
+ * @brief  Radix-2/4 real FFT
+ *
+ * =*=======================*=
+ * @copyright  2026 Joshua Jerred
+ * @license    GNU GPLv3
+ */
+
+#ifndef SIGNAL_EASEL_FFT_HPP_
+#define SIGNAL_EASEL_FFT_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace signal_easel {
+
+/// @brief The smallest and largest transforms RealFft will plan
+inline constexpr size_t FFT_MIN_SIZE = 8;
+inline constexpr size_t FFT_MAX_SIZE = 1 << 20;
+
+/**
+ * @brief A forward FFT of real samples, for power of two lengths.
+ * @details The N real samples are packed into N/2 complex ones (even samples
+ * real, odd samples imaginary), transformed with radix-4 stages (and one
+ * radix-2 stage when log2(N/2) is odd), then split into the N/2 + 1 bins of
+ * the real transform.
+ *
+ * The real and imaginary parts are kept in separate arrays and each stage
+ * runs it's butterflies over contiguous runs of them, so the compiler turns
+ * them into SIMD instructions without any intrinsics.
+ *
+ * The bit reversal and twiddle tables are planned once per length and shared
+ * by every RealFft of that length, on any thread. Each RealFft has it's own
+ * work buffers, so one instance should not be used on two threads at once.
+ */
+class RealFft {
+public:
+  /**
+   * @brief Constructor
+   * @param size The number of real samples, a power of two between
+   * FFT_MIN_SIZE and FFT_MAX_SIZE
+   * @exception signal_easel::Exception VALIDATION_ERROR
+   */
+  explicit RealFft(size_t size);
+
+  /**
+   * @brief Transform size real samples.
+   * @param input The samples
+   * @param real (out) The real part of the size / 2 + 1 bins
+   * @param imaginary (out) The imaginary part of the size / 2 + 1 bins
+   */
+  void transform(const float *input, float *real, float *imaginary);
+
+  /**
+   * @brief Transform size real samples and keep the power, |X[k]|^2, of each
+   * of the size / 2 + 1 bins.
+   * @param input The samples
+   * @param power (out) The power of each bin
+   */
+  void power(const float *input, float *power);
+
+  size_t getSize() const { return size_; }
+  size_t getNumBins() const { return size_ / 2 + 1; }
+
+  /// @brief True if RealFft can be planned for this many samples
+  static bool isValidSize(size_t size) {
+    return size >= FFT_MIN_SIZE && size <= FFT_MAX_SIZE &&
+           (size & (size - 1)) == 0;
+  }
+
+private:
+  struct Plan;
+
+  /// @brief The plan for a length, made on first use and cached
+  static std::shared_ptr<const Plan> getPlan(size_t size);
+
+  /// @brief The complex FFT of the packed samples in real_/imaginary_
+  void transformPacked(const float *input);
+
+  size_t size_;
+  std::shared_ptr<const Plan> plan_;
+
+  /// @brief The N/2 packed samples, transformed in place
+  std::vector<float> real_;
+  std::vector<float> imaginary_;
+
+  /// @brief The bins, for power()
+  std::vector<float> bin_real_;
+  std::vector<float> bin_imaginary_;
+};
+
+} // namespace signal_easel
+
+#endif /* SIGNAL_EASEL_FFT_HPP_ */
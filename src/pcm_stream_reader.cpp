@@ -0,0 +1,187 @@
+/**
+ * =*========SignalEasel========*=
+ * A friendly library for signal modulation and demodulation.
+ * https://github.com/joshua-jerred/Giraffe
+ * https://joshuajer.red/signal-easel
+ * =*===========================*=
+ *
+ * @file   pcm_stream_reader.cpp
+ * @date   2026-10-19
+ * @brief  Raw PCM stream reader implementation
+ *
+ * =*=======================*=
+ * @copyright  2026 Joshua Jerred
+ * @license    GNU GPLv3
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+
+#include <poll.h>
+#include <unistd.h>
+
+#include <SignalEasel/exception.hpp>
+#include <SignalEasel/pcm_stream.hpp>
+
+namespace signal_easel {
+
+PcmStreamReader::PcmStreamReader(int file_descriptor, uint32_t sample_rate,
+                                 size_t buffer_size)
+    : file_descriptor_(file_descriptor), sample_rate_(sample_rate),
+      buffer_size_(buffer_size),
+      resampler_(sample_rate == 0 ? AUDIO_SAMPLE_RATE : sample_rate,
+                 AUDIO_SAMPLE_RATE) {
+  if (sample_rate_ == 0) {
+    throw Exception(Exception::Id::PCM_STREAM_INVALID_SAMPLE_RATE,
+                    std::to_string(sample_rate_));
+  }
+  validate(buffer_size_ > 0, "PCM stream buffer size must be non-zero");
+
+  audio_buffer_.reserve(buffer_size_);
+}
+
+bool PcmStreamReader::process() {
+  if (block_complete_) {
+    audio_buffer_.clear();
+    block_complete_ = false;
+  }
+
+  while (audio_buffer_.size() < buffer_size_) {
+    // Hand out anything that has already been resampled
+    if (resampled_start_ < resampled_.size()) {
+      const size_t count = std::min(resampled_.size() - resampled_start_,
+                                    buffer_size_ - audio_buffer_.size());
+      audio_buffer_.insert(audio_buffer_.end(),
+                           resampled_.begin() + resampled_start_,
+                           resampled_.begin() + resampled_start_ + count);
+      resampled_start_ += count;
+      continue;
+    }
+
+    if (read_end_ - read_start_ < sizeof(int16_t)) {
+      if (fillReadBuffer()) {
+        continue;
+      }
+      if (end_of_stream_ && !resampler_.isPassthrough() &&
+          !resampler_flushed_) {
+        // Emit the samples still held back by the filter delay
+        resampler_flushed_ = true;
+        resampled_.clear();
+        resampled_start_ = 0;
+        resampler_.flush(resampled_);
+        continue;
+      }
+      break;
+    }
+
+    if (resampler_.isPassthrough()) {
+      decodeSamples(audio_buffer_, buffer_size_ - audio_buffer_.size());
+    } else {
+      input_samples_.clear();
+      decodeSamples(input_samples_, read_buffer_.size());
+      resampled_.clear();
+      resampled_start_ = 0;
+      resampler_.process(input_samples_, resampled_);
+    }
+  }
+
+  const bool full_block = audio_buffer_.size() == buffer_size_;
+  const bool last_block = end_of_stream_ && !audio_buffer_.empty();
+  if (!full_block && !last_block) {
+    return false;
+  }
+
+  block_complete_ = true;
+  total_samples_ += audio_buffer_.size();
+  updateLevels();
+  return true;
+}
+
+void PcmStreamReader::decodeSamples(std::vector<int16_t> &output,
+                                    size_t max_samples) {
+  const size_t num_samples =
+      std::min((read_end_ - read_start_) / sizeof(int16_t), max_samples);
+  const uint8_t *bytes = read_buffer_.data() + read_start_;
+  for (size_t i = 0; i < num_samples; i++) {
+    output.push_back(
+        static_cast<int16_t>(static_cast<uint16_t>(bytes[2 * i]) |
+                             static_cast<uint16_t>(bytes[2 * i + 1] << 8)));
+  }
+  read_start_ += num_samples * sizeof(int16_t);
+}
+
+void PcmStreamReader::readAll(std::vector<int16_t> &output) {
+  while (!end_of_stream_) {
+    if (process()) {
+      output.insert(output.end(), audio_buffer_.begin(), audio_buffer_.end());
+    } else if (!end_of_stream_) {
+      // A non-blocking file descriptor ran dry
+      waitForData();
+    }
+  }
+}
+
+void PcmStreamReader::waitForData() {
+  pollfd poll_fd{};
+  poll_fd.fd = file_descriptor_;
+  poll_fd.events = POLLIN;
+  // Hang ups and errors wake poll() up too, the next read() reports them
+  while (::poll(&poll_fd, 1, -1) < 0) {
+    if (errno != EINTR) {
+      throw Exception(Exception::Id::PCM_STREAM_READ_ERROR,
+                      std::strerror(errno));
+    }
+  }
+}
+
+bool PcmStreamReader::fillReadBuffer() {
+  if (end_of_stream_) {
+    return false;
+  }
+
+  // Keep a dangling half sample, if there is one, at the front of the buffer
+  const size_t leftover = read_end_ - read_start_;
+  if (leftover > 0) {
+    std::memmove(read_buffer_.data(), read_buffer_.data() + read_start_,
+                 leftover);
+  }
+  read_start_ = 0;
+  read_end_ = leftover;
+
+  ssize_t res = ::read(file_descriptor_, read_buffer_.data() + read_end_,
+                       read_buffer_.size() - read_end_);
+  if (res > 0) {
+    read_end_ += static_cast<size_t>(res);
+    return true;
+  }
+  if (res == 0) {
+    end_of_stream_ = true;
+    return false;
+  }
+  if (errno == EINTR) {
+    return true;
+  }
+  if (errno == EAGAIN || errno == EWOULDBLOCK) {
+    return false;
+  }
+
+  throw Exception(Exception::Id::PCM_STREAM_READ_ERROR, std::strerror(errno));
+}
+
+void PcmStreamReader::updateLevels() {
+  uint64_t sum_of_squares = 0;
+  for (int16_t sample : audio_buffer_) {
+    sum_of_squares +=
+        static_cast<int64_t>(sample) * static_cast<int64_t>(sample);
+  }
+  rms_ = static_cast<uint32_t>(
+      std::sqrt(static_cast<double>(sum_of_squares) / audio_buffer_.size()));
+  volume_ = (static_cast<double>(rms_) / 32768.0) / 0.72;
+  if (volume_ < 0.01) {
+    volume_ = 0;
+  }
+}
+
+} // namespace signal_easel
@@ -0,0 +1,94 @@
+/**
+ * =*========SignalEasel========*=
+ * A friendly library for signal modulation and demodulation.
+ * https://github.com/joshua-jerred/Giraffe
+ * https://joshuajer.red/signal-easel
+ * =*===========================*=
+ *
+ * @file   pcm_stream_writer.cpp
+ * @date   2026-10-19
+ * @brief  Raw PCM stream writer implementation
+ *
+ * =*=======================*=
+ * @copyright  2026 Joshua Jerred
+ * @license    GNU GPLv3
+ */
+
+#include <cerrno>
+#include <cstring>
+
+#include <unistd.h>
+
+#include <SignalEasel/exception.hpp>
+#include <SignalEasel/modulator.hpp>
+#include <SignalEasel/pcm_stream.hpp>
+
+namespace signal_easel {
+
+PcmStreamWriter::PcmStreamWriter(int file_descriptor, uint32_t sample_rate)
+    : file_descriptor_(file_descriptor), sample_rate_(sample_rate),
+      resampler_(AUDIO_SAMPLE_RATE,
+                 sample_rate == 0 ? AUDIO_SAMPLE_RATE : sample_rate) {
+  if (sample_rate_ == 0) {
+    throw Exception(Exception::Id::PCM_STREAM_INVALID_SAMPLE_RATE,
+                    std::to_string(sample_rate_));
+  }
+}
+
+void PcmStreamWriter::write(const int16_t *samples, size_t num_samples) {
+  if (resampler_.isPassthrough()) {
+    writeSamples(samples, num_samples);
+    return;
+  }
+
+  resampled_.clear();
+  resampler_.process(samples, num_samples, resampled_);
+  writeSamples(resampled_.data(), resampled_.size());
+}
+
+void PcmStreamWriter::flush() {
+  if (resampler_.isPassthrough()) {
+    return;
+  }
+
+  resampled_.clear();
+  resampler_.flush(resampled_);
+  writeSamples(resampled_.data(), resampled_.size());
+}
+
+void PcmStreamWriter::writeSamples(const int16_t *samples,
+                                   size_t num_samples) {
+  write_buffer_.resize(num_samples * sizeof(int16_t));
+  for (size_t i = 0; i < num_samples; i++) {
+    const uint16_t sample = static_cast<uint16_t>(samples[i]);
+    write_buffer_[2 * i] = static_cast<uint8_t>(sample & 0xFF);
+    write_buffer_[2 * i + 1] = static_cast<uint8_t>(sample >> 8);
+  }
+  flushWriteBuffer();
+  total_samples_ += num_samples;
+}
+
+void PcmStreamWriter::flushWriteBuffer() {
+  size_t written = 0;
+  while (written < write_buffer_.size()) {
+    ssize_t res = ::write(file_descriptor_, write_buffer_.data() + written,
+                          write_buffer_.size() - written);
+    if (res < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw Exception(Exception::Id::PCM_STREAM_WRITE_ERROR,
+                      std::strerror(errno));
+    }
+    written += static_cast<size_t>(res);
+  }
+}
+
+void Modulator::writeToPcmStream(PcmStreamWriter &writer) {
+  if (audio_buffer_.empty()) {
+    throw Exception(Exception::Id::NO_DATA_TO_WRITE);
+  }
+  writer.write(audio_buffer_);
+}
+
+} // namespace signal_easel
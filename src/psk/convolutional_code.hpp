@@ -16,13 +16,73 @@
 
 #pragma once
 
+#include <array>
 #include <cstdint>
-#include <map>
 
 #include "psk_wave_shaper.hpp"
 
 namespace signal_easel::psk {
 
+/**
+ * @brief The phase shifts the convolutional code can send.
+ */
+enum class Shift : uint8_t {
+  ZERO = 0,
+  PI_OVER_TWO = 1,
+  MINUS_PI_OVER_TWO = 2,
+  PI = 3
+};
+
+/**
+ * @brief The phase shift for each five bit value of the shift register.
+ */
+inline constexpr std::array<Shift, 32> CONVOLUTIONAL_CODE = {
+    Shift::PI,                Shift::PI_OVER_TWO,       // 0b00000, 0b00001
+    Shift::MINUS_PI_OVER_TWO, Shift::ZERO,              // 0b00010, 0b00011
+    Shift::MINUS_PI_OVER_TWO, Shift::ZERO,              // 0b00100, 0b00101
+    Shift::PI,                Shift::PI_OVER_TWO,       // 0b00110, 0b00111
+    Shift::ZERO,              Shift::MINUS_PI_OVER_TWO, // 0b01000, 0b01001
+    Shift::PI_OVER_TWO,       Shift::PI,                // 0b01010, 0b01011
+    Shift::PI_OVER_TWO,       Shift::PI,                // 0b01100, 0b01101
+    Shift::ZERO,              Shift::MINUS_PI_OVER_TWO, // 0b01110, 0b01111
+    Shift::PI_OVER_TWO,       Shift::PI,                // 0b10000, 0b10001
+    Shift::ZERO,              Shift::MINUS_PI_OVER_TWO, // 0b10010, 0b10011
+    Shift::ZERO,              Shift::MINUS_PI_OVER_TWO, // 0b10100, 0b10101
+    Shift::PI_OVER_TWO,       Shift::PI,                // 0b10110, 0b10111
+    Shift::MINUS_PI_OVER_TWO, Shift::ZERO,              // 0b11000, 0b11001
+    Shift::PI,                Shift::PI_OVER_TWO,       // 0b11010, 0b11011
+    Shift::PI,                Shift::PI_OVER_TWO,       // 0b11100, 0b11101
+    Shift::MINUS_PI_OVER_TWO, Shift::ZERO};             // 0b11110, 0b11111
+
+/**
+ * @brief Each shift as quarter turns, in the direction of Phase.
+ */
+inline constexpr std::array<uint8_t, 4> SHIFT_QUARTER_TURNS = {0, 1, 3, 2};
+
+/**
+ * @brief Each shift as a unit vector, {cos, sin} of the shift. A decoder's
+ * branch metric is the received phase change correlated with this.
+ */
+inline constexpr std::array<std::array<int8_t, 2>, 4> SHIFT_VECTORS = {
+    {{1, 0}, {0, 1}, {0, -1}, {-1, 0}}};
+
+/**
+ * @brief The phase after each five bit value of the shift register, indexed
+ * [code][current phase].
+ */
+inline constexpr std::array<std::array<Phase, 4>, 32>
+    CONVOLUTIONAL_CODE_PHASE_TABLE = []() {
+      std::array<std::array<Phase, 4>, 32> table{};
+      for (size_t code = 0; code < table.size(); code++) {
+        const uint8_t turns = SHIFT_QUARTER_TURNS[static_cast<uint8_t>(
+            CONVOLUTIONAL_CODE[code])];
+        for (uint8_t phase = 0; phase < 4; phase++) {
+          table[code][phase] = static_cast<Phase>((phase + turns) % 4);
+        }
+      }
+      return table;
+    }();
+
 /**
  * @brief Given a five bit value, return the phase shift for the convolutional
  * code.
@@ -38,6 +98,10 @@ double getConvolutionalCodeShift(uint8_t code);
  * @param current_phase - The current phase
  * @return Phase - The current phase shifted by the convolutional code
  */
-Phase getShiftedConvolutionalCodePhase(uint8_t code, Phase current_phase);
+constexpr Phase getShiftedConvolutionalCodePhase(uint8_t code,
+                                                 Phase current_phase) {
+  return CONVOLUTIONAL_CODE_PHASE_TABLE[code & 0x1f]
+                                       [static_cast<uint8_t>(current_phase)];
+}
 
 } // namespace signal_easel::psk
\ No newline at end of file
@@ -0,0 +1,321 @@
+/**
+ * =*========SignalEasel========*=
+ * A friendly library for signal modulation and demodulation.
+ * https://github.com/joshua-jerred/Giraffe
+ * https://joshuajer.red/signal-easel
+ * =*===========================*=
+ *
+ * @file   psk_channelizer.cpp
+ * @date   2026-10-19
+ * @brief  Demodulates every PSK carrier in the passband
+ *
+ * =*=======================*=
+ * @copyright  2026 Joshua Jerred
+ * @license    GNU GPLv3
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+#include <SignalEasel/constants.hpp>
+#include <SignalEasel/exception.hpp>
+#include <SignalEasel/psk.hpp>
+
+namespace signal_easel::psk {
+
+namespace {
+
+constexpr uint32_t BIN_WIDTH =
+    AUDIO_SAMPLE_RATE / Channelizer::SPECTRUM_LENGTH;
+
+/// @brief The median of noise power in a bin is ln(2) of it's mean
+constexpr double MEDIAN_TO_MEAN = 1.0 / 0.69314718055994531;
+
+/// @brief Half the symbol rate covers the tones of a phase reversal on either
+/// side of the carrier, plus a bin for the window's leakage
+uint32_t getBandHalfWidth(const ChannelizerSettings &settings) {
+  const double symbol_rate = getSymbolRate(settings.symbol_rate);
+  return static_cast<uint32_t>(std::ceil(symbol_rate / 2 / BIN_WIDTH)) + 1;
+}
+
+uint32_t getFirstBin(const ChannelizerSettings &settings) {
+  const uint32_t lowest = settings.min_frequency / BIN_WIDTH;
+  const uint32_t half_width = getBandHalfWidth(settings);
+  return lowest > half_width ? lowest - half_width : 1;
+}
+
+uint32_t getNumBins(const ChannelizerSettings &settings) {
+  const uint32_t first_bin = getFirstBin(settings);
+  const uint32_t last_bin =
+      std::min(Channelizer::SPECTRUM_LENGTH / 2 - 1,
+               (settings.max_frequency + BIN_WIDTH - 1) / BIN_WIDTH +
+                   getBandHalfWidth(settings));
+  return last_bin >= first_bin ? last_bin - first_bin + 1 : 0;
+}
+
+} // namespace
+
+Channelizer::Channelizer(ChannelizerSettings settings)
+    : settings_(std::move(settings)), first_bin_(getFirstBin(settings_)),
+      num_bins_(getNumBins(settings_)),
+      band_half_width_(getBandHalfWidth(settings_)) {
+  validate(settings_.min_frequency > 0 &&
+               settings_.min_frequency < settings_.max_frequency &&
+               settings_.max_frequency < AUDIO_SAMPLE_RATE / 2,
+           "The channelizer passband must be within the audio band");
+  validate(settings_.detection_interval >= SPECTRUM_LENGTH,
+           "The detection interval must be at least SPECTRUM_LENGTH");
+  validate(settings_.max_channels > 0, "max_channels must be at least 1");
+
+  window_.resize(SPECTRUM_LENGTH);
+  for (uint32_t i = 0; i < SPECTRUM_LENGTH; i++) {
+    window_[i] = static_cast<float>(
+        0.5 - 0.5 * std::cos(TWO_PI_VAL * i / SPECTRUM_LENGTH));
+  }
+  coefficients_.resize(num_bins_);
+  for (uint32_t i = 0; i < num_bins_; i++) {
+    coefficients_[i] = static_cast<float>(
+        2.0 * std::cos(TWO_PI_VAL * (first_bin_ + i) / SPECTRUM_LENGTH));
+  }
+  power_.resize(num_bins_);
+  spectrum_samples_.reserve(SPECTRUM_LENGTH);
+}
+
+void Channelizer::process(const int16_t *samples, size_t num_samples) {
+  // The audio is split where the spectrum is complete, so carriers found in
+  // it are demodulated from the next sample on.
+  while (num_samples > 0) {
+    const bool in_spectrum = interval_position_ < SPECTRUM_LENGTH;
+    const uint32_t end =
+        in_spectrum ? SPECTRUM_LENGTH : settings_.detection_interval;
+    const size_t length =
+        std::min<size_t>(num_samples, end - interval_position_);
+
+    if (in_spectrum) {
+      spectrum_samples_.insert(spectrum_samples_.end(), samples,
+                               samples + length);
+    }
+    demodulate(samples, length);
+    samples += length;
+    num_samples -= length;
+    interval_position_ += static_cast<uint32_t>(length);
+
+    if (in_spectrum && interval_position_ == SPECTRUM_LENGTH) {
+      detectCarriers();
+    }
+    if (interval_position_ >= settings_.detection_interval) {
+      interval_position_ = 0;
+      spectrum_samples_.clear();
+    }
+  }
+}
+
+void Channelizer::demodulate(const int16_t *samples, size_t num_samples) {
+  const size_t num_threads =
+      std::min<size_t>(std::max(settings_.threads, 1U), channels_.size());
+  if (num_threads <= 1) {
+    for (ChannelState &channel : channels_) {
+      channel.demodulator.process(samples, num_samples);
+    }
+    return;
+  }
+
+  // Each thread demodulates a contiguous run of the channels
+  std::vector<std::thread> threads;
+  threads.reserve(num_threads);
+  for (size_t worker = 0; worker < num_threads; worker++) {
+    const size_t first = channels_.size() * worker / num_threads;
+    const size_t last = channels_.size() * (worker + 1) / num_threads;
+    threads.emplace_back([this, samples, num_samples, first, last]() {
+      for (size_t i = first; i < last; i++) {
+        channels_[i].demodulator.process(samples, num_samples);
+      }
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+}
+
+void Channelizer::measureSpectrum() {
+  // A Goertzel filter per bin, run across all of the bins for each sample so
+  // the bins are independent lanes for the vectorizer.
+  std::vector<float> s1(num_bins_, 0.0F);
+  std::vector<float> s2(num_bins_, 0.0F);
+  for (uint32_t n = 0; n < SPECTRUM_LENGTH; n++) {
+    const float sample = window_[n] * spectrum_samples_[n];
+    for (uint32_t i = 0; i < num_bins_; i++) {
+      const float s = sample + coefficients_[i] * s1[i] - s2[i];
+      s2[i] = s1[i];
+      s1[i] = s;
+    }
+  }
+  for (uint32_t i = 0; i < num_bins_; i++) {
+    power_[i] =
+        s1[i] * s1[i] + s2[i] * s2[i] - coefficients_[i] * s1[i] * s2[i];
+  }
+}
+
+void Channelizer::detectCarriers() {
+  measureSpectrum();
+
+  // Carriers are searched for between these bins, the rest of power_ is the
+  // band around carriers at the edges.
+  const uint32_t first_center =
+      std::max(first_bin_ + band_half_width_,
+               (settings_.min_frequency + BIN_WIDTH - 1) / BIN_WIDTH);
+  const uint32_t last_center =
+      std::min(first_bin_ + num_bins_ - 1 - band_half_width_,
+               settings_.max_frequency / BIN_WIDTH);
+  if (first_center > last_center) {
+    return;
+  }
+
+  std::vector<float> passband(power_.begin() + (first_center - first_bin_),
+                              power_.begin() + (last_center - first_bin_) + 1);
+  std::nth_element(passband.begin(), passband.begin() + passband.size() / 2,
+                   passband.end());
+  const double noise_band = passband[passband.size() / 2] * MEDIAN_TO_MEAN *
+                            (2 * band_half_width_ + 1);
+  const double threshold =
+      noise_band * std::pow(10.0, settings_.detection_threshold_db / 10.0);
+
+  // The power in the band around each bin, a running sum
+  std::vector<double> band(num_bins_, 0.0);
+  double sum = 0.0;
+  for (uint32_t i = 0; i < num_bins_; i++) {
+    sum += power_[i];
+    if (i >= 2 * band_half_width_ + 1) {
+      sum -= power_[i - 2 * band_half_width_ - 1];
+    }
+    if (i >= 2 * band_half_width_) {
+      band[i - band_half_width_] = sum;
+    }
+  }
+
+  struct Peak {
+    double frequency;
+    double power;
+  };
+  std::vector<Peak> peaks;
+  for (uint32_t bin = first_center; bin <= last_center; bin++) {
+    const uint32_t center = bin - first_bin_;
+    if (band[center] < threshold) {
+      continue;
+    }
+    // The highest band within half a band either side, the first of a tie
+    bool highest = true;
+    for (uint32_t i = center - band_half_width_;
+         i <= center + band_half_width_ && highest; i++) {
+      highest = i < center ? band[i] < band[center] : band[i] <= band[center];
+    }
+    if (!highest) {
+      continue;
+    }
+    // The centroid of the band is closer to the carrier than the bin
+    double moment = 0.0;
+    for (uint32_t i = center - band_half_width_;
+         i <= center + band_half_width_; i++) {
+      moment += static_cast<double>(power_[i]) * (first_bin_ + i);
+    }
+    peaks.push_back({moment / band[center] * BIN_WIDTH, band[center]});
+  }
+  std::sort(peaks.begin(), peaks.end(), [](const Peak &a, const Peak &b) {
+    return a.power > b.power;
+  });
+
+  const double symbol_rate = getSymbolRate(settings_.symbol_rate);
+  std::vector<bool> seen(channels_.size(), false);
+  std::vector<Peak> accepted;
+  for (const Peak &peak : peaks) {
+    const bool overlaps =
+        std::any_of(accepted.begin(), accepted.end(), [&](const Peak &other) {
+          return std::abs(other.frequency - peak.frequency) < symbol_rate;
+        });
+    if (overlaps) {
+      continue;
+    }
+    accepted.push_back(peak);
+
+    // A carrier within half a symbol rate of a channel is that channel's
+    bool matched = false;
+    for (size_t i = 0; i < channels_.size() && !matched; i++) {
+      const ChannelState &channel = channels_[i];
+      const double tracked = channel.carrier_frequency +
+                             channel.demodulator.getStats().frequency_offset;
+      if (std::abs(tracked - peak.frequency) < symbol_rate / 2) {
+        seen[i] = true;
+        matched = true;
+      }
+    }
+    if (matched || channels_.size() >= settings_.max_channels) {
+      continue;
+    }
+
+    psk::Settings channel_settings = settings_;
+    channel_settings.carrier_frequency =
+        static_cast<uint32_t>(std::lround(peak.frequency));
+    channels_.push_back(ChannelState{next_id_++,
+                                     channel_settings.carrier_frequency,
+                                     Demodulator(channel_settings)});
+    channels_.back().demodulator.process(spectrum_samples_.data(),
+                                         spectrum_samples_.size());
+    seen.push_back(true);
+  }
+
+  for (size_t i = 0; i < channels_.size(); i++) {
+    channels_[i].misses = seen[i] ? 0 : channels_[i].misses + 1;
+  }
+  for (ChannelState &channel : channels_) {
+    if (channel.misses > settings_.channel_timeout) {
+      takeChannelText(channel, false, dropped_);
+    }
+  }
+  channels_.erase(std::remove_if(channels_.begin(), channels_.end(),
+                                 [&](const ChannelState &channel) {
+                                   return channel.misses >
+                                          settings_.channel_timeout;
+                                 }),
+                  channels_.end());
+  std::sort(channels_.begin(), channels_.end(),
+            [](const ChannelState &a, const ChannelState &b) {
+              return a.carrier_frequency < b.carrier_frequency;
+            });
+}
+
+bool Channelizer::takeChannelText(ChannelState &channel, bool active,
+                                  std::vector<Channel> &output) {
+  Channel taken;
+  taken.id = channel.id;
+  taken.stats = channel.demodulator.getStats();
+  taken.frequency = channel.carrier_frequency + taken.stats.frequency_offset;
+  channel.demodulator.takeText(taken.text);
+  taken.active = active;
+  output.push_back(std::move(taken));
+  return !output.back().text.empty();
+}
+
+bool Channelizer::takeText(std::vector<Channel> &output) {
+  output.clear();
+  bool any_text = false;
+  for (ChannelState &channel : channels_) {
+    any_text |= takeChannelText(channel, true, output);
+  }
+  for (Channel &channel : dropped_) {
+    any_text |= !channel.text.empty();
+    output.push_back(std::move(channel));
+  }
+  dropped_.clear();
+  return any_text;
+}
+
+void Channelizer::reset() {
+  channels_.clear();
+  dropped_.clear();
+  spectrum_samples_.clear();
+  interval_position_ = 0;
+  next_id_ = 0;
+}
+
+} // namespace signal_easel::psk
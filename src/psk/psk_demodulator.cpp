@@ -0,0 +1,290 @@
+/**
+ * =*========SignalEasel========*=
+ * A friendly library for signal modulation and demodulation.
+ * https://github.com/joshua-jerred/Giraffe
+ * https://joshuajer.red/signal-easel
+ * =*===========================*=
+ *
+ * @file   psk_demodulator.cpp
+ * @date   2026-10-19
+ * @brief  Phase Shift Keying demodulator
+ *
+ * =*=======================*=
+ * @copyright  2026 Joshua Jerred
+ * @license    GNU GPLv3
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include <SignalEasel/constants.hpp>
+#include <SignalEasel/exception.hpp>
+#include <SignalEasel/psk.hpp>
+
+namespace signal_easel::psk {
+
+namespace {
+
+/// @brief The NCO looks up cos/sin with the top NCO_TABLE_BITS of it's phase
+constexpr uint32_t NCO_TABLE_BITS = 10;
+constexpr uint32_t NCO_TABLE_SIZE = 1 << NCO_TABLE_BITS;
+
+/// @brief One turn of the NCO's phase accumulator
+constexpr double NCO_TURN = 4294967296.0;
+
+/**
+ * @brief One cycle of a cosine, followed by a quarter cycle so the sine is
+ * the same table a quarter turn on.
+ */
+const std::array<float, NCO_TABLE_SIZE + NCO_TABLE_SIZE / 4> &getNcoTable() {
+  static const auto table = []() {
+    std::array<float, NCO_TABLE_SIZE + NCO_TABLE_SIZE / 4> cosine{};
+    for (size_t i = 0; i < cosine.size(); i++) {
+      cosine[i] = static_cast<float>(
+          std::cos(TWO_PI_VAL * static_cast<double>(i) / NCO_TABLE_SIZE));
+    }
+    return cosine;
+  }();
+  return table;
+}
+
+/// @brief The matched filter, the half sine symbol shape sampled at the
+/// middle of each quarter symbol.
+constexpr std::array<float, 4> MATCHED_FILTER = {0.38268343F, 0.92387953F,
+                                                 0.92387953F, 0.38268343F};
+
+/// @brief Costas loop gains per symbol, a second order loop with a natural
+/// frequency of sqrt(0.01) = 0.1 radians per symbol and a damping factor of
+/// 0.14 / (2 * 0.1) = 0.7, slightly underdamped to settle quickly.
+constexpr double COSTAS_PHASE_GAIN = 0.14;
+constexpr double COSTAS_FREQUENCY_GAIN = 0.01;
+
+/// @brief The fraction of the Gardner timing error corrected each symbol
+constexpr double TIMING_GAIN = 0.1;
+
+/// @brief The time constant of the signal quality average, in symbols
+constexpr double QUALITY_AVERAGE_SYMBOLS = 16.0;
+
+/// @brief Offsets the AFC leaves to the Costas loop, as a fraction of the
+/// symbol rate
+constexpr double AFC_DEADBAND = 0.02;
+
+/// @brief How consistent the phase turns must be for the AFC to retune, the
+/// magnitude of their sum over the sum of their magnitudes. The 64 turns in
+/// an AFC period score about 1/8 from noise alone. The turns across a
+/// change of symbol point anywhere, which keeps a clean signal well short of
+/// 1, so the bar sits half way.
+constexpr double AFC_MIN_COHERENCE = 0.5;
+
+} // namespace
+
+Demodulator::Demodulator(psk::Settings settings)
+    : signal_easel::Demodulator(settings), psk_settings_(std::move(settings)),
+      samples_per_symbol_(getSamplesPerSymbol(psk_settings_.symbol_rate)),
+      block_length_(samples_per_symbol_ / BLOCKS_PER_SYMBOL_),
+      nco_step_(static_cast<uint32_t>(
+          NCO_TURN * psk_settings_.carrier_frequency / AUDIO_SAMPLE_RATE)),
+      current_block_length_(block_length_) {
+  validate(psk_settings_.carrier_frequency > 0 &&
+               psk_settings_.carrier_frequency < AUDIO_SAMPLE_RATE / 2,
+           "The PSK carrier must be within the audio band");
+  validate(psk_settings_.afc_range < psk_settings_.carrier_frequency &&
+               psk_settings_.carrier_frequency + psk_settings_.afc_range <
+                   AUDIO_SAMPLE_RATE / 2,
+           "The PSK AFC range must keep the carrier within the audio band");
+}
+
+void Demodulator::process(const int16_t *samples, size_t num_samples) {
+  const auto &table = getNcoTable();
+  constexpr uint32_t INDEX_SHIFT = 32 - NCO_TABLE_BITS;
+  constexpr uint32_t QUARTER_TURN = NCO_TABLE_SIZE / 4;
+
+  // The frequency correction only changes at symbols, so the whole steps of
+  // it are added with the carrier step and the fraction is carried.
+  uint32_t step = 0;
+  auto updateStep = [&]() {
+    const double correction = nco_frequency_offset_ + nco_phase_remainder_;
+    const double whole = std::floor(correction);
+    nco_phase_remainder_ = correction - whole;
+    step = nco_step_ + static_cast<uint32_t>(static_cast<int64_t>(whole));
+  };
+  updateStep();
+
+  for (size_t i = 0; i < num_samples; i++) {
+    const uint32_t index = nco_phase_ >> INDEX_SHIFT;
+    const float sample = static_cast<float>(samples[i]);
+    // Mixed with e^(-j phase), the table a quarter turn on is -sin(phase)
+    block_sum_ += std::complex<float>(sample * table[index],
+                                      sample * table[index + QUARTER_TURN]);
+    nco_phase_ += step;
+
+    if (++block_samples_ >= current_block_length_) {
+      processBlock(block_sum_);
+      block_sum_ = 0.0F;
+      block_samples_ = 0;
+      updateStep();
+    }
+  }
+}
+
+void Demodulator::processBlock(std::complex<float> block) {
+  std::rotate(blocks_.begin(), blocks_.begin() + 1, blocks_.end());
+  blocks_.back() = block;
+  block_index_ = (block_index_ + 1) % BLOCKS_PER_SYMBOL_;
+  current_block_length_ = block_length_;
+  if (psk_settings_.afc_range > 0) {
+    updateAfc(blocks_[BLOCKS_PER_SYMBOL_ - 1] *
+              std::conj(blocks_[BLOCKS_PER_SYMBOL_ - 2]));
+  }
+
+  std::complex<float> filtered{};
+  for (size_t i = 0; i < BLOCKS_PER_SYMBOL_; i++) {
+    filtered += blocks_[i] * MATCHED_FILTER[i];
+  }
+
+  if (block_index_ == BLOCKS_PER_SYMBOL_ / 2) {
+    midpoint_ = filtered;
+  } else if (block_index_ == 0) {
+    processSymbol(filtered);
+  }
+}
+
+void Demodulator::updateAfc(std::complex<float> difference) {
+  // Squaring the phase change takes BPSK's reversals to whole turns, the 4th
+  // power does the same for QPSK's quarter turns, leaving the carrier's turn
+  // per quarter symbol times the power.
+  const int power = psk_settings_.mode == Settings::Mode::QPSK ? 4 : 2;
+  const std::complex<double> turn(difference);
+  const double magnitude = std::abs(turn);
+  // A zero difference (silence) has no direction and adds nothing
+  if (magnitude > 0.0) {
+    afc_turn_ += std::pow(turn / magnitude, power) * magnitude;
+    afc_magnitude_ += magnitude;
+  }
+  if (++afc_blocks_ < AFC_BLOCKS_) {
+    return;
+  }
+
+  const double symbol_rate = getSymbolRate(psk_settings_.symbol_rate);
+  const double offset = std::arg(afc_turn_) / power / TWO_PI_VAL *
+                        AUDIO_SAMPLE_RATE / block_length_;
+  if (std::abs(afc_turn_) > AFC_MIN_COHERENCE * afc_magnitude_ &&
+      std::abs(offset) > AFC_DEADBAND * symbol_rate) {
+    const double range =
+        psk_settings_.afc_range * NCO_TURN / AUDIO_SAMPLE_RATE;
+    nco_frequency_offset_ =
+        std::clamp(nco_frequency_offset_ +
+                       offset * NCO_TURN / AUDIO_SAMPLE_RATE,
+                   -range, range);
+    stats_.frequency_offset =
+        nco_frequency_offset_ * AUDIO_SAMPLE_RATE / NCO_TURN;
+  }
+  afc_turn_ = 0.0;
+  afc_magnitude_ = 0.0;
+  afc_blocks_ = 0;
+}
+
+void Demodulator::processSymbol(std::complex<float> symbol) {
+  stats_.symbols++;
+
+  const float magnitude = std::abs(symbol);
+  const float previous_magnitude = std::abs(previous_symbol_);
+  if (magnitude <= 0.0F || previous_magnitude <= 0.0F) {
+    previous_symbol_ = symbol;
+    return;
+  }
+
+  // Costas loop, the quadrature error from the nearest constellation point,
+  // 0 or 180 degrees for BPSK, or any multiple of 90 degrees for QPSK.
+  double phase_error = 0.0;
+  if (psk_settings_.mode == Settings::Mode::QPSK &&
+      std::abs(symbol.imag()) > std::abs(symbol.real())) {
+    phase_error =
+        (symbol.imag() >= 0.0F ? -symbol.real() : symbol.real()) / magnitude;
+  } else {
+    phase_error =
+        (symbol.real() >= 0.0F ? symbol.imag() : -symbol.imag()) / magnitude;
+  }
+  nco_phase_ += static_cast<uint32_t>(
+      static_cast<int64_t>(COSTAS_PHASE_GAIN * phase_error * NCO_TURN /
+                           TWO_PI_VAL));
+  nco_frequency_offset_ += COSTAS_FREQUENCY_GAIN * phase_error * NCO_TURN /
+                           TWO_PI_VAL / samples_per_symbol_;
+  stats_.frequency_offset =
+      nco_frequency_offset_ * AUDIO_SAMPLE_RATE / NCO_TURN;
+
+  // Gardner timing error, positive when the symbols are sampled late
+  const double power = (magnitude * magnitude +
+                        previous_magnitude * previous_magnitude) / 2.0;
+  const double timing_error =
+      std::real(std::conj(midpoint_) * (symbol - previous_symbol_)) / power;
+  timing_correction_ +=
+      TIMING_GAIN * std::clamp(timing_error, -1.0, 1.0) * block_length_;
+  const int32_t correction = static_cast<int32_t>(timing_correction_);
+  timing_correction_ -= correction;
+  current_block_length_ = block_length_ - correction;
+
+  // The bits are in the phase difference, for BPSK a 0 is a phase reversal
+  const std::complex<float> difference = symbol * std::conj(previous_symbol_);
+  previous_symbol_ = symbol;
+
+  const double difference_magnitude = magnitude * previous_magnitude;
+  double quality = difference.real() / difference_magnitude;
+  if (psk_settings_.mode == Settings::Mode::QPSK) {
+    // cos(2x), 1 for any multiple of 90 degrees
+    quality = (difference.real() * difference.real() -
+               difference.imag() * difference.imag()) /
+              (difference_magnitude * difference_magnitude);
+  }
+  stats_.signal_quality +=
+      (std::abs(quality) - stats_.signal_quality) / QUALITY_AVERAGE_SYMBOLS;
+
+  bool bit = difference.real() > 0.0F;
+  if (psk_settings_.mode == Settings::Mode::QPSK &&
+      !viterbi_decoder_.decode(difference / static_cast<float>(power), bit)) {
+    return;
+  }
+
+  if (stats_.signal_quality < psk_settings_.squelch_level) {
+    varicode_decoder_.reset();
+    return;
+  }
+  processBit(bit);
+}
+
+void Demodulator::processBit(bool bit) {
+  char character = 0;
+  if (varicode_decoder_.decode(bit, character)) {
+    text_.push_back(character);
+    stats_.characters++;
+  }
+}
+
+bool Demodulator::takeText(std::string &output) {
+  output = std::move(text_);
+  text_.clear();
+  return !output.empty();
+}
+
+void Demodulator::reset() {
+  nco_phase_ = 0;
+  nco_frequency_offset_ = 0.0;
+  nco_phase_remainder_ = 0.0;
+  block_sum_ = 0.0F;
+  block_samples_ = 0;
+  current_block_length_ = block_length_;
+  blocks_.fill(0.0F);
+  block_index_ = 0;
+  previous_symbol_ = 0.0F;
+  midpoint_ = 0.0F;
+  timing_correction_ = 0.0;
+  afc_turn_ = 0.0;
+  afc_magnitude_ = 0.0;
+  afc_blocks_ = 0;
+  varicode_decoder_.reset();
+  viterbi_decoder_.reset();
+  text_.clear();
+  stats_ = Stats();
+}
+
+} // namespace signal_easel::psk
@@ -14,39 +14,34 @@
  * @license    GNU GPLv3
  */
 
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 
 #include <BoosterSeat/math.hpp>
-#include <BoosterSeat/template_tools.hpp>
 
 #include <SignalEasel/constants.hpp>
 #include <SignalEasel/psk.hpp>
 
 #include "convolutional_code.hpp"
 #include "psk_wave_shaper.hpp"
+#include "varicode.hpp"
 
 namespace signal_easel::psk {
 
 void Modulator::encodeString(const std::string &message) {
-
-  uint32_t symbol_rate =
-      bst::template_tools::to_underlying(settings_.symbol_rate);
-
   carrier_wave_angle_ = 0.0f;
   last_symbol_end_filtered_ = 1;
 
   angle_delta_ = bst::math::TWO_PI *
                  (static_cast<double>(settings_.carrier_frequency) /
                   static_cast<double>(signal_easel::AUDIO_SAMPLE_RATE));
-  samples_per_symbol_ = signal_easel::AUDIO_SAMPLE_RATE / symbol_rate;
+  samples_per_symbol_ = getSamplesPerSymbol(settings_.symbol_rate);
 
   addPreamble();
   // Encode each character in the message to the BitStream (varicode)
-  static unsigned char zeros[1] = {0x00};
   for (const char &c : message) {
     addVaricode(c);
-    bit_stream_.addBits(zeros, 2);
   }
   addPostamble();
 
@@ -63,25 +58,18 @@ void Modulator::encodeString(const std::string &message) {
 }
 
 void Modulator::addVaricode(const char c) {
-  uint16_t varicode = AsciiToVaricodeArray.at(c);
-  unsigned char bits[2];
-  int previous_bit = 1;
-  for (int i = 0; i < 16; i++) {
-    if (!(varicode & (1 << i)) && (!previous_bit)) {
-      bits[0] = i > 9 ? varicode >> (i - 9)
-                      : varicode << (9 - i); // i > 9 = more than 8 bits
-      bits[1] = i > 9 ? varicode << (17 - i) : 0x00;
-      bit_stream_.addBits(bits, i - 1);
-      break;
-    } else {
-      previous_bit = varicode & (1 << i);
-    }
-  }
+  // The code and the two 0 separator, in one write
+  const VaricodeSymbol &symbol =
+      VARICODE_ENCODE_TABLE.at(static_cast<unsigned char>(c));
+  bit_stream_.addWord(symbol.bits, symbol.length);
 }
 
 void Modulator::addPreamble() {
-  for (size_t i = 0; i < settings_.preamble_length; i++) {
-    bit_stream_.addZeroBit();
+  // Zeros, a word at a time
+  for (uint32_t remaining = settings_.preamble_length; remaining > 0;) {
+    const uint32_t num_bits = std::min<uint32_t>(remaining, 32);
+    bit_stream_.addWord(0, static_cast<int>(num_bits));
+    remaining -= num_bits;
   }
 }
 
@@ -91,20 +79,21 @@ void Modulator::addPostamble() {
   postamble_length +=
       32 - (bit_stream_.getBitStreamLength() % 32); // pad to 32 bits
 
-  for (uint32_t i = 0; i < postamble_length; i++) {
-    if (settings_.mode == Settings::Mode::QPSK && settings_.fldigi_mode) {
-      bit_stream_.addZeroBit();
-    } else {
-      bit_stream_.addOneBit();
-    }
+  const uint32_t fill =
+      settings_.mode == Settings::Mode::QPSK && settings_.fldigi_mode
+          ? 0U
+          : 0xffffffffU;
+  for (uint32_t remaining = postamble_length; remaining > 0;) {
+    const uint32_t num_bits = std::min<uint32_t>(remaining, 32);
+    bit_stream_.addWord(fill, static_cast<int>(num_bits));
+    remaining -= num_bits;
   }
 }
 
 void Modulator::encodeBpsk() {
-  PskWaveShaper wave_shaper(
-      settings_.carrier_frequency,
-      bst::template_tools::to_underlying(settings_.symbol_rate),
-      settings_.amplitude, audio_buffer_);
+  PskWaveShaper wave_shaper(settings_.carrier_frequency, samples_per_symbol_,
+                            settings_.amplitude, audio_buffer_);
+  wave_shaper.reserve(bit_stream_.getBitVector().size() * 32);
 
   // Swap the phase from 0 to 180 or 180 to 0
   auto swapPhase = [](Phase phase) {
@@ -142,10 +131,9 @@ void Modulator::encodeBpsk() {
 }
 
 void Modulator::encodeQpsk() {
-  PskWaveShaper wave_shaper(
-      settings_.carrier_frequency,
-      bst::template_tools::to_underlying(settings_.symbol_rate),
-      settings_.amplitude, audio_buffer_);
+  PskWaveShaper wave_shaper(settings_.carrier_frequency, samples_per_symbol_,
+                            settings_.amplitude, audio_buffer_);
+  wave_shaper.reserve(bit_stream_.getBitVector().size() * 32);
 
   // Five bit shift register
   uint8_t buffer = 0;
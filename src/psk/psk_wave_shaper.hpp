@@ -5,9 +5,9 @@
  * https://joshuajer.red/signal-easel
  * =*===========================*=
  *
- * @file   varicode.cpp
+ * @file   psk_wave_shaper.hpp
  * @date   2024-08-08
- * @brief  Varicode Implementation
+ * @brief  PSK symbol shaping
  *
  * =*=======================*=
  * @copyright  2024 Joshua Jerred
@@ -19,7 +19,6 @@
 #include <array>
 #include <cmath>
 #include <cstdint>
-#include <iostream>
 #include <vector>
 
 #include <BoosterSeat/math.hpp>
@@ -32,93 +31,117 @@ namespace signal_easel::psk {
 
 enum class Phase { ZERO = 0, NINETY = 1, ONE_EIGHTY = 2, TWO_SEVENTY = 3 };
 
+/**
+ * @brief Generates the PSK audio, a symbol at a time.
+ * @details Each symbol is the carrier, shifted by the symbol's phase, under
+ * an envelope that is a half sine over each half of the symbol that borders a
+ * phase change, and flat otherwise. The envelope only depends on which halves
+ * are filtered, and over one symbol the carrier is
+ * sin(start + n * delta) = sin(start) * cos(n * delta) +
+ *                          cos(start) * sin(n * delta),
+ * so the products of each of the four envelopes with cos(n * delta) and
+ * sin(n * delta) (and the amplitude) are tabulated once. A symbol is then
+ * two multiply-adds per sample, written straight into the buffer, for any
+ * symbol rate and carrier frequency.
+ */
 class PskWaveShaper {
 public:
-  PskWaveShaper(const uint32_t carrier_frequency, const uint32_t symbol_rate,
-                const double amplitude, std::vector<int16_t> &sample_buffer)
-      : SAMPLES_PER_SYMBOL_(signal_easel::AUDIO_SAMPLE_RATE / symbol_rate),
-        AMPLITUDE_(amplitude), sample_buffer_(sample_buffer) {
+  PskWaveShaper(const uint32_t carrier_frequency,
+                const uint32_t samples_per_symbol, const double amplitude,
+                std::vector<int16_t> &sample_buffer)
+      : SAMPLES_PER_SYMBOL_(samples_per_symbol),
+        sample_buffer_(sample_buffer) {
 
     signal_easel::validate(amplitude > 0.0 && amplitude <= 1.0,
                            "Amplitude must be in range (0.0, 1.0]");
 
-    angle_delta_ = bst::TWO_PI * static_cast<double>(carrier_frequency) /
-                   static_cast<double>(signal_easel::AUDIO_SAMPLE_RATE);
+    const double angle_delta =
+        bst::TWO_PI * static_cast<double>(carrier_frequency) /
+        static_cast<double>(signal_easel::AUDIO_SAMPLE_RATE);
+    symbol_angle_delta_ =
+        std::fmod(angle_delta * SAMPLES_PER_SYMBOL_, bst::TWO_PI);
+
+    const double scale = amplitude * signal_easel::MAX_SAMPLE_VALUE;
+    const double filter_sin_pi_scaler = bst::PI / SAMPLES_PER_SYMBOL_;
+    for (size_t shape = 0; shape < shapes_.size(); shape++) {
+      shapes_[shape].carrier_cos.resize(SAMPLES_PER_SYMBOL_);
+      shapes_[shape].carrier_sin.resize(SAMPLES_PER_SYMBOL_);
+      for (uint32_t n = 0; n < SAMPLES_PER_SYMBOL_; n++) {
+        const bool filtered = n < HALF_SAMPLES_PER_SYMBOL_
+                                  ? (shape & FILTER_START_) != 0
+                                  : (shape & FILTER_END_) != 0;
+        const double envelope =
+            filtered ? std::sin(filter_sin_pi_scaler * static_cast<double>(n))
+                     : 1.0;
+        const double angle = angle_delta * static_cast<double>(n);
+        shapes_[shape].carrier_cos[n] = scale * envelope * std::cos(angle);
+        shapes_[shape].carrier_sin[n] = scale * envelope * std::sin(angle);
+      }
+    }
   }
 
-  void addSymbol(Phase phase, bool filter_end_of_symbol) {
-    current_phase_ = phase;
-    filter_end_of_symbol_ = filter_end_of_symbol;
+  /**
+   * @brief Reserve room in the sample buffer for more symbols.
+   * @param num_symbols - The number of symbols that will be added
+   */
+  void reserve(size_t num_symbols) {
+    sample_buffer_.reserve(sample_buffer_.size() +
+                           num_symbols * SAMPLES_PER_SYMBOL_);
+  }
 
+  void addSymbol(Phase phase, bool filter_end_of_symbol) {
     constexpr std::array<double, 4> SHIFT_ANGLE = {0.0, bst::HALF_PI, bst::PI,
                                                    bst::THREE_PI_HALVES};
 
-    for (sample_num_ = 0; sample_num_ < SAMPLES_PER_SYMBOL_; sample_num_++) {
-      // Calculate X component of the carrier wave, from -1.0 to 1.0
-      double raw_sample = std::sin(carrier_wave_angle_ +
-                                   SHIFT_ANGLE[static_cast<uint8_t>(phase)]);
-
-      // Apply the envelope filter to the sample
-      envelopeFilter(raw_sample);
-
-      // Convert the wave position to a int16_t sample
-      uint16_t sample =
-          static_cast<int16_t>((raw_sample * signal_easel::MAX_SAMPLE_VALUE));
-
-      sample_buffer_.push_back(sample);
-
-      carrier_wave_angle_ += angle_delta_;
-      if (carrier_wave_angle_ >= bst::TWO_PI) {
-        carrier_wave_angle_ -= bst::TWO_PI;
-      }
+    // If the current phase is different from the previous phase, filter the
+    // first half of the symbol. If the next phase is different from the
+    // current, filter the second half of the symbol.
+    const Shape &shape =
+        shapes_[(phase != previous_phase_ ? FILTER_START_ : 0) |
+                (filter_end_of_symbol ? FILTER_END_ : 0)];
+
+    const double start_angle =
+        carrier_wave_angle_ + SHIFT_ANGLE[static_cast<uint8_t>(phase)];
+    const double start_sin = std::sin(start_angle);
+    const double start_cos = std::cos(start_angle);
+
+    const size_t offset = sample_buffer_.size();
+    sample_buffer_.resize(offset + SAMPLES_PER_SYMBOL_);
+    int16_t *samples = sample_buffer_.data() + offset;
+    const double *carrier_cos = shape.carrier_cos.data();
+    const double *carrier_sin = shape.carrier_sin.data();
+    for (uint32_t n = 0; n < SAMPLES_PER_SYMBOL_; n++) {
+      samples[n] = static_cast<int16_t>(start_sin * carrier_cos[n] +
+                                        start_cos * carrier_sin[n]);
     }
 
-    previous_phase_ = current_phase_;
+    carrier_wave_angle_ =
+        std::fmod(carrier_wave_angle_ + symbol_angle_delta_, bst::TWO_PI);
+    previous_phase_ = phase;
   }
 
 private:
-  /**
-   * @brief A filter to remove the sharp edges of the wave during a phase
-   * change.
-   * @details The filter is a
-   * @param[in out] raw_sample - The unfiltered sample
-   */
-  void envelopeFilter(double &raw_sample) const {
-    // Determine if the current sample is in the first half of the symbol
-    const bool first_half = sample_num_ < HALF_SAMPLES_PER_SYMBOL_;
-
-    // If the current phase is different from the previous phase, apply the
-    // filter to the first half of the symbol. If the next phase is different
-    // from the current, apply the filter to the second half of the symbol.
-    const bool filter_first_half =
-        first_half && current_phase_ != previous_phase_;
-
-    // Apply the filter to the sample
-    if ((first_half && filter_first_half) ||
-        (!first_half && filter_end_of_symbol_)) {
-      raw_sample *=
-          std::sin(FILTER_SIN_PI_SCALER_ * static_cast<double>(sample_num_));
-    }
+  /// @brief Flags for the filtered halves, an index into shapes_
+  static constexpr size_t FILTER_START_ = 1;
+  static constexpr size_t FILTER_END_ = 2;
 
-    // Apply the amplitude scaling to the sample
-    raw_sample *= AMPLITUDE_;
-  }
+  /// @brief The envelope times the carrier from the symbol's start, scaled to
+  /// the output amplitude
+  struct Shape {
+    std::vector<double> carrier_cos{};
+    std::vector<double> carrier_sin{};
+  };
 
-  Phase current_phase_ = Phase::ZERO;
   Phase previous_phase_ = Phase::ZERO;
-  bool filter_end_of_symbol_ = false;
 
+  /// @brief The carrier's angle at the start of the next symbol
   double carrier_wave_angle_ = 0.0;
-
-  double angle_delta_ = 0.0;
-
-  uint32_t sample_num_ = 0;
+  double symbol_angle_delta_ = 0.0;
 
   const uint32_t SAMPLES_PER_SYMBOL_;
   const uint32_t HALF_SAMPLES_PER_SYMBOL_ = SAMPLES_PER_SYMBOL_ / 2;
 
-  const double AMPLITUDE_;
-  const double FILTER_SIN_PI_SCALER_ = bst::PI / SAMPLES_PER_SYMBOL_;
+  std::array<Shape, 4> shapes_{};
 
   std::vector<int16_t> &sample_buffer_;
 };
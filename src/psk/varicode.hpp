@@ -0,0 +1,213 @@
+/**
+ * =*========SignalEasel========*=
+ * A friendly library for signal modulation and demodulation.
+ * https://github.com/joshua-jerred/Giraffe
+ * https://joshuajer.red/signal-easel
+ * =*===========================*=
+ *
+ * @file   varicode.hpp
+ * @date   2026-10-19
+ * @brief  Varicode lookup tables
+ *
+ * =*=======================*=
+ * @copyright  2026 Joshua Jerred
+ * @license    GNU GPLv3
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+namespace signal_easel::psk {
+
+/**
+ * @brief The varicode of each ASCII character 0-127, first bit in the MSB.
+ * @details Every code starts and ends with a 1 and never has two 0s in a row,
+ * so the leading 1 also marks the length.
+ */
+inline constexpr std::array<uint16_t, 128> VARICODE_TABLE = {
+    // ASCII Control Characters (0 - 31)
+    0b1010101011, // 0	    [NUL]	Null character
+    0b1011011011, // 1	    [SOH]	Start of Header
+    0b1011101101, // 2	    [STX]	Start of Text
+    0b1101110111, // 3	    [ETX]	End of Text
+    0b1011101011, // 4	    [EOT]	End of Transmission
+    0b1101011111, // 5	    [ENQ]	Enquiry
+    0b1011101111, // 6	    [ACK]	Acknowledgment
+    0b1011111101, // 7	    [BEL]	Bell
+    0b1011111111, // 8	    [BS]	Backspace
+    0b11101111,   // 9	    [HT]	Horizontal Tab
+    0b11101,      // 10	    [LF]	Line feed
+    0b1101101111, // 11	    [VT]	Vertical Tab
+    0b1011011101, // 12	    [FF]	Form feed
+    0b11111,      // 13	    [CR]	Carriage return
+    0b1101110101, // 14	    [SO]	Shift Out
+    0b1110101011, // 15	    [SI]	Shift In
+    0b1011110111, // 16	    [DLE]	Data Link Escape
+    0b1011110101, // 17	    [DC1]	Device Control 1 (XON)
+    0b1110101101, // 18	    [DC2]	Device Control 2
+    0b1110101111, // 19	    [DC3]	Device Control 3 (XOFF)
+    0b1101011011, // 20	    [DC4]	Device Control 4
+    0b1101101011, // 21	    [NAK]	Negative Acknowledgement
+    0b1101101101, // 22	    [SYN]	Synchronous Idle
+    0b1101010111, // 23	    [ETB]	End of Trans. Block
+    0b1101111011, // 24	    [CAN]	Cancel
+    0b1101111101, // 25	    [EM]	End of Medium
+    0b1110110111, // 26	    [SUB]	Substitute
+    0b1101010101, // 27	    [ESC]	Escape
+    0b1101011101, // 28	    [FS]	File Separator
+    0b1110111011, // 29	    [GS]	Group Separator
+    0b1011111011, // 30	    [RS]	Record Separator
+    0b1101111111, // 31	    [US]	Unit Separator
+
+    // ASCII Printable Characters (32 - 126)
+    0b1,          //    32	[Space]
+    0b111111111,  //    33	!
+    0b101011111,  //    34	"
+    0b111110101,  //    35	#
+    0b111011011,  //    36	$
+    0b1011010101, //    37	%
+    0b1010111011, //    38	&
+    0b101111111,  //    39	'
+    0b11111011,   //    40	(
+    0b11110111,   //    41	)
+    0b101101111,  //    42	*
+    0b111011111,  //    43	+
+    0b1110101,    //    44	,
+    0b110101,     //	45	-
+    0b1010111,    //	46	.
+    0b110101111,  //	47	/
+    0b10110111,   //	48	0
+    0b10111101,   //	49	1
+    0b11101101,   //	50	2
+    0b11111111,   //	51	3
+    0b101110111,  //	52	4
+    0b101011011,  //	53	5
+    0b101101011,  //	54	6
+    0b110101101,  //	55	7
+    0b110101011,  //	56	8
+    0b110110111,  //	57	9
+    0b11110101,   //	58	:
+    0b110111101,  //	59	;
+    0b111101101,  //	60	<
+    0b1010101,    //	61	=
+    0b111010111,  //	62	>
+    0b1010101111, //	63	?
+    0b1010111101, //	64	@
+    0b1111101,    //	65	A
+    0b11101011,   //	66	B
+    0b10101101,   //	67	C
+    0b10110101,   //	68	D
+    0b1110111,    //	69	E
+    0b11011011,   //	70	F
+    0b11111101,   //	71	G
+    0b101010101,  //	72	H
+    0b1111111,    //	73	I
+    0b111111101,  //	74	J
+    0b101111101,  //	75	K
+    0b11010111,   //	76	L
+    0b10111011,   //	77	M
+    0b11011101,   //	78	N
+    0b10101011,   //	79	O
+    0b11010101,   //	80	P
+    0b111011101,  //	81	Q
+    0b10101111,   //	82	R
+    0b1101111,    //	83	S
+    0b1101101,    //	84	T
+    0b101010111,  //	85	U
+    0b110110101,  //	86	V
+    0b101011101,  //	87	W
+    0b101110101,  //	88	X
+    0b101111011,  //	89	Y
+    0b1010101101, //	90	Z
+    0b111110111,  //	91	[
+    0b111101111,  //	92	[backslash]
+    0b111111011,  //	93	]
+    0b1010111111, //	94	^
+    0b101101101,  //	95	_
+    0b1011011111, //	96	'
+    0b1011,       //	97	a
+    0b1011111,    //	98	b
+    0b101111,     //	99	c
+    0b101101,     //	100	d
+    0b11,         //	101	e
+    0b111101,     //	102	f
+    0b1011011,    //	103	g
+    0b101011,     //	104	h
+    0b1101,       //	105	i
+    0b111101011,  //	106	j
+    0b10111111,   //	107	k
+    0b11011,      //	108	l
+    0b111011,     //	109	m
+    0b1111,       //	110	n
+    0b111,        //	111	o
+    0b111111,     //	112	p
+    0b110111111,  //	113	q
+    0b10101,      //	114	r
+    0b10111,      //	115	s
+    0b101,        //	116	t
+    0b110111,     //	117	u
+    0b1111011,    //	118	v
+    0b1101011,    //	119	w
+    0b11011111,   //	120	x
+    0b1011101,    //	121	y
+    0b111010101,  //	122	z
+    0b1010110111, //	123	{
+    0b110111011,  //	124	|
+    0b1010110101, //	125	}
+    0b1011010111, //	126	~
+    0b1110110101  //	127	[DEL]
+};
+
+/// @brief The longest varicode, in bits
+inline constexpr uint32_t VARICODE_MAX_LENGTH = 10;
+
+/// @brief Marks the codes in VARICODE_DECODE_TABLE that are not a character
+inline constexpr uint8_t VARICODE_INVALID = 0xff;
+
+/**
+ * @brief VARICODE_TABLE inverted, the character for each code, indexed
+ * directly by the code's bits.
+ */
+inline constexpr std::array<uint8_t, 1 << VARICODE_MAX_LENGTH>
+    VARICODE_DECODE_TABLE = []() {
+      std::array<uint8_t, 1 << VARICODE_MAX_LENGTH> table{};
+      for (auto &character : table) {
+        character = VARICODE_INVALID;
+      }
+      for (size_t i = 0; i < VARICODE_TABLE.size(); i++) {
+        table[VARICODE_TABLE[i]] = static_cast<uint8_t>(i);
+      }
+      return table;
+    }();
+
+/**
+ * @brief A character's varicode followed by the two 0 separator, ready to be
+ * written to a BitStream in one go.
+ */
+struct VaricodeSymbol {
+  /// @brief The bits, right aligned, first bit in the MSB
+  uint16_t bits;
+  /// @brief The number of bits, including the separator
+  uint8_t length;
+};
+
+/**
+ * @brief The VaricodeSymbol of each ASCII character 0-127.
+ */
+inline constexpr std::array<VaricodeSymbol, 128> VARICODE_ENCODE_TABLE =
+    []() {
+      std::array<VaricodeSymbol, 128> table{};
+      for (size_t i = 0; i < table.size(); i++) {
+        uint8_t length = 0;
+        while ((VARICODE_TABLE[i] >> length) != 0) {
+          length++;
+        }
+        table[i] = {static_cast<uint16_t>(VARICODE_TABLE[i] << 2),
+                    static_cast<uint8_t>(length + 2)};
+      }
+      return table;
+    }();
+
+} // namespace signal_easel::psk
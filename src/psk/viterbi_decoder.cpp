@@ -0,0 +1,135 @@
+/**
+ * =*========SignalEasel========*=
+ * A friendly library for signal modulation and demodulation.
+ * https://github.com/joshua-jerred/Giraffe
+ * https://joshuajer.red/signal-easel
+ * =*===========================*=
+ *
+ * @file   viterbi_decoder.cpp
+ * @date   2026-10-19
+ * @brief  Soft decision Viterbi decoder for the QPSK convolutional code
+ *
+ * =*=======================*=
+ * @copyright  2026 Joshua Jerred
+ * @license    GNU GPLv3
+ */
+
+#include <algorithm>
+
+#include <SignalEasel/psk.hpp>
+
+#include "convolutional_code.hpp"
+
+namespace signal_easel::psk {
+
+namespace {
+
+constexpr uint32_t STATES = ViterbiDecoder::STATES;
+
+constexpr uint32_t HALF_STATES = STATES / 2;
+
+/**
+ * @brief The phase change sent on each branch, as a unit vector.
+ * @details Indexed [bit][high * HALF_STATES + j], for the branch from the
+ * predecessor j + high * HALF_STATES into state 2j + bit. The branch's code
+ * register is then the new state with high as it's top (fifth) bit.
+ */
+struct BranchTable {
+  std::array<std::array<float, STATES>, 2> real{};
+  std::array<std::array<float, STATES>, 2> imag{};
+};
+
+constexpr BranchTable BRANCH_TABLE = []() {
+  BranchTable branches;
+  for (uint32_t bit = 0; bit < 2; bit++) {
+    for (uint32_t high = 0; high < 2; high++) {
+      for (uint32_t j = 0; j < HALF_STATES; j++) {
+        const Shift shift = CONVOLUTIONAL_CODE[(high << 4) | (j << 1) | bit];
+        const auto &vector = SHIFT_VECTORS[static_cast<uint8_t>(shift)];
+        branches.real[bit][high * HALF_STATES + j] = vector[0];
+        branches.imag[bit][high * HALF_STATES + j] = vector[1];
+      }
+    }
+  }
+  return branches;
+}();
+
+/**
+ * @brief The add-compare-select kernel, for the half of the new states with
+ * one low bit. Predecessors j and j + HALF_STATES both lead to state
+ * 2j + bit, each loop iteration is one of those butterflies. Branch free with
+ * contiguous loads and stores, so it vectorizes across the states.
+ */
+void addCompareSelect(const float *metrics, const float *branch_real,
+                      const float *branch_imag, float real, float imag,
+                      float *survivors, uint32_t *decisions) {
+  for (uint32_t j = 0; j < HALF_STATES; j++) {
+    const float low =
+        metrics[j] + real * branch_real[j] + imag * branch_imag[j];
+    const float high = metrics[j + HALF_STATES] +
+                       real * branch_real[j + HALF_STATES] +
+                       imag * branch_imag[j + HALF_STATES];
+    survivors[j] = high > low ? high : low;
+    decisions[j] = high > low;
+  }
+}
+
+} // namespace
+
+bool ViterbiDecoder::decode(std::complex<float> phase_change, bool &bit) {
+  const float real = phase_change.real();
+  const float imag = phase_change.imag();
+  auto &decisions = decisions_[steps_ % TRACEBACK_LENGTH];
+
+  // Decisions are stored split by the new state's low bit, at
+  // bit * HALF_STATES + j for state 2j + bit.
+  std::array<std::array<float, HALF_STATES>, 2> survivors;
+  for (uint32_t bit = 0; bit < 2; bit++) {
+    addCompareSelect(metrics_.data(), BRANCH_TABLE.real[bit].data(),
+                     BRANCH_TABLE.imag[bit].data(), real, imag,
+                     survivors[bit].data(),
+                     decisions.data() + bit * HALF_STATES);
+  }
+  std::array<float, STATES> metrics;
+  for (uint32_t j = 0; j < HALF_STATES; j++) {
+    metrics[2 * j] = survivors[0][j];
+    metrics[2 * j + 1] = survivors[1][j];
+  }
+
+  // Keep the metrics near zero so they never lose precision
+  uint32_t best_state = 0;
+  for (uint32_t state = 1; state < STATES; state++) {
+    if (metrics[state] > metrics[best_state]) {
+      best_state = state;
+    }
+  }
+  const float best_metric = metrics[best_state];
+  for (uint32_t state = 0; state < STATES; state++) {
+    metrics_[state] = metrics[state] - best_metric;
+  }
+
+  steps_++;
+  if (steps_ < TRACEBACK_LENGTH) {
+    return false;
+  }
+
+  // Trace the best path back to the oldest step kept, it's state's low bit
+  // is the bit that was shifted into the encoder then.
+  uint32_t state = best_state;
+  for (uint32_t i = 0; i < TRACEBACK_LENGTH - 1; i++) {
+    const auto &step_decisions =
+        decisions_[(steps_ - 1 - i) % TRACEBACK_LENGTH];
+    const uint32_t high =
+        step_decisions[(state & 1) * HALF_STATES + (state >> 1)];
+    state = (state >> 1) | (high << 3);
+  }
+  bit = (state & 1) != 0;
+  return true;
+}
+
+void ViterbiDecoder::reset() {
+  metrics_.fill(0.0F);
+  steps_ = 0;
+}
+
+} // namespace signal_easel::psk
@@ -0,0 +1,140 @@
+/**
+ * =*========SignalEasel========*=
+ * A friendly library for signal modulation and demodulation.
+ * https://github.com/joshua-jerred/Giraffe
+ * https://joshuajer.red/signal-easel
+ * =*===========================*=
+ *
+ * @file   resampler.cpp
+ * @date   2026-10-19
+ * @brief  Rational polyphase sample rate converter implementation
+ *
+ * =*=======================*=
+ * @copyright  2026 Joshua Jerred
+ * @license    GNU GPLv3
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+#include <SignalEasel/constants.hpp>
+#include <SignalEasel/exception.hpp>
+#include <SignalEasel/resampler.hpp>
+
+namespace signal_easel {
+
+/**
+ * @brief Zeroth order modified Bessel function of the first kind, for the
+ * Kaiser window.
+ */
+static double besselI0(double x) {
+  double sum = 1.0;
+  double term = 1.0;
+  const double half_x = x / 2.0;
+  for (int k = 1; k < 50; k++) {
+    term *= (half_x / k) * (half_x / k);
+    sum += term;
+    if (term < sum * 1e-12) {
+      break;
+    }
+  }
+  return sum;
+}
+
+Resampler::Resampler(uint32_t input_rate, uint32_t output_rate,
+                     uint32_t filter_half_length)
+    : input_rate_(input_rate), output_rate_(output_rate) {
+  if (input_rate_ == 0 || output_rate_ == 0 || filter_half_length == 0) {
+    throw Exception(Exception::Id::RESAMPLER_INVALID_SAMPLE_RATE,
+                    std::to_string(input_rate_) + " -> " +
+                        std::to_string(output_rate_));
+  }
+
+  const uint32_t divisor = std::gcd(input_rate_, output_rate_);
+  up_factor_ = output_rate_ / divisor;
+  down_factor_ = input_rate_ / divisor;
+
+  if (isPassthrough()) {
+    return;
+  }
+
+  // Windowed-sinc low pass prototype, designed at the up-sampled rate
+  const uint32_t factor = std::max(up_factor_, down_factor_);
+  const size_t prototype_length = 2 * filter_half_length * factor + 1;
+  const double cutoff = RESAMPLER_CUTOFF_RATIO / (2.0 * factor);
+  const double center = static_cast<double>(prototype_length - 1) / 2.0;
+  const double window_scale = besselI0(RESAMPLER_KAISER_BETA);
+
+  taps_per_phase_ = (prototype_length + up_factor_ - 1) / up_factor_;
+  delay_ = (filter_half_length * factor) / down_factor_;
+  coefficients_.assign(taps_per_phase_ * up_factor_, 0.0);
+
+  for (size_t n = 0; n < prototype_length; n++) {
+    const double t = static_cast<double>(n) - center;
+    const double sinc =
+        t == 0.0 ? 2.0 * cutoff
+                 : std::sin(TWO_PI_VAL * cutoff * t) / (PI_VAL * t);
+    const double ratio = t / center;
+    const double window =
+        besselI0(RESAMPLER_KAISER_BETA * std::sqrt(1.0 - ratio * ratio)) /
+        window_scale;
+
+    // Gain of L makes up for the energy lost to zero-stuffing
+    const size_t phase = n % up_factor_;
+    const size_t tap = n / up_factor_;
+    coefficients_[phase * taps_per_phase_ + tap] = sinc * window * up_factor_;
+  }
+
+  reset();
+}
+
+void Resampler::reset() {
+  history_.assign(2 * taps_per_phase_, 0.0);
+  history_position_ = 0;
+  phase_ = 0;
+}
+
+void Resampler::process(const int16_t *input, size_t num_samples,
+                        std::vector<int16_t> &output) {
+  if (isPassthrough()) {
+    output.insert(output.end(), input, input + num_samples);
+    return;
+  }
+
+  output.reserve(output.size() +
+                 (num_samples * up_factor_) / down_factor_ + 1);
+  for (size_t i = 0; i < num_samples; i++) {
+    pushSample(static_cast<double>(input[i]), output);
+  }
+}
+
+void Resampler::flush(std::vector<int16_t> &output) {
+  for (size_t i = 0; i < taps_per_phase_; i++) {
+    pushSample(0.0, output);
+  }
+}
+
+void Resampler::pushSample(double sample, std::vector<int16_t> &output) {
+  // history_[history_position_ + k] is the sample from k inputs ago
+  history_position_ =
+      (history_position_ == 0 ? taps_per_phase_ : history_position_) - 1;
+  history_[history_position_] = sample;
+  history_[history_position_ + taps_per_phase_] = sample;
+
+  const double *window = history_.data() + history_position_;
+  while (phase_ < up_factor_) {
+    const double *taps = coefficients_.data() + phase_ * taps_per_phase_;
+    double accumulator = 0.0;
+    for (size_t k = 0; k < taps_per_phase_; k++) {
+      accumulator += taps[k] * window[k];
+    }
+
+    accumulator = std::clamp(std::round(accumulator), -32768.0, 32767.0);
+    output.push_back(static_cast<int16_t>(accumulator));
+    phase_ += down_factor_;
+  }
+  phase_ -= up_factor_;
+}
+
+} // namespace signal_easel
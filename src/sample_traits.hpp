@@ -0,0 +1,147 @@
+/**
+ * =*========SignalEasel========*=
+ * A friendly library for signal modulation and demodulation.
+ * https://github.com/joshua-jerred/Giraffe
+ * https://joshuajer.red/signal-easel
+ * =*===========================*=
+ *
+ * @file   sample_traits.hpp
+ * @date   2026-10-19
+ * @brief  Sample types for the floating and fixed point DSP paths
+ *
+ * =*=======================*=
+ * @copyright  2026 Joshua Jerred
+ * @license    GNU GPLv3
+ */
+
+#ifndef SIGNAL_EASEL_SAMPLE_TRAITS_HPP_
+#define SIGNAL_EASEL_SAMPLE_TRAITS_HPP_
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace signal_easel {
+
+/**
+ * @brief A fixed point sample, Q8.23 in an int32_t.
+ * @details Full scale (a Q15 PCM sample) sits at +/-2^23, which leaves 8 bits
+ * of headroom for filter gain and transients.
+ */
+using FixedSample = int32_t;
+
+inline constexpr int FIXED_SAMPLE_FRACTION_BITS = 23;
+
+/**
+ * @brief Fixed point coefficients are Q2.29, enough range for the feedback
+ * terms of a biquad (|a1| < 2) and for oscillator tables.
+ */
+inline constexpr int FIXED_COEFFICIENT_FRACTION_BITS = 29;
+
+/**
+ * @brief Describes how the DSP kernels do arithmetic on a sample type.
+ * @details The kernels are templates on the sample type so that the receive
+ * path can be built for double, float or fixed point without duplicating
+ * them. Floating point samples are normalized to -1.0 to 1.0.
+ */
+template <typename T> struct SampleTraits {
+  static_assert(std::is_floating_point_v<T>,
+                "Unsupported sample type, use double, float or FixedSample");
+
+  using Sample = T;
+  using Coefficient = T;
+  /// @brief The type of a coefficient * sample product and of filter sums
+  using Accumulator = T;
+  /// @brief The type used for long running sums and energies. Kept in double
+  /// so that running sums don't drift in single precision.
+  using Sum = double;
+
+  static Sample fromPcm(int16_t sample) {
+    return static_cast<T>(sample) / static_cast<T>(32768);
+  }
+  static Coefficient coefficient(double value) {
+    return static_cast<T>(value);
+  }
+  static Accumulator multiply(Coefficient coefficient, Sample sample) {
+    return coefficient * sample;
+  }
+  static Sample fromAccumulator(Accumulator value) { return value; }
+
+  static Sum toSum(Sample sample) { return sample; }
+  static Sum square(Sample sample) { return static_cast<Sum>(sample) * sample; }
+  /// @brief I^2 + Q^2 of two running sums, only used for comparisons
+  static Sum power(Sum i, Sum q) { return i * i + q * q; }
+  /// @brief sum / 2^shift
+  static Sum shiftDown(Sum sum, int shift) {
+    return sum / static_cast<Sum>(1 << shift);
+  }
+
+  /// @brief Converts a Sum of samples back to the normalized scale
+  static double sumToDouble(Sum sum) { return sum; }
+  /// @brief Converts a Sum of square() values back to the normalized scale
+  static double energyToDouble(Sum energy) { return energy; }
+};
+
+template <> struct SampleTraits<FixedSample> {
+  using Sample = FixedSample;
+  using Coefficient = int32_t;
+  using Accumulator = int64_t;
+  using Sum = int64_t;
+
+  static Sample fromPcm(int16_t sample) {
+    return static_cast<Sample>(sample) *
+           (1 << (FIXED_SAMPLE_FRACTION_BITS - 15));
+  }
+  static Coefficient coefficient(double value) {
+    const double scaled =
+        std::round(value * (1LL << FIXED_COEFFICIENT_FRACTION_BITS));
+    return static_cast<Coefficient>(
+        std::clamp(scaled, -2147483648.0, 2147483647.0));
+  }
+  static Accumulator multiply(Coefficient coefficient, Sample sample) {
+    return static_cast<Accumulator>(coefficient) * sample;
+  }
+  static Sample fromAccumulator(Accumulator value) {
+    constexpr Accumulator ROUNDING = 1LL
+                                     << (FIXED_COEFFICIENT_FRACTION_BITS - 1);
+    const Accumulator result =
+        (value + ROUNDING) >> FIXED_COEFFICIENT_FRACTION_BITS;
+    return static_cast<Sample>(
+        std::clamp<Accumulator>(result, std::numeric_limits<Sample>::min(),
+                                std::numeric_limits<Sample>::max()));
+  }
+
+  static Sum toSum(Sample sample) { return sample; }
+  /// @brief Q30, so a few seconds of audio fit in the sum with lots of room
+  static Sum square(Sample sample) {
+    return (static_cast<Sum>(sample) * sample) >> SQUARE_SHIFT;
+  }
+  static Sum power(Sum i, Sum q) {
+    i >>= POWER_SHIFT;
+    q >>= POWER_SHIFT;
+    return i * i + q * q;
+  }
+  static Sum shiftDown(Sum sum, int shift) { return sum >> shift; }
+
+  static double sumToDouble(Sum sum) {
+    return static_cast<double>(sum) / (1 << FIXED_SAMPLE_FRACTION_BITS);
+  }
+  static double energyToDouble(Sum energy) {
+    return static_cast<double>(energy) /
+           static_cast<double>(1LL << (2 * FIXED_SAMPLE_FRACTION_BITS -
+                                       SQUARE_SHIFT));
+  }
+
+private:
+  static constexpr int SQUARE_SHIFT = 16;
+  /// @brief Running sums of a symbol's worth of samples are shifted down
+  /// before squaring so that i^2 + q^2 can't overflow. With a 40 sample symbol
+  /// a full scale sum is ~2^28.3, leaving room for filter overshoot.
+  static constexpr int POWER_SHIFT = 4;
+};
+
+} // namespace signal_easel
+
+#endif /* SIGNAL_EASEL_SAMPLE_TRAITS_HPP_ */
@@ -0,0 +1,160 @@
+/**
+ * =*========SignalEasel========*=
+ * A friendly library for signal modulation and demodulation.
+ * https://github.com/joshua-jerred/Giraffe
+ * https://joshuajer.red/signal-easel
+ * =*===========================*=
+ *
+ * @file   spectrum_analyzer.cpp
+ * @date   2026-10-19
+ * @brief  Streaming power spectra implementation
+ *
+ * =*=======================*=
+ * @copyright  2026 Joshua Jerred
+ * @license    GNU GPLv3
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include <SignalEasel/constants.hpp>
+#include <SignalEasel/exception.hpp>
+#include <SignalEasel/spectrum.hpp>
+
+#include "fft.hpp"
+
+namespace signal_easel {
+
+namespace {
+
+/// @brief The largest sample, the amplitude of a full scale sine
+constexpr double FULL_SCALE = 32767.0;
+
+double getWindowValue(SpectrumSettings::Window window, double phase) {
+  switch (window) {
+  case SpectrumSettings::Window::HANN:
+    return 0.5 - 0.5 * std::cos(phase);
+  case SpectrumSettings::Window::BLACKMAN_HARRIS:
+    return 0.35875 - 0.48829 * std::cos(phase) +
+           0.14128 * std::cos(2 * phase) - 0.01168 * std::cos(3 * phase);
+  case SpectrumSettings::Window::RECTANGULAR:
+  default:
+    return 1.0;
+  }
+}
+
+} // namespace
+
+SpectrumAnalyzer::SpectrumAnalyzer(SpectrumSettings settings)
+    : settings_(settings), fft_(nullptr) {
+  validate(RealFft::isValidSize(settings_.fft_size),
+           "The spectrum fft_size must be a power of two from FFT_MIN_SIZE "
+           "to FFT_MAX_SIZE");
+  validate(settings_.hop > 0, "The spectrum hop must be at least 1");
+  fft_ = std::make_unique<RealFft>(settings_.fft_size);
+
+  // A full scale sine centered on a bin has an amplitude of the window's sum
+  // over 2 there. The window spreads white noise over sum(w^2) * N / sum(w)^2
+  // bins, it's equivalent noise bandwidth.
+  const uint32_t size = settings_.fft_size;
+  window_.resize(size);
+  double sum = 0.0;
+  double sum_of_squares = 0.0;
+  for (uint32_t i = 0; i < size; i++) {
+    const double value =
+        getWindowValue(settings_.window, TWO_PI_VAL * i / size);
+    window_[i] = static_cast<float>(value);
+    sum += value;
+    sum_of_squares += value * value;
+  }
+  power_scale_db_ = -20.0 * std::log10(FULL_SCALE * sum / 2.0);
+  noise_bandwidth_ = sum_of_squares * size / (sum * sum);
+
+  frame_.resize(size);
+  power_.resize(getNumBins());
+}
+
+SpectrumAnalyzer::~SpectrumAnalyzer() = default;
+
+void SpectrumAnalyzer::process(const int16_t *samples, size_t num_samples) {
+  // The audio between spectra, when the hop is longer than one
+  const size_t skipped = static_cast<size_t>(
+      std::min<uint64_t>(skip_, num_samples));
+  samples += skipped;
+  num_samples -= skipped;
+  skip_ -= skipped;
+  buffer_start_ += skipped;
+
+  buffer_.insert(buffer_.end(), samples, samples + num_samples);
+  size_t offset = 0;
+  while (offset + settings_.fft_size <= buffer_.size()) {
+    computeSpectrum(buffer_.data() + offset);
+    spectra_.back().start_sample = buffer_start_ + offset;
+    offset += settings_.hop;
+  }
+  if (offset > buffer_.size()) {
+    skip_ = offset - buffer_.size();
+    offset = buffer_.size();
+  }
+  buffer_.erase(buffer_.begin(),
+                buffer_.begin() + static_cast<std::ptrdiff_t>(offset));
+  buffer_start_ += offset;
+}
+
+void SpectrumAnalyzer::computeSpectrum(const int16_t *samples) {
+  for (uint32_t i = 0; i < settings_.fft_size; i++) {
+    frame_[i] = window_[i] * static_cast<float>(samples[i]);
+  }
+  fft_->power(frame_.data(), power_.data());
+
+  Spectrum spectrum;
+  spectrum.power_db.resize(power_.size());
+  for (size_t i = 0; i < power_.size(); i++) {
+    spectrum.power_db[i] =
+        power_[i] > 0.0F
+            ? std::max(SPECTRUM_FLOOR_DB,
+                       static_cast<float>(10.0 * std::log10(power_[i]) +
+                                          power_scale_db_))
+            : SPECTRUM_FLOOR_DB;
+  }
+  spectra_.push_back(std::move(spectrum));
+}
+
+bool SpectrumAnalyzer::takeSpectra(std::vector<Spectrum> &output) {
+  output = std::move(spectra_);
+  spectra_.clear();
+  return !output.empty();
+}
+
+double SpectrumAnalyzer::getBinWidth() const {
+  return static_cast<double>(AUDIO_SAMPLE_RATE) / settings_.fft_size;
+}
+
+double SpectrumAnalyzer::getBandPower(const Spectrum &spectrum,
+                                      double low_frequency,
+                                      double high_frequency) const {
+  const double bin_width = getBinWidth();
+  const double last_bin = static_cast<double>(spectrum.power_db.size()) - 1;
+  const auto first = static_cast<size_t>(
+      std::clamp(std::ceil(low_frequency / bin_width), 0.0, last_bin));
+  const auto last = static_cast<size_t>(
+      std::clamp(std::floor(high_frequency / bin_width), 0.0, last_bin));
+
+  double power = 0.0;
+  for (size_t i = first; i <= last && low_frequency <= high_frequency; i++) {
+    power += std::pow(10.0, spectrum.power_db[i] / 10.0);
+  }
+  power /= noise_bandwidth_;
+  return power > 0.0
+             ? std::max<double>(SPECTRUM_FLOOR_DB, 10.0 * std::log10(power))
+             : SPECTRUM_FLOOR_DB;
+}
+
+void SpectrumAnalyzer::reset() {
+  buffer_.clear();
+  buffer_start_ = 0;
+  skip_ = 0;
+  spectra_.clear();
+}
+
+} // namespace signal_easel
@@ -0,0 +1,65 @@
+/**
+ * =*========SignalEasel========*=
+ * A friendly library for signal modulation and demodulation.
+ * https://github.com/joshua-jerred/Giraffe
+ * https://joshuajer.red/signal-easel
+ * =*===========================*=
+ *
+ * @file   stage_timer.hpp
+ * @date   2026-10-19
+ * @brief  Scoped timer for the receive stages, compiled away when disabled
+ *
+ * =*=======================*=
+ * @copyright  2026 Joshua Jerred
+ * @license    GNU GPLv3
+ */
+
+#ifndef SIGNAL_EASEL_STAGE_TIMER_HPP_
+#define SIGNAL_EASEL_STAGE_TIMER_HPP_
+
+#include <chrono>
+
+namespace signal_easel {
+
+/**
+ * @brief Set by the SIGNALEASEL_INSTRUMENTATION CMake option.
+ */
+#ifdef SIGNAL_EASEL_INSTRUMENTATION
+inline constexpr bool INSTRUMENTATION_ENABLED = true;
+#else
+inline constexpr bool INSTRUMENTATION_ENABLED = false;
+#endif
+
+/**
+ * @brief Adds the time between construction and destruction to a total.
+ * @details Does nothing, and reads no clocks, without instrumentation.
+ */
+class StageTimer {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  explicit StageTimer(std::chrono::nanoseconds &total) : total_(total) {
+    if constexpr (INSTRUMENTATION_ENABLED) {
+      start_ = Clock::now();
+    }
+  }
+
+  ~StageTimer() {
+    if constexpr (INSTRUMENTATION_ENABLED) {
+      total_ += Clock::now() - start_;
+    }
+  }
+
+  StageTimer(const StageTimer &) = delete;
+  StageTimer &operator=(const StageTimer &) = delete;
+  StageTimer(StageTimer &&) = delete;
+  StageTimer &operator=(StageTimer &&) = delete;
+
+private:
+  std::chrono::nanoseconds &total_;
+  Clock::time_point start_{};
+};
+
+} // namespace signal_easel
+
+#endif /* SIGNAL_EASEL_STAGE_TIMER_HPP_ */
@@ -1,8 +1,19 @@
 #include "gtest/gtest.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
 #include <string>
+#include <vector>
 
 #include <SignalEasel/afsk.hpp>
+#include <SignalEasel/channel_simulator.hpp>
+#include <wav_gen.hpp>
+
+#include "src/afsk/snr_estimator.hpp"
+#include "src/afsk/tone_detector.hpp"
 
 /**
  * @brief Encodes a string into an AFSK1200 signal/WAV file and then decodes it.
@@ -58,4 +69,437 @@ TEST(Afsk, WhiteNoise) {
   EXPECT_LE(res.snr, 0.0);
   EXPECT_NE(demodulator.lookForString(output),
             signal_easel::afsk::Demodulator::AsciiResult::SUCCESS);
-}
\ No newline at end of file
+}
+
+/**
+ * @brief The quadrature mixer engine, at full and reduced rates.
+ */
+TEST(Afsk, QuadratureMixerEngine) {
+  const std::string kInputString = "Hello World! How are you today?";
+  const std::string kOutFilePath = "afsk_test_QuadratureMixerEngine.wav";
+
+  signal_easel::afsk::Modulator modulator;
+  modulator.addString(kInputString);
+  modulator.writeToFile(kOutFilePath);
+
+  for (uint32_t sample_rate : {48000u, 12000u, 9600u}) {
+    signal_easel::afsk::Settings settings;
+    settings.demodulation_engine =
+        signal_easel::afsk::Settings::DemodulationEngine::QUADRATURE_MIXER;
+    settings.demodulation_sample_rate = sample_rate;
+
+    signal_easel::afsk::Demodulator demodulator(settings);
+    demodulator.loadAudioFromFile(kOutFilePath);
+    demodulator.processAudioBuffer();
+
+    std::string output;
+    EXPECT_EQ(demodulator.lookForString(output),
+              signal_easel::afsk::Demodulator::AsciiResult::SUCCESS)
+        << sample_rate;
+    EXPECT_EQ(kInputString, output) << sample_rate;
+  }
+}
+
+TEST(Afsk, QuadratureMixerEngineSignalSkewAndNoise) {
+  signal_easel::afsk::Settings settings;
+  settings.demodulation_engine =
+      signal_easel::afsk::Settings::DemodulationEngine::QUADRATURE_MIXER;
+
+  signal_easel::afsk::Demodulator demodulator(settings);
+  demodulator.loadAudioFromFile("afsk_timing_skew.wav");
+  demodulator.processAudioBuffer();
+  std::string output;
+  EXPECT_EQ(demodulator.lookForString(output),
+            signal_easel::afsk::Demodulator::AsciiResult::SUCCESS);
+  EXPECT_EQ("Hello World!", output);
+
+  signal_easel::afsk::Demodulator noise_demodulator(settings);
+  noise_demodulator.loadAudioFromFile("white_noise.wav");
+  noise_demodulator.processAudioBuffer();
+  EXPECT_NE(noise_demodulator.lookForString(output),
+            signal_easel::afsk::Demodulator::AsciiResult::SUCCESS);
+}
+
+/**
+ * @brief The engines low-pass the mixer outputs differently, so their
+ * mark/space decisions differ. The correlator's symbol long boxcar holds up
+ * better in noise.
+ */
+TEST(Afsk, DemodulationEnginesDiffer) {
+  signal_easel::afsk::Modulator modulator;
+  modulator.addString("Hello World! How are you today?");
+  const std::vector<int16_t> &clean = modulator.getAudioBuffer();
+
+  signal_easel::ChannelSimulator::Settings channel_settings;
+  channel_settings.add_noise = true;
+  channel_settings.eb_n0_db = 10.0;
+  signal_easel::ChannelSimulator channel(channel_settings);
+  std::vector<int16_t> noisy;
+  channel.process(clean, noisy);
+
+  auto baseBand = [](signal_easel::afsk::Settings::DemodulationEngine engine,
+                     const std::vector<int16_t> &audio) {
+    auto detector = signal_easel::afsk::ToneDetector::create(
+        signal_easel::AUDIO_SAMPLE_RATE, engine);
+    std::vector<uint8_t> base_band;
+    signal_easel::afsk::Demodulator::ProcessResults results;
+    detector->process(audio, base_band, results);
+    return base_band;
+  };
+  auto mismatches = [](const std::vector<uint8_t> &lhs,
+                       const std::vector<uint8_t> &rhs) {
+    size_t count = 0;
+    for (size_t i = 0; i < lhs.size(); i++) {
+      count += lhs[i] != rhs[i] ? 1 : 0;
+    }
+    return count;
+  };
+
+  using Engine = signal_easel::afsk::Settings::DemodulationEngine;
+  const auto correlator = baseBand(Engine::CORRELATOR, clean);
+  const auto mixer = baseBand(Engine::QUADRATURE_MIXER, clean);
+  ASSERT_EQ(correlator.size(), mixer.size());
+  EXPECT_GT(mismatches(correlator, mixer), 0U);
+
+  const size_t correlator_errors =
+      mismatches(correlator, baseBand(Engine::CORRELATOR, noisy));
+  const size_t mixer_errors =
+      mismatches(mixer, baseBand(Engine::QUADRATURE_MIXER, noisy));
+  EXPECT_LT(correlator_errors, mixer_errors);
+}
+
+/**
+ * @brief The oversampled AFSK synthesizer the modulator used before it was
+ * table driven, kept as the reference. Integrates the bipolar bits at 4x the
+ * sample rate and takes the cosine of every 4th step.
+ */
+static void referenceAfskSynthesis(const std::vector<uint8_t> &bytes,
+                                   double amplitude, int32_t &integral_value,
+                                   std::vector<int16_t> &audio) {
+  using namespace signal_easel;
+  using namespace signal_easel::afsk;
+  constexpr uint32_t kOverSampleFactor = 4;
+  constexpr double kSampleFrequency = AUDIO_SAMPLE_RATE * kOverSampleFactor;
+  constexpr uint32_t kSamplesPerSymbol =
+      AUDIO_SAMPLE_RATE * kOverSampleFactor / AFSK_BAUD_RATE;
+  auto bipolar_bit = [&bytes](size_t bit_index) -> int8_t {
+    const bool bit = (bytes[bit_index / 8] >> (7 - bit_index % 8)) & 1;
+    return bit ? -1 : 1;
+  };
+
+  int8_t current = bipolar_bit(0);
+  int8_t previous = 0;
+  size_t bit_index = 1;
+  const uint32_t iterations = bytes.size() * 8 * kSamplesPerSymbol;
+  for (uint32_t i = 2; i < iterations; i++) {
+    previous = current;
+    if (i % kSamplesPerSymbol == 0) {
+      current = bipolar_bit(bit_index++);
+    }
+    integral_value += (current + previous) / 2;
+
+    if (i % kOverSampleFactor == 0) {
+      const double phase =
+          TWO_PI_VAL * AFSK_CENTER_FREQUENCY / kSampleFrequency * i +
+          TWO_PI_VAL * AFSK_FREQUENCY_DEVIATION / kSampleFrequency *
+              integral_value;
+      audio.push_back(static_cast<int16_t>(
+          MAX_SAMPLE_VALUE * (std::cos(phase) * amplitude)));
+    }
+  }
+}
+
+/**
+ * @brief The table driven synthesizer matches the oversampled one to within
+ * rounding, including where a second block of data picks up the phase.
+ */
+TEST(Afsk, TableSynthesisMatchesOversampledSynthesis) {
+  signal_easel::afsk::Settings settings;
+  settings.include_ascii_padding = false;
+  settings.amplitude = 0.7;
+
+  const std::vector<uint8_t> kFirst = {0x7E, 0x00, 0xFF, 0xA5, 0x3C, 0x01};
+  const std::vector<uint8_t> kSecond = {'H', 'e', 'l', 'l', 'o', 0x55, 0x80};
+
+  signal_easel::afsk::Modulator modulator(settings);
+  modulator.addBytes(kFirst);
+  modulator.addBytes(kSecond);
+
+  std::vector<int16_t> reference;
+  int32_t integral_value = 0;
+  referenceAfskSynthesis(kFirst, settings.amplitude, integral_value, reference);
+  referenceAfskSynthesis(kSecond, settings.amplitude, integral_value,
+                         reference);
+
+  const auto &audio = modulator.getAudioBuffer();
+  ASSERT_EQ(audio.size(), reference.size());
+  for (size_t i = 0; i < audio.size(); i++) {
+    ASSERT_LE(std::abs(audio[i] - reference[i]), 1) << i;
+  }
+}
+
+namespace {
+
+/// @brief Exposes the audio buffer so audio can be handed over directly
+class BufferDemodulator : public signal_easel::afsk::Demodulator {
+public:
+  using signal_easel::afsk::Demodulator::Demodulator;
+  void setAudio(const std::vector<int16_t> &audio) { audio_buffer_ = audio; }
+};
+
+/// @brief Takes the demodulated bits directly, as a string of '0' and '1'
+class BitsDemodulator : public signal_easel::afsk::Demodulator {
+public:
+  void setBits(const std::string &bits) {
+    output_bit_stream_.clear();
+    for (char bit : bits) {
+      if (bit == '1') {
+        output_bit_stream_.addOneBit();
+      } else {
+        output_bit_stream_.addZeroBit();
+      }
+    }
+    output_bit_stream_.pushBufferToBitStream();
+  }
+};
+
+/// @brief The bits of each character, most significant first
+std::string asciiBits(const std::string &text) {
+  std::string bits;
+  for (char character : text) {
+    for (int i = 7; i >= 0; i--) {
+      bits += (character >> i) & 1 ? '1' : '0';
+    }
+  }
+  return bits;
+}
+
+} // namespace
+
+/**
+ * @brief The clock recovery can gain or lose a few bits while it settles in
+ * the SYN preamble, lookForString() re-aligns on the SYN characters after
+ * the slip.
+ */
+TEST(Afsk, LookForStringRealignsOnSlippedPreamble) {
+  const std::string kInputString = "Hello World!";
+  const std::string syns = asciiBits(std::string(4, '\x16'));
+  const std::string message = asciiBits("\x02" + kInputString + "\x04");
+
+  for (int slip = -7; slip <= 7; slip++) {
+    // A few bits of noise before the preamble
+    std::string bits = "101" + syns;
+    if (slip > 0) {
+      bits += std::string(slip, '1');
+    } else {
+      bits.resize(bits.size() + slip);
+    }
+    bits += syns + message;
+
+    BitsDemodulator demodulator;
+    demodulator.setBits(bits);
+    std::string output;
+    EXPECT_EQ(demodulator.lookForString(output),
+              signal_easel::afsk::Demodulator::AsciiResult::SUCCESS)
+        << slip;
+    EXPECT_EQ(kInputString, output) << slip;
+  }
+}
+
+/**
+ * @brief The text right after the preamble is not mistaken for a slipped
+ * SYN, and there is no text without a preamble.
+ */
+TEST(Afsk, LookForStringEndOfPreamble) {
+  BitsDemodulator demodulator;
+  std::string output;
+
+  // The last bit of the STX and the first 7 of ',' read as a SYN
+  demodulator.setBits(asciiBits("\x16\x16\x16\x02,Hello\x04"));
+  EXPECT_EQ(demodulator.lookForString(output),
+            signal_easel::afsk::Demodulator::AsciiResult::SUCCESS);
+  EXPECT_EQ(output, ",Hello");
+
+  // The preamble ends where the text starts, even without an STX
+  demodulator.setBits(asciiBits("\x16\x16\x16Hello\x04"));
+  EXPECT_EQ(demodulator.lookForString(output),
+            signal_easel::afsk::Demodulator::AsciiResult::SUCCESS);
+  EXPECT_EQ(output, "Hello");
+
+  demodulator.setBits(asciiBits("Hello World!"));
+  EXPECT_EQ(demodulator.lookForString(output),
+            signal_easel::afsk::Demodulator::AsciiResult::NO_SYN);
+  EXPECT_TRUE(output.empty());
+}
+
+/**
+ * @brief Tones mistuned by up to the AFC range are found and decoded in one
+ * pass, with either engine.
+ */
+TEST(Afsk, AutomaticFrequencyControl) {
+  const std::string kInputString = "Hello World! How are you today?";
+  signal_easel::afsk::Modulator modulator;
+  modulator.addString(kInputString);
+
+  for (double offset : {-180.0, -75.0, 0.0, 120.0, 180.0}) {
+    signal_easel::ChannelSimulator::Settings channel_settings;
+    channel_settings.add_noise = true;
+    channel_settings.eb_n0_db = 20.0;
+    channel_settings.frequency_offset = offset;
+    signal_easel::ChannelSimulator channel(channel_settings);
+    std::vector<int16_t> shifted;
+    channel.process(modulator.getAudioBuffer(), shifted);
+
+    for (auto engine :
+         {signal_easel::afsk::Settings::DemodulationEngine::CORRELATOR,
+          signal_easel::afsk::Settings::DemodulationEngine::QUADRATURE_MIXER}) {
+      signal_easel::afsk::Settings settings;
+      settings.afc_range = signal_easel::afsk::AFSK_AFC_MAX_RANGE;
+      settings.demodulation_engine = engine;
+      BufferDemodulator demodulator(settings);
+      demodulator.setAudio(shifted);
+      const auto results = demodulator.processAudioBuffer();
+      EXPECT_NEAR(results.frequency_offset, offset, 10.0) << offset;
+
+      std::string output;
+      EXPECT_EQ(demodulator.lookForString(output),
+                signal_easel::afsk::Demodulator::AsciiResult::SUCCESS)
+          << offset;
+      EXPECT_EQ(kInputString, output) << offset;
+    }
+  }
+}
+
+TEST(Afsk, AutomaticFrequencyControlIgnoresNoise) {
+  signal_easel::afsk::Settings settings;
+  settings.afc_range = signal_easel::afsk::AFSK_AFC_MAX_RANGE;
+  signal_easel::afsk::Demodulator demodulator(settings);
+  demodulator.loadAudioFromFile("white_noise.wav");
+  EXPECT_EQ(demodulator.processAudioBuffer().frequency_offset, 0.0);
+
+  settings.afc_range = signal_easel::afsk::AFSK_AFC_MAX_RANGE + 1;
+  EXPECT_ANY_THROW(signal_easel::afsk::Demodulator{settings});
+}
+
+/**
+ * @brief The SNR estimate against the SNR of the noise actually added to
+ * AX.25 packets, over the band it's defined on.
+ */
+TEST(Afsk, SnrEstimatorCalibration) {
+  std::vector<int16_t> clean;
+  wavgen::Reader reader("multi_packet_aprs.wav");
+  reader.getAllSamples(clean);
+  // Room for the noise without clipping
+  for (auto &sample : clean) {
+    sample = static_cast<int16_t>(sample / 20);
+  }
+
+  // The first eight blocks are all packet
+  constexpr size_t BLOCK_SIZE = 16000;
+  constexpr size_t NUM_BLOCKS = 8;
+  ASSERT_GE(clean.size(), BLOCK_SIZE * NUM_BLOCKS);
+  const double noise_bandwidth =
+      signal_easel::afsk::AFSK_BP_SPACE_UPPER_CUTOFF -
+      signal_easel::afsk::AFSK_BP_MARK_LOWER_CUTOFF;
+
+  // Mistuned tones are only found by searching the AFC range
+  struct Case {
+    double frequency_offset;
+    uint32_t afc_range;
+  };
+  for (const Case &test_case :
+       {Case{0.0, 0}, Case{0.0, signal_easel::afsk::AFSK_AFC_MAX_RANGE},
+        Case{-180.0, signal_easel::afsk::AFSK_AFC_MAX_RANGE},
+        Case{130.0, signal_easel::afsk::AFSK_AFC_MAX_RANGE}}) {
+    for (double eb_n0 : {0.0, 5.0, 10.0, 15.0}) {
+      signal_easel::ChannelSimulator::Settings channel_settings;
+      channel_settings.eb_n0_db = eb_n0;
+      channel_settings.frequency_offset = test_case.frequency_offset;
+      std::vector<int16_t> shifted;
+      signal_easel::ChannelSimulator(channel_settings).process(clean, shifted);
+      channel_settings.add_noise = true;
+      std::vector<int16_t> noisy;
+      signal_easel::ChannelSimulator(channel_settings).process(clean, noisy);
+
+      signal_easel::afsk::SnrEstimator estimator(
+          signal_easel::AUDIO_SAMPLE_RATE, test_case.afc_range);
+      for (size_t i = 0; i < NUM_BLOCKS * BLOCK_SIZE; i += BLOCK_SIZE) {
+        double signal = 0.0;
+        double noise = 0.0;
+        for (size_t j = i; j < i + BLOCK_SIZE; j++) {
+          const double difference = noisy[j] - shifted[j];
+          signal += static_cast<double>(shifted[j]) * shifted[j];
+          noise += difference * difference;
+        }
+        // White noise spreads evenly up to AUDIO_SAMPLE_RATE / 2
+        noise *= noise_bandwidth / (signal_easel::AUDIO_SAMPLE_RATE / 2.0);
+        const double expected = 10.0 * std::log10(signal / noise);
+
+        estimator.process(noisy.data() + i, BLOCK_SIZE);
+        signal_easel::afsk::Demodulator::ProcessResults results;
+        estimator.estimate(results);
+        EXPECT_NEAR(results.snr, expected, 2.5)
+            << test_case.frequency_offset << " " << eb_n0 << " " << i;
+      }
+    }
+  }
+}
+
+TEST(Afsk, SnrEstimatorNoiseAndSilence) {
+  std::mt19937 generator(4);
+  std::normal_distribution<double> distribution(0.0, 3000.0);
+  std::vector<int16_t> noise(signal_easel::AUDIO_SAMPLE_RATE * 10);
+  for (auto &sample : noise) {
+    sample = static_cast<int16_t>(std::lround(distribution(generator)));
+  }
+
+  // Blocks the size the receiver sees, none of them should look like a signal
+  // even when searching for mistuned tones
+  constexpr size_t BLOCK_SIZE = 16000;
+  signal_easel::afsk::Demodulator::ProcessResults results;
+  for (uint32_t afc_range : {0U, signal_easel::afsk::AFSK_AFC_MAX_RANGE}) {
+    signal_easel::afsk::SnrEstimator estimator(signal_easel::AUDIO_SAMPLE_RATE,
+                                               afc_range);
+    for (size_t i = 0; i + BLOCK_SIZE <= noise.size(); i += BLOCK_SIZE) {
+      estimator.process(noise.data() + i, BLOCK_SIZE);
+      estimator.estimate(results);
+      EXPECT_LT(results.snr, signal_easel::afsk::AFSK_SNR_THRESHOLD)
+          << afc_range << " " << i;
+      EXPECT_NEAR(results.rms, 3000.0, 100.0);
+    }
+  }
+
+  signal_easel::afsk::SnrEstimator estimator(signal_easel::AUDIO_SAMPLE_RATE);
+  const std::vector<int16_t> silence(BLOCK_SIZE, 0);
+  estimator.process(silence.data(), silence.size());
+  estimator.estimate(results);
+  EXPECT_EQ(results.snr, signal_easel::afsk::AFSK_MINIMUM_SNR);
+  EXPECT_EQ(results.rms, 0.0);
+
+  // Nothing at all
+  estimator.estimate(results);
+  EXPECT_EQ(results.snr, signal_easel::afsk::AFSK_MINIMUM_SNR);
+}
+
+TEST(Afsk, SnrEstimatorBlockSize) {
+  std::vector<int16_t> audio;
+  wavgen::Reader reader("aprs_real.wav");
+  reader.getAllSamples(audio);
+
+  signal_easel::afsk::SnrEstimator whole(signal_easel::AUDIO_SAMPLE_RATE);
+  whole.process(audio.data(), audio.size());
+  signal_easel::afsk::Demodulator::ProcessResults expected;
+  whole.estimate(expected);
+  EXPECT_GT(expected.snr, signal_easel::afsk::AFSK_SNR_THRESHOLD);
+
+  // Uneven blocks, as audio arrives from a sound card
+  signal_easel::afsk::SnrEstimator streamed(signal_easel::AUDIO_SAMPLE_RATE);
+  constexpr size_t BLOCK_SIZE = 1013;
+  for (size_t i = 0; i < audio.size(); i += BLOCK_SIZE) {
+    streamed.process(audio.data() + i, std::min(BLOCK_SIZE, audio.size() - i));
+  }
+  signal_easel::afsk::Demodulator::ProcessResults results;
+  streamed.estimate(results);
+  EXPECT_EQ(results.snr, expected.snr);
+  EXPECT_DOUBLE_EQ(results.rms, expected.rms);
+}
@@ -0,0 +1,102 @@
+/// =*============================= SignalEasel ==============================*=
+/// A C++ library for audio modulation/demodulation into analog & digital modes.
+/// Detailed documentation can be found here: https://signaleasel.joshuajer.red
+///
+/// @author Joshua Jerred
+/// @date   2026-10-19
+///
+/// @copyright Copyright 2026 Joshua Jerred. All rights reserved.
+/// @license   This project is licensed under the GNU GPL v3.0 license.
+/// =*========================================================================*=
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include <SignalEasel/aprs.hpp>
+#include <SignalEasel/aprs/base91.hpp>
+#include <SignalEasel/exception.hpp>
+
+using namespace signal_easel;
+
+namespace {
+
+// Pre-encoded at compile time, 49.5 degrees latitude from the APRS spec
+constexpr std::array<uint8_t, 4> LATITUDE = aprs::base91EncodeFixed<4>(
+    static_cast<uint32_t>(380926 * (90 - 49.5)));
+static_assert(LATITUDE[0] == '5' && LATITUDE[1] == 'L' &&
+              LATITUDE[2] == '!' && LATITUDE[3] == '!');
+
+constexpr std::array<uint8_t, 6> TELEMETRY =
+    aprs::base91EncodeBatch<2>(std::array<uint32_t, 3>{0, 8280, 91});
+static_assert(TELEMETRY[0] == '!' && TELEMETRY[1] == '!' &&
+              TELEMETRY[2] == '{' && TELEMETRY[3] == '{' &&
+              TELEMETRY[4] == '"' && TELEMETRY[5] == '!');
+
+constexpr uint32_t decodeAtCompileTime(std::string_view field) {
+  uint32_t value = 0;
+  return aprs::base91Decode(field, value) ? value : 0xFFFFFFFF;
+}
+static_assert(decodeAtCompileTime("5L!!") == 15427503);
+static_assert(decodeAtCompileTime("") == 0xFFFFFFFF);
+
+} // namespace
+
+TEST(AprsBase91, FixedWidthRoundTrip) {
+  for (uint32_t value : {0U, 1U, 90U, 91U, 8280U, 753570U, 68574960U}) {
+    std::array<uint8_t, 4> field{};
+    ASSERT_TRUE(aprs::base91EncodeFixed(value, field)) << value;
+    uint32_t decoded = 0;
+    ASSERT_TRUE(aprs::base91DecodeFixed(field, decoded));
+    EXPECT_EQ(decoded, value);
+
+    // The allocating API gives the same characters
+    const auto encoded = aprs::base91Encode(static_cast<int>(value), 4);
+    EXPECT_EQ(encoded, std::vector<uint8_t>(field.begin(), field.end()));
+    EXPECT_EQ(aprs::base91Decode(encoded), static_cast<int>(value));
+  }
+}
+
+TEST(AprsBase91, OutOfRange) {
+  std::array<uint8_t, 2> field = {'a', 'b'};
+  EXPECT_FALSE(aprs::base91EncodeFixed(8281, field));
+  EXPECT_EQ(field[0], 'a'); // untouched
+  EXPECT_THROW(aprs::base91EncodeFixed<2>(8281), Exception);
+  EXPECT_THROW(aprs::base91Encode(8281, 2), Exception);
+  EXPECT_THROW(aprs::base91Encode(-1, 2), Exception);
+  EXPECT_THROW(aprs::base91Encode(0, 5), Exception);
+
+  uint32_t value = 7;
+  EXPECT_FALSE(aprs::base91Decode("a b", value));
+  EXPECT_FALSE(aprs::base91Decode("!!!!!", value));
+  EXPECT_FALSE(aprs::base91Decode("|", value));
+  EXPECT_EQ(value, 7U);
+}
+
+TEST(AprsBase91, PositionOutOfRange) {
+  aprs::PositionPacket position;
+  position.latitude = 90.5;
+  EXPECT_THROW(position.encode(), Exception);
+
+  position.latitude = std::numeric_limits<float>::quiet_NaN();
+  EXPECT_THROW(position.encode(), Exception);
+
+  position.latitude = 0;
+  position.longitude = std::numeric_limits<float>::infinity();
+  EXPECT_THROW(position.encode(), Exception);
+
+  position.longitude = 0;
+  EXPECT_NO_THROW(position.encode());
+}
+
+TEST(AprsBase91, Batch) {
+  const std::array<uint32_t, 4> values = {1, 2, 8281, 4};
+  std::array<uint8_t, 8> output{};
+  EXPECT_TRUE(aprs::base91EncodeBatch<2>(values.data(), 2, output.data()));
+  EXPECT_EQ(output[1], '"');
+  EXPECT_EQ(output[3], '#');
+  EXPECT_FALSE(aprs::base91EncodeBatch<2>(values.data(), 4, output.data()));
+}
@@ -0,0 +1,160 @@
+/// =*============================= SignalEasel ==============================*=
+/// A C++ library for audio modulation/demodulation into analog & digital modes.
+/// Detailed documentation can be found here: https://signaleasel.joshuajer.red
+///
+/// @author Joshua Jerred
+/// @date   2026-10-19
+///
+/// @copyright Copyright 2026 Joshua Jerred. All rights reserved.
+/// @license   This project is licensed under the GNU GPL v3.0 license.
+/// =*========================================================================*=
+
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include <SignalEasel/aprs.hpp>
+#include <SignalEasel/aprs/position_parser.hpp>
+
+using namespace signal_easel;
+using aprs::PositionPacket;
+
+// Most of the examples are from the APRS 1.0.1 specification
+
+TEST(AprsPositionParser, UncompressedWithoutTimestamp) {
+  PositionPacket position;
+  ASSERT_TRUE(aprs::parsePositionInformation(
+      "!4903.50N/07201.75W-Test 001234", position));
+  EXPECT_EQ(position.format, PositionPacket::Format::UNCOMPRESSED);
+  EXPECT_EQ(position.time_code, "");
+  EXPECT_NEAR(position.latitude, 49.058333, 0.00001);
+  EXPECT_NEAR(position.longitude, -72.029167, 0.00001);
+  EXPECT_EQ(position.symbol_table, aprs::Packet::SymbolTable::PRIMARY);
+  EXPECT_EQ(position.symbol, '-');
+  EXPECT_EQ(position.comment, "Test 001234");
+
+  ASSERT_TRUE(
+      aprs::parsePositionInformation("=4903.50S\\07201.75E&", position));
+  EXPECT_NEAR(position.latitude, -49.058333, 0.00001);
+  EXPECT_NEAR(position.longitude, 72.029167, 0.00001);
+  EXPECT_EQ(position.symbol_table, aprs::Packet::SymbolTable::SECONDARY);
+  EXPECT_EQ(position.symbol, '&');
+  EXPECT_EQ(position.comment, "");
+}
+
+TEST(AprsPositionParser, UncompressedWithTimestamp) {
+  PositionPacket position;
+  ASSERT_TRUE(aprs::parsePositionInformation(
+      "@092345z4903.50N/07201.75W>088/036/A=001234Hello", position));
+  EXPECT_EQ(position.time_code, "092345");
+  EXPECT_EQ(position.symbol, '>');
+  EXPECT_EQ(position.course, 88);
+  EXPECT_FLOAT_EQ(position.speed, 36.0F);
+  EXPECT_EQ(position.altitude, 1234);
+  EXPECT_EQ(position.comment, "Hello");
+
+  // Local time, and an altitude in the middle of the comment
+  ASSERT_TRUE(aprs::parsePositionInformation(
+      "/092345/4903.50N/07201.75W>Going /A=-00012 down", position));
+  EXPECT_EQ(position.time_code, "092345");
+  EXPECT_EQ(position.course, 0);
+  EXPECT_EQ(position.altitude, -12);
+  EXPECT_EQ(position.comment, "Going  down");
+}
+
+TEST(AprsPositionParser, PositionAmbiguity) {
+  PositionPacket position;
+  ASSERT_TRUE(aprs::parsePositionInformation("!4903.  N/07201.  W-", position));
+  EXPECT_NEAR(position.latitude, 49.05, 0.00001);
+  EXPECT_NEAR(position.longitude, -72.016667, 0.00001);
+}
+
+TEST(AprsPositionParser, Compressed) {
+  PositionPacket position;
+  ASSERT_TRUE(aprs::parsePositionInformation("!/5L!!<*e7>7P[", position));
+  EXPECT_EQ(position.format, PositionPacket::Format::COMPRESSED);
+  EXPECT_NEAR(position.latitude, 49.5, 0.0001);
+  EXPECT_NEAR(position.longitude, -72.75, 0.0001);
+  EXPECT_EQ(position.symbol, '>');
+  EXPECT_EQ(position.course, 88);
+  EXPECT_NEAR(position.speed, 36.2, 0.1);
+
+  // Altitude in the cs bytes, from a GGA fix
+  ASSERT_TRUE(aprs::parsePositionInformation("!/5L!!<*e7OS]S", position));
+  EXPECT_NEAR(position.altitude, 10004, 1);
+  EXPECT_EQ(position.course, 0);
+
+  // No csT data, with a timestamp and an overlay
+  ASSERT_TRUE(
+      aprs::parsePositionInformation("@092345zA5L!!<*e7>   comment", position));
+  EXPECT_EQ(position.time_code, "092345");
+  EXPECT_EQ(position.symbol_table, aprs::Packet::SymbolTable::SECONDARY);
+  EXPECT_FLOAT_EQ(position.speed, 0.0F);
+  EXPECT_EQ(position.comment, "comment");
+}
+
+TEST(AprsPositionParser, MicE) {
+  PositionPacket position;
+  ASSERT_TRUE(
+      aprs::parseMicEInformation("S32UVT", "`(_fn\"Oj/\"4T}Hi", position));
+  EXPECT_EQ(position.format, PositionPacket::Format::MIC_E);
+  EXPECT_NEAR(position.latitude, 33.427333, 0.00001);
+  EXPECT_NEAR(position.longitude, -112.129, 0.00001);
+  EXPECT_FLOAT_EQ(position.speed, 20.0F);
+  EXPECT_EQ(position.course, 251);
+  EXPECT_EQ(position.symbol, 'j');
+  EXPECT_EQ(position.symbol_table, aprs::Packet::SymbolTable::PRIMARY);
+  EXPECT_EQ(position.altitude, 200); // 61m
+  EXPECT_EQ(position.comment, "Hi");
+
+  // South and east, with a radio type byte and no altitude
+  ASSERT_TRUE(aprs::parseMicEInformation("332564", "'(_fn\"Oj/]Hi", position));
+  EXPECT_LT(position.latitude, 0.0F);
+  EXPECT_NEAR(position.longitude, 12.129, 0.00001);
+  EXPECT_EQ(position.altitude, 0);
+  EXPECT_EQ(position.comment, "Hi");
+}
+
+TEST(AprsPositionParser, MalformedReportsAreRejected) {
+  PositionPacket position;
+  for (const std::string info :
+       {"", "!", "!4903.50N/07201.75", "!4903.50X/07201.75W-",
+        "!49O3.50N/07201.75W-", "!4903.50N|07201.75W-", "@0923z4903.50N",
+        "@092345x4903.50N/07201.75W-", "!/5L!!<*e", "!/5L! <*e7>7P[",
+        ":N0CALL   :message"}) {
+    EXPECT_FALSE(aprs::parsePositionInformation(info, position)) << info;
+  }
+
+  EXPECT_FALSE(aprs::parseMicEInformation("S32U", "`(_fn\"Oj/", position));
+  EXPECT_FALSE(aprs::parseMicEInformation("S32UVT", "`(_fn\"Oj", position));
+  EXPECT_FALSE(aprs::parseMicEInformation("S3-UVT", "`(_fn\"Oj/", position));
+}
+
+TEST(AprsPositionParser, ClassifiesEveryPositionFormat) {
+  for (char data_type : {'!', '=', '/', '@', '`', '\''}) {
+    EXPECT_TRUE(aprs::isPositionDataType(data_type)) << data_type;
+  }
+  for (char data_type : {':', '{', 'T', '>', ';'}) {
+    EXPECT_FALSE(aprs::isPositionDataType(data_type)) << data_type;
+  }
+}
+
+TEST(AprsPositionParser, ReceivedUncompressedReport) {
+  // N7PDI-1>MTT4BT:/000000h4157.71N\11130.86W&/Amazon Digi/A=007547
+  aprs::Demodulator demodulator;
+  demodulator.loadAudioFromFile("aprs_real.wav");
+  demodulator.processAudioBuffer();
+  ASSERT_TRUE(demodulator.lookForAx25Packet());
+  ASSERT_EQ(demodulator.getType(), aprs::Packet::Type::POSITION);
+
+  PositionPacket position;
+  ASSERT_TRUE(demodulator.parsePositionPacket(position));
+  EXPECT_EQ(position.source_address, "N7PDI");
+  EXPECT_EQ(position.time_code, "000000");
+  EXPECT_NEAR(position.latitude, 41.961833, 0.00001);
+  EXPECT_NEAR(position.longitude, -111.514333, 0.00001);
+  EXPECT_EQ(position.symbol_table, aprs::Packet::SymbolTable::SECONDARY);
+  EXPECT_EQ(position.symbol, '&');
+  EXPECT_EQ(position.altitude, 7547);
+  EXPECT_EQ(position.comment, "/Amazon Digi");
+}
@@ -36,7 +36,9 @@
 #include <SignalEasel/ax25.hpp>
 #include <wav_gen.hpp>
 
+#include <algorithm>
 #include <memory>
+#include <string>
 #include <vector>
 
 namespace signal_easel {
@@ -172,3 +174,321 @@ TEST(AprsReceiver, DecodeMultipleAprsPacketsChunked) {
 
   EXPECT_GT(verified_count, 0) << "No experimental packets found in queue";
 }
+
+/**
+ * @brief Same as DecodeMultipleAprsPacketsChunked, but with the decimating
+ * front end so detection and decoding run at a reduced rate.
+ */
+TEST(AprsReceiver, DecodeMultipleAprsPacketsDecimatingFrontEnd) {
+  const std::string kInputFile = "multi_packet_aprs.wav";
+
+  auto reference_reader =
+      std::make_shared<signal_easel::aprs::FakePulseAudioReader>(kInputFile);
+  signal_easel::aprs::TestableAprsReceiver reference(reference_reader);
+  while (reference.process()) {
+  }
+  const uint32_t kExpectedPackets =
+      reference.getStats().total_experimental_packets;
+
+  for (uint32_t sample_rate : {9600u, 12000u, 24000u}) {
+    signal_easel::aprs::Settings settings;
+    settings.demodulation_sample_rate = sample_rate;
+    settings.decimating_front_end = true;
+
+    auto fake_reader =
+        std::make_shared<signal_easel::aprs::FakePulseAudioReader>(kInputFile);
+    signal_easel::aprs::TestableAprsReceiver receiver(fake_reader, settings);
+
+    const int kMaxChunks = 10000;
+    int chunk_count = 0;
+    while (chunk_count < kMaxChunks && receiver.process()) {
+      chunk_count++;
+    }
+
+    EXPECT_GE(receiver.getStats().total_experimental_packets, kExpectedPackets)
+        << sample_rate;
+
+    signal_easel::aprs::ExperimentalPacket packet;
+    signal_easel::ax25::Frame frame;
+    while (receiver.getAprsExperimental(packet, frame)) {
+      EXPECT_EQ(packet.source_address, "KD9GDC");
+      EXPECT_EQ(packet.getStringData(), "0000000acmd/dat/cae/");
+    }
+  }
+}
+
+TEST(AprsReceiver, DecimatingFrontEndRequiresIntegerFactor) {
+  signal_easel::aprs::Settings settings;
+  settings.demodulation_sample_rate = 14400;
+  settings.decimating_front_end = true;
+  EXPECT_ANY_THROW(signal_easel::aprs::Receiver receiver(settings));
+}
+
+/**
+ * @brief The waterfall feed gets the full rate audio, even behind the
+ * decimating front end, and shows the tones in the AFSK band.
+ */
+TEST(AprsReceiver, SpectrumFeed) {
+  signal_easel::aprs::Settings settings;
+  settings.demodulation_sample_rate = 12000;
+  settings.decimating_front_end = true;
+
+  auto fake_reader = std::make_shared<signal_easel::aprs::FakePulseAudioReader>(
+      "aprs_message.wav");
+  signal_easel::aprs::TestableAprsReceiver receiver(fake_reader, settings);
+  std::vector<signal_easel::SpectrumAnalyzer::Spectrum> spectra;
+  EXPECT_EQ(receiver.getSpectrumAnalyzer(), nullptr);
+  EXPECT_FALSE(receiver.takeSpectra(spectra));
+
+  receiver.enableSpectrum();
+  while (receiver.process()) {
+  }
+  ASSERT_TRUE(receiver.takeSpectra(spectra));
+  std::vector<signal_easel::SpectrumAnalyzer::Spectrum> none;
+  EXPECT_FALSE(receiver.takeSpectra(none));
+  ASSERT_NE(receiver.getSpectrumAnalyzer(), nullptr);
+
+  // The loudest spectrum in the AFSK band, against the band above it
+  const auto &analyzer = *receiver.getSpectrumAnalyzer();
+  double signal = signal_easel::SPECTRUM_FLOOR_DB;
+  double above = signal_easel::SPECTRUM_FLOOR_DB;
+  for (const auto &spectrum : spectra) {
+    const double power = analyzer.getBandPower(spectrum, 1000, 2400);
+    if (power > signal) {
+      signal = power;
+      above = analyzer.getBandPower(spectrum, 4000, 5400);
+    }
+  }
+  EXPECT_GT(signal, above + 30.0);
+}
+
+TEST(AprsReceiver, ProcessingStats) {
+  const std::string kInputFile = "multi_packet_aprs.wav";
+
+  auto fake_reader =
+      std::make_shared<signal_easel::aprs::FakePulseAudioReader>(kInputFile);
+  signal_easel::aprs::TestableAprsReceiver receiver(fake_reader);
+
+  uint64_t chunk_count = 0;
+  while (receiver.process()) {
+    chunk_count++;
+  }
+
+  const auto stats = receiver.getProcessingStats();
+  if (!stats.enabled) {
+    GTEST_SKIP() << "Built without SIGNALEASEL_INSTRUMENTATION";
+  }
+
+  // The block that ended the loop was processed too
+  EXPECT_EQ(stats.audio_samples,
+            (chunk_count + 1) * signal_easel::PULSE_AUDIO_BUFFER_SIZE);
+
+  std::chrono::nanoseconds stage_time{0};
+  for (size_t i = 0; i < signal_easel::NUM_PROCESSING_STAGES; i++) {
+    EXPECT_GT(stats.stages.at(i).calls, 0u) << i;
+    EXPECT_GT(stats.stages.at(i).items, 0u) << i;
+    EXPECT_GT(stats.stages.at(i).time.count(), 0) << i;
+    stage_time += stats.stages.at(i).time;
+  }
+  EXPECT_LE(stage_time, stats.processing_time);
+
+  // Every block runs through detection, decoding runs some of them again
+  using signal_easel::ProcessingStage;
+  EXPECT_GE(stats.getStage(ProcessingStage::FILTER).items, stats.audio_samples);
+  EXPECT_GT(stats.getStage(ProcessingStage::FILTER).calls, chunk_count);
+  EXPECT_LT(stats.getStage(ProcessingStage::CLOCK_RECOVERY).calls,
+            chunk_count);
+  EXPECT_EQ(stats.getStage(ProcessingStage::PARSE).items,
+            receiver.getStats().total_experimental_packets);
+
+  EXPECT_GT(stats.getRealTimeFactor(), 0.0);
+  EXPECT_EQ(stats.latency.count,
+            receiver.getStats().total_experimental_packets);
+  EXPECT_GE(stats.latency.max, stats.latency.getMean());
+  EXPECT_EQ(stats.audio_overruns, 0u);
+  EXPECT_EQ(stats.queue_overruns, 0u);
+
+  receiver.resetProcessingStats();
+  const auto reset = receiver.getProcessingStats();
+  EXPECT_TRUE(reset.enabled);
+  EXPECT_EQ(reset.audio_samples, 0u);
+  EXPECT_EQ(reset.latency.count, 0u);
+  EXPECT_EQ(reset.getStage(ProcessingStage::FILTER).calls, 0u);
+}
+
+TEST(AprsReceiver, LatencyHistogramBuckets) {
+  using std::chrono::microseconds;
+  using std::chrono::milliseconds;
+  using signal_easel::LatencyHistogram;
+
+  EXPECT_EQ(LatencyHistogram::getBucketIndex(microseconds(10)), 0u);
+  EXPECT_EQ(LatencyHistogram::getBucketIndex(milliseconds(1)), 1u);
+  EXPECT_EQ(LatencyHistogram::getBucketIndex(milliseconds(3)), 2u);
+  EXPECT_EQ(LatencyHistogram::getBucketIndex(milliseconds(4)), 3u);
+  EXPECT_EQ(LatencyHistogram::getBucketIndex(std::chrono::hours(1)),
+            signal_easel::LATENCY_HISTOGRAM_BUCKETS - 1);
+  EXPECT_EQ(LatencyHistogram::getBucketUpperBound(2), milliseconds(4));
+
+  LatencyHistogram histogram;
+  histogram.add(milliseconds(2));
+  histogram.add(milliseconds(6));
+  EXPECT_EQ(histogram.count, 2u);
+  EXPECT_EQ(histogram.buckets.at(2), 1u);
+  EXPECT_EQ(histogram.buckets.at(3), 1u);
+  EXPECT_EQ(histogram.getMean(), milliseconds(4));
+  EXPECT_EQ(histogram.max, milliseconds(6));
+}
+
+namespace {
+
+std::vector<signal_easel::aprs::ExperimentalPacket>
+batchPackets(size_t count = 5) {
+  std::vector<signal_easel::aprs::ExperimentalPacket> packets(count);
+  for (size_t i = 0; i < packets.size(); i++) {
+    packets[i].source_address = "KD9GDC";
+    packets[i].source_ssid = 1;
+    packets[i].packet_type_char = 'b';
+    packets[i].setStringData("batch packet " + std::to_string(i));
+  }
+  return packets;
+}
+
+/// @brief Run the modulator's audio through the receiver, returning the
+/// string data of the experimental packets it decoded, in order.
+std::vector<std::string>
+receiveExperimental(signal_easel::aprs::Modulator &modulator,
+                    const std::string &file_name) {
+  modulator.writeToFile(file_name);
+
+  auto fake_reader =
+      std::make_shared<signal_easel::aprs::FakePulseAudioReader>(file_name);
+  signal_easel::aprs::TestableAprsReceiver receiver(fake_reader);
+  while (receiver.process()) {
+  }
+
+  std::vector<std::string> received;
+  signal_easel::aprs::ExperimentalPacket packet;
+  signal_easel::ax25::Frame frame;
+  while (receiver.getAprsExperimental(packet, frame)) {
+    received.push_back(packet.getStringData());
+  }
+  // The receiver hands out the newest packet first
+  std::reverse(received.begin(), received.end());
+  return received;
+}
+
+} // namespace
+
+/**
+ * @brief A batch sent as one burst, the frames separated by flags, decodes
+ * as every packet in order.
+ */
+TEST(AprsReceiver, EncodeBatchFlagFill) {
+  const auto packets = batchPackets();
+  signal_easel::aprs::Modulator modulator;
+  modulator.encodeBatch(packets);
+
+  const auto received =
+      receiveExperimental(modulator, "aprs_batch_flag_fill_test.wav");
+  ASSERT_EQ(received.size(), packets.size());
+  for (size_t i = 0; i < packets.size(); i++) {
+    EXPECT_EQ(received[i], packets[i].getStringData());
+  }
+}
+
+/**
+ * @brief A batch of separate transmissions is each packet as encode() renders
+ * it on it's own, with the silence between, on any number of threads.
+ */
+TEST(AprsReceiver, EncodeBatchSilenceThreads) {
+  const auto packets = batchPackets();
+  signal_easel::aprs::BatchSettings batch_settings;
+  batch_settings.separation =
+      signal_easel::aprs::BatchSettings::Separation::SILENCE;
+  batch_settings.silence_samples = signal_easel::AUDIO_SAMPLE_RATE / 4;
+
+  std::vector<int16_t> expected;
+  for (size_t i = 0; i < packets.size(); i++) {
+    if (i > 0) {
+      expected.insert(expected.end(), batch_settings.silence_samples, 0);
+    }
+    signal_easel::aprs::Modulator modulator;
+    modulator.encode(packets[i]);
+    const auto &audio = modulator.getAudioBuffer();
+    expected.insert(expected.end(), audio.begin(), audio.end());
+  }
+
+  for (unsigned int threads : {1U, 2U, 3U, 8U}) {
+    batch_settings.threads = threads;
+    signal_easel::aprs::Modulator modulator;
+    modulator.encodeBatch(packets, batch_settings);
+    EXPECT_EQ(modulator.getAudioBuffer(), expected) << threads;
+  }
+
+  signal_easel::aprs::Modulator empty;
+  EXPECT_THROW(
+      empty.encodeBatch(std::vector<signal_easel::aprs::ExperimentalPacket>()),
+      signal_easel::Exception);
+}
+
+/**
+ * @brief Packets other than messages that are never taken out don't stop
+ * the receiver, the oldest are dropped and counted as queue overruns.
+ */
+TEST(AprsReceiver, QueueOverrunDropsOldest) {
+  const auto packets = batchPackets(12);
+  signal_easel::aprs::Modulator modulator;
+  modulator.encodeBatch(packets);
+  const std::string kFile = "aprs_queue_overrun_test.wav";
+  modulator.writeToFile(kFile);
+
+  auto fake_reader =
+      std::make_shared<signal_easel::aprs::FakePulseAudioReader>(kFile);
+  signal_easel::aprs::TestableAprsReceiver receiver(fake_reader);
+  EXPECT_NO_THROW({
+    while (receiver.process()) {
+    }
+  });
+  EXPECT_EQ(receiver.getStats().current_experimental_packets_in_queue, 10u);
+  if (receiver.getProcessingStats().enabled) {
+    EXPECT_GE(receiver.getProcessingStats().queue_overruns, 2u);
+  }
+
+  // The newest packet is kept, and handed out first
+  signal_easel::aprs::ExperimentalPacket packet;
+  signal_easel::ax25::Frame frame;
+  ASSERT_TRUE(receiver.getAprsExperimental(packet, frame));
+  EXPECT_EQ(packet.getStringData(), packets.back().getStringData());
+}
+
+/**
+ * @brief Messages are never dropped, the decode that overfills their queue
+ * throws.
+ */
+TEST(AprsReceiver, MessageQueueOverrun) {
+  std::vector<signal_easel::aprs::MessagePacket> messages(11);
+  for (size_t i = 0; i < messages.size(); i++) {
+    messages[i].source_address = "KD9GDC";
+    messages[i].source_ssid = 1;
+    messages[i].addressee = "TSTCLL-11";
+    messages[i].message = "message " + std::to_string(i);
+    messages[i].message_id = std::to_string(i);
+  }
+  signal_easel::aprs::Modulator modulator;
+  modulator.encodeBatch(messages);
+  const std::string kFile = "aprs_message_queue_overrun_test.wav";
+  modulator.writeToFile(kFile);
+
+  auto fake_reader =
+      std::make_shared<signal_easel::aprs::FakePulseAudioReader>(kFile);
+  signal_easel::aprs::TestableAprsReceiver receiver(fake_reader);
+  EXPECT_THROW(
+      {
+        while (receiver.process()) {
+        }
+      },
+      signal_easel::Exception);
+  if (receiver.getProcessingStats().enabled) {
+    EXPECT_EQ(receiver.getProcessingStats().queue_overruns, 1u);
+  }
+}
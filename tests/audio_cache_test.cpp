@@ -0,0 +1,123 @@
+/// =*============================= SignalEasel ==============================*=
+/// A C++ library for audio modulation/demodulation into analog & digital modes.
+/// Detailed documentation can be found here: https://signaleasel.joshuajer.red
+///
+/// @author Joshua Jerred
+/// @date   2026-10-19
+///
+/// @copyright Copyright 2026 Joshua Jerred. All rights reserved.
+/// @license   This project is licensed under the GNU GPL v3.0 license.
+/// =*========================================================================*=
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include <SignalEasel/aprs.hpp>
+#include <SignalEasel/audio_cache.hpp>
+
+using namespace signal_easel;
+
+namespace {
+
+CachedAudio makeAudio(size_t num_samples, int16_t value = 1) {
+  CachedAudio audio;
+  audio.samples.assign(num_samples, value);
+  return audio;
+}
+
+aprs::PositionPacket makePosition(const std::string &comment) {
+  aprs::PositionPacket packet;
+  packet.source_address = "N0CALL";
+  packet.time_code = "092345";
+  packet.latitude = 40.0;
+  packet.longitude = -105.0;
+  packet.comment = comment;
+  return packet;
+}
+
+} // namespace
+
+TEST(AudioCache, LeastRecentlyUsedIsEvicted) {
+  // Room for three 1 character keys with 100 samples
+  AudioCache cache(3 * (1 + 100 * sizeof(int16_t)));
+  cache.insert("a", makeAudio(100, 1));
+  cache.insert("b", makeAudio(100, 2));
+  cache.insert("c", makeAudio(100, 3));
+
+  ASSERT_NE(cache.find("a"), nullptr); // a is now the most recent
+  cache.insert("d", makeAudio(100, 4));
+
+  EXPECT_EQ(cache.find("b"), nullptr);
+  ASSERT_NE(cache.find("a"), nullptr);
+  EXPECT_EQ(cache.find("c")->samples.front(), 3);
+  EXPECT_EQ(cache.find("d")->samples.front(), 4);
+
+  const auto stats = cache.getStats();
+  EXPECT_EQ(stats.hits, 4U);
+  EXPECT_EQ(stats.misses, 1U);
+  EXPECT_EQ(stats.evictions, 1U);
+  EXPECT_EQ(stats.entries, 3U);
+  EXPECT_EQ(stats.bytes, cache.getMaxBytes());
+}
+
+TEST(AudioCache, EvictedAudioOutlivesTheEntry) {
+  AudioCache cache(1000);
+  cache.insert("a", makeAudio(400));
+  const auto held = cache.find("a");
+  cache.insert("b", makeAudio(400)); // evicts a
+  EXPECT_EQ(cache.find("a"), nullptr);
+  ASSERT_NE(held, nullptr);
+  EXPECT_EQ(held->samples.size(), 400U);
+}
+
+TEST(AudioCache, OversizedAndReplacedEntries) {
+  AudioCache cache(1000);
+  cache.insert("big", makeAudio(1000));
+  EXPECT_EQ(cache.find("big"), nullptr);
+  EXPECT_EQ(cache.getStats().entries, 0U);
+
+  cache.insert("a", makeAudio(10, 1));
+  cache.insert("a", makeAudio(20, 2));
+  EXPECT_EQ(cache.find("a")->samples.size(), 20U);
+  EXPECT_EQ(cache.getStats().entries, 1U);
+  EXPECT_EQ(cache.getStats().bytes, 1 + 20 * sizeof(int16_t));
+
+  cache.clear();
+  EXPECT_EQ(cache.find("a"), nullptr);
+  EXPECT_EQ(cache.getStats().bytes, 0U);
+}
+
+TEST(AudioCache, CachedAudioMatchesRenderedAudio) {
+  const auto first = makePosition("first");
+  const auto second = makePosition("second");
+
+  aprs::Modulator uncached;
+  uncached.encode(first);
+  uncached.encode(second);
+
+  auto cache = std::make_shared<AudioCache>();
+  aprs::Modulator modulator;
+  modulator.useAudioCache(cache);
+
+  // The first burst renders, the repeats come from the cache
+  for (int i = 0; i < 3; i++) {
+    modulator.clearBuffer();
+    modulator.encode(first);
+    modulator.encode(second);
+    EXPECT_EQ(modulator.getAudioBuffer(), uncached.getAudioBuffer()) << i;
+  }
+
+  auto stats = cache->getStats();
+  EXPECT_EQ(stats.misses, 2U);
+  EXPECT_EQ(stats.hits, 4U);
+  EXPECT_EQ(stats.entries, 2U);
+
+  // A different packet, or the same packet at a different phase, misses
+  modulator.encode(makePosition("third"));
+  modulator.encode(second);
+  stats = cache->getStats();
+  EXPECT_EQ(stats.misses, 4U);
+}
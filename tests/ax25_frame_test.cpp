@@ -1,6 +1,11 @@
+#include <string>
+#include <utility>
+#include <vector>
+
 #include "gtest/gtest.h"
 
 #include <SignalEasel/ax25.hpp>
+#include <SignalEasel/exception.hpp>
 
 using namespace signal_easel;
 
@@ -14,4 +19,119 @@ TEST(Ax25_Frame, basicFrame) {
   frame.setSourceAddress(src_address);
 
   EXPECT_TRUE(frame.isFrameValid());
-}
\ No newline at end of file
+}
+
+TEST(Ax25_Frame, parseWithReusedBuffers) {
+  const std::vector<std::pair<std::string, std::string>> packets = {
+      {"SECOND", ">a longer frame, to grow the buffers"},
+      {"FIRST", ">short"}};
+
+  // The same streams and buffer are used for every frame, as the receiver
+  // does, so nothing from a longer frame may leak into a shorter one.
+  BitStream encoded;
+  BitStream decoded;
+  std::vector<uint8_t> frame_buffer;
+  ax25::Frame parsed;
+  for (const auto &[source, info] : packets) {
+    ax25::Frame frame;
+    frame.setDestinationAddress(ax25::Address("APRS", 0, false));
+    frame.setSourceAddress(ax25::Address(source, 1, true));
+    frame.setInformation(std::vector<uint8_t>(info.begin(), info.end()));
+    const auto bytes = frame.encodeFrame();
+
+    encoded.clear();
+    encoded.addBits(bytes.data(), static_cast<int>(bytes.size() * 8));
+    encoded.pushBufferToBitStream();
+    ax25::decodeNrzi(encoded, decoded);
+    EXPECT_EQ(static_cast<size_t>(decoded.getBitStreamLength()),
+              bytes.size() * 8);
+
+    ASSERT_TRUE(parsed.parseNrziDecodedBitStream(decoded, frame_buffer));
+    EXPECT_EQ(parsed.getSourceAddress().getAddressString(), source);
+    const auto &parsed_info = parsed.getInformationRef();
+    EXPECT_EQ(std::string(parsed_info.begin(), parsed_info.end()), info);
+  }
+}
+
+TEST(Ax25_Frame, encodeIntoReusedBuffer) {
+  // A bit at a time reference: flags, the frame LSB first with a 0 after
+  // five 1s, flags, then NRZI and packed MSB first.
+  auto reference_encode = [](ax25::Frame &frame) {
+    std::vector<bool> bits;
+    auto add_flags = [&bits](size_t count) {
+      for (size_t i = 0; i < count * 8; i++) {
+        bits.push_back((ax25::K_FLAG >> (7 - i % 8)) & 1);
+      }
+    };
+    add_flags(ax25::K_PREAMBLE_LENGTH);
+    int ones = 0;
+    for (uint8_t byte : frame.buildFrame()) {
+      for (int i = 0; i < 8; i++) {
+        const bool bit = (byte >> i) & 1;
+        bits.push_back(bit);
+        ones = bit ? ones + 1 : 0;
+        if (ones == 5) {
+          bits.push_back(false);
+          ones = 0;
+        }
+      }
+    }
+    add_flags(ax25::K_POSTAMBLE_LENGTH);
+
+    std::vector<uint8_t> encoded(bits.size() / 8, 0);
+    bool level = false;
+    for (size_t i = 0; i < encoded.size() * 8; i++) {
+      level = bits[i] ? level : !level;
+      encoded[i / 8] |= level << (7 - i % 8);
+    }
+    return encoded;
+  };
+
+  // Lengths and runs of 1s that leave the postamble at different bit offsets
+  const std::vector<std::string> infos = {
+      "", ">", "\xFF\xFF\xFF", ">a longer status, \x7E\x7E\x7E, to stuff",
+      std::string(ax25::K_MAX_INFORMATION_LENGTH, '\xFF')};
+
+  std::vector<uint8_t> encoded;
+  for (const auto &info : infos) {
+    ax25::Frame frame;
+    frame.setDestinationAddress(ax25::Address("APRS", 0, false));
+    frame.setSourceAddress(ax25::Address("N0CALL", 7, true));
+    frame.addRepeaterAddress(ax25::Address("WIDE1", 1, false));
+    frame.setInformation(std::vector<uint8_t>(info.begin(), info.end()));
+
+    frame.encodeFrame(encoded);
+    EXPECT_EQ(encoded, reference_encode(frame)) << info;
+    EXPECT_EQ(frame.encodeFrame(), encoded);
+  }
+}
+
+TEST(Ax25_Frame, encodeFramesWithFlagFill) {
+  std::vector<ax25::Frame> frames(3);
+  for (size_t i = 0; i < frames.size(); i++) {
+    const std::string info = ">frame " + std::to_string(i);
+    frames[i].setDestinationAddress(ax25::Address("APRS", 0, false));
+    frames[i].setSourceAddress(ax25::Address("N0CALL", i, true));
+    frames[i].setInformation(std::vector<uint8_t>(info.begin(), info.end()));
+  }
+
+  // A single frame is the same as encoding it on it's own
+  std::vector<uint8_t> encoded;
+  std::vector<ax25::Frame> single = {frames[0]};
+  ax25::encodeFrames(single, 1, encoded);
+  EXPECT_EQ(encoded, frames[0].encodeFrame());
+
+  // Every frame can be parsed back out of the burst, in order
+  ax25::encodeFrames(frames, 4, encoded);
+  BitStream nrzi;
+  nrzi.addBits(encoded.data(), static_cast<int>(encoded.size() * 8));
+  nrzi.pushBufferToBitStream();
+  BitStream decoded = ax25::decodeNrzi(nrzi);
+  for (size_t i = 0; i < frames.size(); i++) {
+    ax25::Frame parsed;
+    ASSERT_TRUE(parsed.parseNrziDecodedBitStream(decoded)) << i;
+    EXPECT_EQ(parsed.getInformation(), frames[i].getInformation());
+  }
+
+  EXPECT_THROW(ax25::encodeFrames(frames, 0, encoded), Exception);
+}
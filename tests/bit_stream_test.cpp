@@ -0,0 +1,79 @@
+/// =*============================= SignalEasel ==============================*=
+/// A C++ library for audio modulation/demodulation into analog & digital modes.
+/// Detailed documentation can be found here: https://signaleasel.joshuajer.red
+///
+/// @author Joshua Jerred
+/// @date   2026-10-19
+///
+/// @copyright Copyright 2026 Joshua Jerred. All rights reserved.
+/// @license   This project is licensed under the GNU GPL v3.0 license.
+/// =*========================================================================*=
+
+#include <cstdint>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include <SignalEasel/bit_stream.hpp>
+
+using namespace signal_easel;
+
+namespace {
+
+/// @brief The reference, one bit at a time, most significant first
+void addBitByBit(BitStream &stream, uint32_t bits, int num_bits) {
+  for (int i = num_bits - 1; i >= 0; i--) {
+    if ((bits >> i) & 1U) {
+      stream.addOneBit();
+    } else {
+      stream.addZeroBit();
+    }
+  }
+}
+
+std::vector<int> readAll(BitStream &stream) {
+  std::vector<int> bits;
+  for (int bit = stream.popNextBit(); bit != -1; bit = stream.popNextBit()) {
+    bits.push_back(bit);
+  }
+  return bits;
+}
+
+} // namespace
+
+TEST(BitStream_test, addWordMatchesBitByBit) {
+  const uint32_t word = 0xb5a3c96eU;
+  for (int offset = 0; offset < 40; offset++) {
+    for (int num_bits = 0; num_bits <= 32; num_bits++) {
+      BitStream reference;
+      BitStream stream;
+      addBitByBit(reference, 0x2aaaaaaaU, offset % 32);
+      addBitByBit(reference, 0x2aaaaaaaU, offset - offset % 32);
+      addBitByBit(stream, 0x2aaaaaaaU, offset % 32);
+      addBitByBit(stream, 0x2aaaaaaaU, offset - offset % 32);
+
+      addBitByBit(reference, word, num_bits);
+      stream.addWord(word, num_bits);
+      EXPECT_EQ(stream.getBitStreamLength(), reference.getBitStreamLength());
+
+      reference.pushBufferToBitStream();
+      stream.pushBufferToBitStream();
+      EXPECT_EQ(stream.getBitVector(), reference.getBitVector())
+          << "offset " << offset << " bits " << num_bits;
+    }
+  }
+}
+
+TEST(BitStream_test, addBitsAcrossWordBoundary) {
+  // Ten bits, starting one bit before the end of a word
+  const unsigned char data[2] = {0b10101010, 0b11000000};
+  BitStream stream;
+  addBitByBit(stream, 0x7fffffffU, 31);
+  stream.addBits(data, 10);
+  stream.pushBufferToBitStream();
+
+  const std::vector<int> bits = readAll(stream);
+  ASSERT_EQ(bits.size(), 64);
+  const std::vector<int> expected = {1, 0, 1, 0, 1, 0, 1, 0, 1, 1};
+  EXPECT_EQ(std::vector<int>(bits.begin() + 31, bits.begin() + 41), expected);
+}
@@ -0,0 +1,245 @@
+/// =*============================= SignalEasel ==============================*=
+/// A C++ library for audio modulation/demodulation into analog & digital modes.
+/// Detailed documentation can be found here: https://signaleasel.joshuajer.red
+///
+/// @author Joshua Jerred
+/// @date   2026-10-19
+///
+/// @copyright Copyright 2026 Joshua Jerred. All rights reserved.
+/// @license   This project is licensed under the GNU GPL v3.0 license.
+/// =*========================================================================*=
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include <wav_gen.hpp>
+
+#include <SignalEasel/aprs.hpp>
+#include <SignalEasel/channel_simulator.hpp>
+#include <SignalEasel/exception.hpp>
+
+using namespace signal_easel;
+
+namespace {
+
+std::vector<int16_t> makeTone(double frequency, size_t num_samples,
+                              double amplitude = 10000.0) {
+  std::vector<int16_t> tone(num_samples);
+  for (size_t i = 0; i < num_samples; i++) {
+    tone[i] = static_cast<int16_t>(std::round(
+        amplitude * std::sin(TWO_PI_VAL * frequency * i / AUDIO_SAMPLE_RATE)));
+  }
+  return tone;
+}
+
+/// @brief Count the upward zero crossings to estimate the frequency of a tone.
+double measureFrequency(const std::vector<int16_t> &samples) {
+  size_t first = 0;
+  size_t last = 0;
+  size_t crossings = 0;
+  for (size_t i = 1; i < samples.size(); i++) {
+    if (samples[i - 1] < 0 && samples[i] >= 0) {
+      if (crossings == 0) {
+        first = i;
+      }
+      last = i;
+      crossings++;
+    }
+  }
+  return (crossings - 1) * static_cast<double>(AUDIO_SAMPLE_RATE) /
+         (last - first);
+}
+
+/// @brief RMS, skipping the edges where the filters ramp up
+double measureRms(const std::vector<int16_t> &samples) {
+  constexpr size_t EDGE = 1000;
+  double sum = 0.0;
+  for (size_t i = EDGE; i < samples.size() - EDGE; i++) {
+    sum += static_cast<double>(samples[i]) * samples[i];
+  }
+  return std::sqrt(sum / (samples.size() - 2 * EDGE));
+}
+
+std::vector<int16_t> simulate(const ChannelSimulator::Settings &settings,
+                              const std::vector<int16_t> &input) {
+  ChannelSimulator channel(settings);
+  std::vector<int16_t> output;
+  channel.process(input, output);
+  return output;
+}
+
+} // namespace
+
+TEST(ChannelSimulator, DefaultSettingsArePassthrough) {
+  const auto tone = makeTone(1200, 4800);
+  EXPECT_EQ(simulate(ChannelSimulator::Settings(), tone), tone);
+}
+
+TEST(ChannelSimulator, SeededNoiseIsRepeatable) {
+  const auto tone = makeTone(1200, 4800);
+  ChannelSimulator::Settings settings;
+  settings.add_noise = true;
+  settings.eb_n0_db = 10.0;
+  settings.seed = 42;
+
+  const auto first = simulate(settings, tone);
+  EXPECT_EQ(simulate(settings, tone), first);
+  EXPECT_NE(first, tone);
+
+  settings.seed = 43;
+  EXPECT_NE(simulate(settings, tone), first);
+
+  // reset() restarts the sequence
+  ChannelSimulator channel(settings);
+  std::vector<int16_t> a;
+  std::vector<int16_t> b;
+  channel.process(tone, a);
+  channel.reset();
+  channel.process(tone, b);
+  EXPECT_EQ(a, b);
+}
+
+TEST(ChannelSimulator, NoiseLevelMatchesEbN0) {
+  constexpr double AMPLITUDE = 10000.0;
+  const auto tone = makeTone(1200, AUDIO_SAMPLE_RATE, AMPLITUDE);
+  ChannelSimulator::Settings settings;
+  settings.add_noise = true;
+  settings.eb_n0_db = 10.0;
+  settings.bit_rate = 1200;
+
+  ChannelSimulator channel(settings);
+  std::vector<int16_t> output;
+  channel.process(tone, output);
+
+  // sigma^2 = P * fs / (2 * Rb * Eb/N0)
+  const double power = AMPLITUDE * AMPLITUDE / 2.0;
+  const double expected =
+      std::sqrt(power * AUDIO_SAMPLE_RATE / (2.0 * 1200 * 10.0));
+  EXPECT_NEAR(channel.getNoiseLevel(), expected, expected * 0.01);
+
+  double error = 0.0;
+  for (size_t i = 0; i < tone.size(); i++) {
+    const double difference = static_cast<double>(output[i]) - tone[i];
+    error += difference * difference;
+  }
+  EXPECT_NEAR(std::sqrt(error / tone.size()), expected, expected * 0.02);
+}
+
+TEST(ChannelSimulator, FrequencyOffset) {
+  ChannelSimulator::Settings settings;
+  for (double offset : {-150.0, 35.0, 300.0}) {
+    settings.frequency_offset = offset;
+    const auto output = simulate(settings, makeTone(1700, AUDIO_SAMPLE_RATE));
+    EXPECT_NEAR(measureFrequency(output), 1700 + offset, 1.0) << offset;
+    EXPECT_NEAR(measureRms(output), 10000.0 / std::sqrt(2.0), 100.0) << offset;
+  }
+}
+
+TEST(ChannelSimulator, ClockDrift) {
+  ChannelSimulator::Settings settings;
+  settings.clock_drift_ppm = 1000.0;
+  const auto tone = makeTone(1000, AUDIO_SAMPLE_RATE);
+  const auto output = simulate(settings, tone);
+
+  // A fast clock squeezes the signal into fewer samples
+  EXPECT_NEAR(static_cast<double>(output.size()), tone.size() / 1.001, 1.0);
+  EXPECT_NEAR(measureFrequency(output), 1001.0, 0.1);
+
+  settings.clock_drift_ppm = -1000.0;
+  EXPECT_NEAR(measureFrequency(simulate(settings, tone)), 999.0, 0.1);
+}
+
+TEST(ChannelSimulator, Twist) {
+  ChannelSimulator::Settings settings;
+  for (double twist : {-6.0, 3.0, 9.0}) {
+    settings.twist_db = twist;
+    const double mark = measureRms(simulate(settings, makeTone(1200, 9600)));
+    const double space = measureRms(simulate(settings, makeTone(2200, 9600)));
+    const double center = measureRms(simulate(settings, makeTone(1700, 9600)));
+    EXPECT_NEAR(20.0 * std::log10(space / mark), twist, 0.3) << twist;
+    EXPECT_NEAR(center, 10000.0 / std::sqrt(2.0), 150.0) << twist;
+  }
+}
+
+TEST(ChannelSimulator, Dropouts) {
+  ChannelSimulator::Settings settings;
+  settings.dropout_rate = 10.0;
+  settings.dropout_duration = 0.005;
+  settings.seed = 7;
+
+  // A DC signal, so every zero is a dropout
+  const std::vector<int16_t> input(10 * AUDIO_SAMPLE_RATE, 1000);
+  const auto output = simulate(settings, input);
+  ASSERT_EQ(output.size(), input.size());
+
+  size_t muted = 0;
+  size_t dropouts = 0;
+  for (size_t i = 0; i < output.size(); i++) {
+    if (output[i] == 0) {
+      muted++;
+      dropouts += (i == 0 || output[i - 1] != 0) ? 1 : 0;
+    }
+  }
+
+  // ~100 dropouts of 240 samples
+  EXPECT_GT(dropouts, 70U);
+  EXPECT_LT(dropouts, 130U);
+  EXPECT_LE(muted, dropouts * 240);
+  EXPECT_GE(muted, (dropouts - 1) * 240);
+}
+
+TEST(ChannelSimulator, InvalidSettings) {
+  ChannelSimulator::Settings settings;
+  settings.bit_rate = 0;
+  EXPECT_THROW(ChannelSimulator{settings}, Exception);
+
+  settings = ChannelSimulator::Settings();
+  settings.frequency_offset = 20000.0;
+  EXPECT_THROW(ChannelSimulator{settings}, Exception);
+
+  settings = ChannelSimulator::Settings();
+  settings.dropout_rate = -1.0;
+  EXPECT_THROW(ChannelSimulator{settings}, Exception);
+}
+
+TEST(ChannelSimulator, AprsDecodesThroughImpairedChannel) {
+  aprs::MessagePacket packet;
+  packet.source_address = "TSTCLL";
+  packet.source_ssid = 11;
+  packet.addressee = "TSTCLL-11";
+  packet.message = "Hello World!";
+  packet.message_id = "1";
+
+  aprs::Modulator modulator;
+  modulator.encode(packet);
+
+  ChannelSimulator::Settings settings;
+  settings.add_noise = true;
+  settings.eb_n0_db = 25.0;
+  settings.frequency_offset = 20.0;
+  settings.clock_drift_ppm = 100.0;
+  settings.twist_db = -3.0;
+  settings.seed = 1;
+
+  const auto audio = simulate(settings, modulator.getAudioBuffer());
+  ASSERT_NE(audio, modulator.getAudioBuffer());
+
+  const std::string file_path = "channel_simulator_test.wav";
+  wavgen::Writer writer(file_path);
+  for (int16_t sample : audio) {
+    writer.addSample(sample);
+  }
+  writer.done();
+
+  aprs::Demodulator demodulator;
+  demodulator.loadAudioFromFile(file_path);
+  demodulator.processAudioBuffer();
+  ASSERT_TRUE(demodulator.lookForAx25Packet());
+
+  aprs::MessagePacket decoded;
+  ASSERT_TRUE(demodulator.parseMessagePacket(decoded));
+  EXPECT_EQ(decoded.message, packet.message);
+}
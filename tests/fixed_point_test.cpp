@@ -0,0 +1,203 @@
+/// =*============================= SignalEasel ==============================*=
+/// A C++ library for audio modulation/demodulation into analog & digital modes.
+/// Detailed documentation can be found here: https://signaleasel.joshuajer.red
+///
+/// @author Joshua Jerred
+/// @date   2026-10-19
+///
+/// @copyright Copyright 2026 Joshua Jerred. All rights reserved.
+/// @license   This project is licensed under the GNU GPL v3.0 license.
+/// =*========================================================================*=
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include <wav_gen.hpp>
+
+#include <SignalEasel/afsk.hpp>
+
+#include "src/afsk/tone_detector.hpp"
+#include "src/biquad_filter.hpp"
+
+using namespace signal_easel;
+
+namespace {
+
+std::vector<int16_t> loadWav(const std::string &path) {
+  std::vector<int16_t> samples;
+  wavgen::Reader reader(path);
+  reader.getAllSamples(samples);
+  return samples;
+}
+
+template <typename T>
+std::vector<double> filterAs(const std::vector<int16_t> &audio,
+                             const std::vector<BiquadCoefficients> &design) {
+  using Traits = SampleTraits<T>;
+  std::vector<T> input;
+  for (int16_t sample : audio) {
+    input.push_back(Traits::fromPcm(sample));
+  }
+  std::vector<T> output;
+  BiquadFilter<T>(design).process(input, output);
+
+  std::vector<double> result;
+  for (T sample : output) {
+    result.push_back(Traits::sumToDouble(Traits::toSum(sample)));
+  }
+  return result;
+}
+
+/// @brief 10*log10(signal power / error power)
+double signalToErrorDb(const std::vector<double> &reference,
+                       const std::vector<double> &test) {
+  double signal = 0.0;
+  double error = 0.0;
+  for (size_t i = 0; i < reference.size(); i++) {
+    signal += reference[i] * reference[i];
+    error += (reference[i] - test[i]) * (reference[i] - test[i]);
+  }
+  return 10.0 * std::log10(signal / error);
+}
+
+/// @brief Samples quieter than this are treated as silence
+constexpr int16_t SIGNAL_THRESHOLD = 256;
+
+template <typename T>
+void expectDecisionParity(const std::vector<int16_t> &audio,
+                          afsk::Settings::DemodulationEngine engine,
+                          double max_mismatch_ratio) {
+  afsk::BasicToneDetector<double> reference(AUDIO_SAMPLE_RATE, engine);
+  afsk::BasicToneDetector<T> detector(AUDIO_SAMPLE_RATE, engine);
+
+  std::vector<uint8_t> reference_base_band;
+  std::vector<uint8_t> base_band;
+  afsk::Demodulator::ProcessResults reference_results;
+  afsk::Demodulator::ProcessResults results;
+  reference.process(audio, reference_base_band, reference_results);
+  detector.process(audio, base_band, results);
+
+  // Only compare where there is a signal, the mark/space decision is a coin
+  // toss in the silence at the end of the recording.
+  ASSERT_EQ(reference_base_band.size(), base_band.size());
+  size_t mismatches = 0;
+  size_t compared = 0;
+  for (size_t i = 0; i < base_band.size(); i++) {
+    if (std::abs(audio[i]) < SIGNAL_THRESHOLD) {
+      continue;
+    }
+    compared++;
+    mismatches += reference_base_band[i] != base_band[i] ? 1 : 0;
+  }
+  ASSERT_GT(compared, base_band.size() / 2);
+  EXPECT_LE(static_cast<double>(mismatches) / compared, max_mismatch_ratio);
+  EXPECT_NEAR(results.snr, reference_results.snr, 0.1);
+  EXPECT_NEAR(results.rms, reference_results.rms, 0.01 * reference_results.rms);
+}
+
+} // namespace
+
+TEST(FixedPoint, SampleTraitsRoundTrip) {
+  using Fixed = SampleTraits<FixedSample>;
+  EXPECT_EQ(Fixed::fromPcm(1), 1 << 8);
+  EXPECT_EQ(Fixed::fromPcm(-32768), -(1 << 23));
+  EXPECT_DOUBLE_EQ(Fixed::sumToDouble(Fixed::fromPcm(16384)), 0.5);
+  EXPECT_EQ(Fixed::coefficient(1.0), 1 << 29);
+
+  // 0.5 * 0.25
+  const auto product =
+      Fixed::multiply(Fixed::coefficient(0.5), Fixed::fromPcm(8192));
+  EXPECT_EQ(Fixed::fromAccumulator(product), Fixed::fromPcm(4096));
+}
+
+TEST(FixedPoint, BiquadMatchesButterworthResponse) {
+  constexpr double kLower = 1000.0;
+  constexpr double kUpper = 2400.0;
+  constexpr size_t kOrder = 4;
+  const auto design =
+      designButterworthBandPass(AUDIO_SAMPLE_RATE, kLower, kUpper, kOrder);
+
+  // The band-pass transform of the prototype's frequency, with the edges
+  // pre-warped like the design
+  const auto warp = [](double frequency) {
+    return std::tan(PI_VAL * frequency / AUDIO_SAMPLE_RATE);
+  };
+  for (double frequency : {500.0, 800.0, 1000.0, 1400.0, 1700.0, 2400.0,
+                           3000.0, 4000.0}) {
+    const double t = warp(frequency);
+    const double prototype = (t * t - warp(kLower) * warp(kUpper)) /
+                             (t * (warp(kUpper) - warp(kLower)));
+    const double expected_db =
+        -10.0 * std::log10(1.0 + std::pow(prototype, 2.0 * kOrder));
+
+    std::vector<int16_t> tone;
+    for (size_t i = 0; i < AUDIO_SAMPLE_RATE; i++) {
+      tone.push_back(static_cast<int16_t>(std::round(
+          16000.0 * std::sin(TWO_PI_VAL * frequency * i / AUDIO_SAMPLE_RATE))));
+    }
+    const auto output = filterAs<double>(tone, design);
+
+    // The second half, past the start up transient, is a whole number of
+    // periods of every tone
+    double input_power = 0.0;
+    double output_power = 0.0;
+    for (size_t i = AUDIO_SAMPLE_RATE / 2; i < AUDIO_SAMPLE_RATE; i++) {
+      const double input = tone[i] / 32768.0;
+      input_power += input * input;
+      output_power += output[i] * output[i];
+    }
+    EXPECT_NEAR(10.0 * std::log10(output_power / input_power), expected_db,
+                0.01)
+        << frequency;
+  }
+}
+
+TEST(FixedPoint, FilterParity) {
+  const auto audio = loadWav("aprs_real.wav");
+  ASSERT_FALSE(audio.empty());
+
+  for (const auto &band : {std::pair<double, double>{1000, 2400},
+                           {1000, 1400},
+                           {500, 2700}}) {
+    const auto design =
+        designButterworthBandPass(AUDIO_SAMPLE_RATE, band.first, band.second,
+                                  afsk::AFSK_BP_FILTER_ORDER);
+    const auto reference = filterAs<double>(audio, design);
+    EXPECT_GT(signalToErrorDb(reference, filterAs<float>(audio, design)), 80.0)
+        << band.first;
+    EXPECT_GT(signalToErrorDb(reference, filterAs<FixedSample>(audio, design)),
+              60.0)
+        << band.first;
+  }
+}
+
+TEST(FixedPoint, ToneDetectorParity) {
+  const auto audio = loadWav("aprs_real.wav");
+  ASSERT_FALSE(audio.empty());
+
+  for (auto engine : {afsk::Settings::DemodulationEngine::CORRELATOR,
+                      afsk::Settings::DemodulationEngine::QUADRATURE_MIXER}) {
+    expectDecisionParity<float>(audio, engine, 0.001);
+    expectDecisionParity<FixedSample>(audio, engine, 0.005);
+  }
+}
+
+/**
+ * @brief The mark/space decisions over a whole APRS packet agree with the
+ * double detector, for the float and fixed point detectors. Decoding the
+ * packet on each type is left to the builds with SIGNALEASEL_DSP_SAMPLE_TYPE
+ * set to float or fixed, which run the APRS tests on that type.
+ */
+TEST(FixedPoint, AprsPacketBaseBandParity) {
+  const auto audio = loadWav("aprs_message.wav");
+  ASSERT_FALSE(audio.empty());
+
+  for (auto engine : {afsk::Settings::DemodulationEngine::CORRELATOR,
+                      afsk::Settings::DemodulationEngine::QUADRATURE_MIXER}) {
+    expectDecisionParity<float>(audio, engine, 0.001);
+    expectDecisionParity<FixedSample>(audio, engine, 0.001);
+  }
+}
@@ -0,0 +1,271 @@
+/// =*============================= SignalEasel ==============================*=
+/// A C++ library for audio modulation/demodulation into analog & digital modes.
+/// Detailed documentation can be found here: https://signaleasel.joshuajer.red
+///
+/// @author Joshua Jerred
+/// @date   2026-10-19
+///
+/// @copyright Copyright 2026 Joshua Jerred. All rights reserved.
+/// @license   This project is licensed under the GNU GPL v3.0 license.
+/// =*========================================================================*=
+
+#include <chrono>
+#include <ctime>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "gtest/gtest.h"
+
+#include <SignalEasel/afsk.hpp>
+#include <SignalEasel/aprs.hpp>
+#include <SignalEasel/exception.hpp>
+#include <SignalEasel/pcm_stream.hpp>
+
+using namespace signal_easel;
+
+/**
+ * @brief A pipe that closes whatever ends are still open when it goes out of
+ * scope.
+ */
+class TestPipe {
+public:
+  TestPipe() { EXPECT_EQ(pipe(fds_), 0); }
+  ~TestPipe() {
+    closeReadEnd();
+    closeWriteEnd();
+  }
+  TestPipe(const TestPipe &) = delete;
+  TestPipe &operator=(const TestPipe &) = delete;
+
+  int readEnd() const { return fds_[0]; }
+  int writeEnd() const { return fds_[1]; }
+
+  void closeReadEnd() {
+    if (fds_[0] != -1) {
+      close(fds_[0]);
+      fds_[0] = -1;
+    }
+  }
+  void closeWriteEnd() {
+    if (fds_[1] != -1) {
+      close(fds_[1]);
+      fds_[1] = -1;
+    }
+  }
+
+private:
+  int fds_[2] = {-1, -1};
+};
+
+TEST(PcmStream, AfskStringRoundTripThroughPipe) {
+  const std::string kInputString = "Hello World! How are you today?";
+
+  afsk::Modulator modulator;
+  modulator.addString(kInputString);
+
+  TestPipe pipe;
+  // The audio is larger than the pipe's capacity, so write from another thread
+  std::thread writer_thread([&]() {
+    PcmStreamWriter writer(pipe.writeEnd());
+    modulator.writeToPcmStream(writer);
+    pipe.closeWriteEnd();
+  });
+
+  PcmStreamReader reader(pipe.readEnd());
+  afsk::Demodulator demodulator;
+  demodulator.loadAudioFromPcmStream(reader);
+  writer_thread.join();
+
+  EXPECT_TRUE(reader.isEndOfStream());
+  demodulator.processAudioBuffer();
+  std::string output;
+  EXPECT_EQ(demodulator.lookForString(output),
+            afsk::Demodulator::AsciiResult::SUCCESS);
+  EXPECT_EQ(kInputString, output);
+}
+
+TEST(PcmStream, LoadingAgainReplacesTheAudio) {
+  afsk::Demodulator demodulator;
+  for (const std::string input : {"First load", "Second load"}) {
+    afsk::Modulator modulator;
+    modulator.addString(input);
+
+    TestPipe pipe;
+    std::thread writer_thread([&]() {
+      PcmStreamWriter writer(pipe.writeEnd());
+      modulator.writeToPcmStream(writer);
+      pipe.closeWriteEnd();
+    });
+
+    PcmStreamReader reader(pipe.readEnd());
+    demodulator.loadAudioFromPcmStream(reader);
+    writer_thread.join();
+
+    demodulator.processAudioBuffer();
+    std::string output;
+    EXPECT_EQ(demodulator.lookForString(output),
+              afsk::Demodulator::AsciiResult::SUCCESS);
+    EXPECT_EQ(input, output);
+  }
+}
+
+TEST(PcmStream, SamplesSplitAcrossWrites) {
+  TestPipe pipe;
+
+  // s16le: 0x0201, 0x0403, 0x7fff - the second sample is split across writes
+  const uint8_t kFirstWrite[] = {0x01, 0x02, 0x03};
+  const uint8_t kSecondWrite[] = {0x04, 0xff, 0x7f};
+  ASSERT_EQ(write(pipe.writeEnd(), kFirstWrite, sizeof(kFirstWrite)), 3);
+  ASSERT_EQ(write(pipe.writeEnd(), kSecondWrite, sizeof(kSecondWrite)), 3);
+  pipe.closeWriteEnd();
+
+  PcmStreamReader reader(pipe.readEnd(), AUDIO_SAMPLE_RATE, 2);
+
+  ASSERT_TRUE(reader.process());
+  EXPECT_EQ(reader.getAudioBuffer(), (std::vector<int16_t>{0x0201, 0x0403}));
+
+  ASSERT_TRUE(reader.process());
+  EXPECT_EQ(reader.getAudioBuffer(), (std::vector<int16_t>{0x7fff}));
+  EXPECT_TRUE(reader.isEndOfStream());
+
+  EXPECT_FALSE(reader.process());
+  EXPECT_EQ(reader.getTotalSamples(), 3u);
+}
+
+/**
+ * @brief readAll() on a non-blocking pipe with a slow writer has to wait for
+ * the audio, without spinning on EAGAIN.
+ */
+TEST(PcmStream, ReadAllWaitsOnNonBlockingPipe) {
+  TestPipe pipe;
+  ASSERT_EQ(fcntl(pipe.readEnd(), F_SETFL, O_NONBLOCK), 0);
+
+  constexpr size_t kWrites = 10;
+  const std::vector<int16_t> kChunk(1000, 0x1234);
+  std::thread writer_thread([&]() {
+    PcmStreamWriter writer(pipe.writeEnd());
+    for (size_t i = 0; i < kWrites; i++) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+      writer.write(kChunk);
+    }
+    pipe.closeWriteEnd();
+  });
+
+  timespec start{};
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &start);
+  PcmStreamReader reader(pipe.readEnd(), AUDIO_SAMPLE_RATE, 4000);
+  std::vector<int16_t> output;
+  reader.readAll(output);
+  timespec end{};
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &end);
+  writer_thread.join();
+
+  EXPECT_EQ(output.size(), kWrites * kChunk.size());
+  EXPECT_TRUE(reader.isEndOfStream());
+  // The writer takes 200ms, spinning would use about as much CPU time
+  const double cpu_seconds =
+      (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) * 1e-9;
+  EXPECT_LT(cpu_seconds, 0.05);
+}
+
+TEST(PcmStream, WriterIsLittleEndian) {
+  TestPipe pipe;
+  PcmStreamWriter writer(pipe.writeEnd());
+  writer.write(std::vector<int16_t>{0x0102, -2});
+  pipe.closeWriteEnd();
+
+  uint8_t bytes[4] = {0};
+  ASSERT_EQ(read(pipe.readEnd(), bytes, sizeof(bytes)), 4);
+  EXPECT_EQ(bytes[0], 0x02);
+  EXPECT_EQ(bytes[1], 0x01);
+  EXPECT_EQ(bytes[2], 0xfe);
+  EXPECT_EQ(bytes[3], 0xff);
+  EXPECT_EQ(writer.getTotalSamples(), 2u);
+}
+
+/**
+ * @brief Feed an APRS receiver from a pipe, like `rtl_fm | decoder` would.
+ * The packet is at the very end of the stream to make sure it is flushed.
+ */
+TEST(PcmStream, AprsReceiverFromPipe) {
+  aprs::MessagePacket message_packet;
+  message_packet.source_address = "TSTCLL";
+  message_packet.source_ssid = 11;
+  message_packet.addressee = "TSTCLL-11";
+  message_packet.message = "Hello World!";
+  message_packet.message_id = "1";
+
+  aprs::Modulator modulator;
+  modulator.encode(message_packet);
+
+  TestPipe pipe;
+  std::thread writer_thread([&]() {
+    PcmStreamWriter writer(pipe.writeEnd());
+    writer.write(std::vector<int16_t>(AUDIO_SAMPLE_RATE, 0));
+    modulator.writeToPcmStream(writer);
+    pipe.closeWriteEnd();
+  });
+
+  aprs::Receiver receiver;
+  receiver.usePcmStream(std::make_unique<PcmStreamReader>(pipe.readEnd()));
+
+  constexpr int kMaxBlocks = 1000;
+  int num_blocks = 0;
+  while (num_blocks < kMaxBlocks && receiver.process()) {
+    num_blocks++;
+  }
+  writer_thread.join();
+
+  aprs::MessagePacket decoded_packet;
+  ax25::Frame frame;
+  ASSERT_TRUE(receiver.getAprsMessage(decoded_packet, frame));
+  EXPECT_EQ(decoded_packet.message, message_packet.message);
+  EXPECT_EQ(decoded_packet.addressee, message_packet.addressee);
+}
+
+/**
+ * @brief Write the audio out at 44.1kHz and read it back in, which resamples
+ * it twice before it reaches the demodulator.
+ */
+TEST(PcmStream, AfskStringRoundTripAt44100) {
+  const std::string kInputString = "Hello World! How are you today?";
+  constexpr uint32_t kStreamSampleRate = 44100;
+
+  afsk::Modulator modulator;
+  modulator.addString(kInputString);
+
+  TestPipe pipe;
+  uint64_t samples_written = 0;
+  std::thread writer_thread([&]() {
+    PcmStreamWriter writer(pipe.writeEnd(), kStreamSampleRate);
+    modulator.writeToPcmStream(writer);
+    writer.flush();
+    samples_written = writer.getTotalSamples();
+    pipe.closeWriteEnd();
+  });
+
+  PcmStreamReader reader(pipe.readEnd(), kStreamSampleRate);
+  afsk::Demodulator demodulator;
+  demodulator.loadAudioFromPcmStream(reader);
+  writer_thread.join();
+
+  // 44100/48000 is 147/160
+  EXPECT_NEAR(static_cast<double>(reader.getTotalSamples()),
+              samples_written * 160.0 / 147.0, 64.0);
+
+  demodulator.processAudioBuffer();
+  std::string output;
+  EXPECT_EQ(demodulator.lookForString(output),
+            afsk::Demodulator::AsciiResult::SUCCESS);
+  EXPECT_EQ(kInputString, output);
+}
+
+TEST(PcmStream, InvalidSampleRate) {
+  EXPECT_THROW(PcmStreamReader(STDIN_FILENO, 0), Exception);
+  EXPECT_THROW(PcmStreamWriter(STDOUT_FILENO, 0), Exception);
+}
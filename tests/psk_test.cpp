@@ -1,7 +1,21 @@
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
 #include "gtest/gtest.h"
 
+#include <SignalEasel/channel_simulator.hpp>
+#include <SignalEasel/constants.hpp>
+#include <SignalEasel/exception.hpp>
 #include <SignalEasel/psk.hpp>
 
+#include "src/psk/convolutional_code.hpp"
+#include "src/psk/psk_wave_shaper.hpp"
+
 using namespace signal_easel;
 
 TEST(PSK_test, bpsk125) {
@@ -38,4 +52,550 @@ TEST(PSK_test, addCallSign) {
   modulator.encodeString("Hello World!");
   modulator.encodeString("Hello World!");
   modulator.writeToFile("test_psk_add_call_sign.wav");
-}
\ No newline at end of file
+}
+
+namespace {
+
+std::vector<int16_t> modulatePsk(const psk::Settings &settings,
+                                 const std::string &text) {
+  psk::Modulator modulator(settings);
+  modulator.encodeString(text);
+  return modulator.getAudioBuffer();
+}
+
+/// @brief Demodulate in uneven blocks, as audio arrives from a sound card
+std::string demodulatePsk(const psk::Settings &settings,
+                          const std::vector<int16_t> &audio,
+                          psk::Demodulator::Stats *stats = nullptr) {
+  psk::Demodulator demodulator(settings);
+  constexpr size_t BLOCK_SIZE = 1013;
+  for (size_t i = 0; i < audio.size(); i += BLOCK_SIZE) {
+    demodulator.process(audio.data() + i,
+                        std::min(BLOCK_SIZE, audio.size() - i));
+  }
+  std::string text;
+  demodulator.takeText(text);
+  if (stats != nullptr) {
+    *stats = demodulator.getStats();
+  }
+  return text;
+}
+
+/// @brief The shaper's output computed sample by sample, with a sin() for
+/// the carrier and another for the envelope.
+void referencePskSymbol(double &angle, double angle_delta, double amplitude,
+                        uint32_t samples_per_symbol, psk::Phase phase,
+                        bool filter_start, bool filter_end,
+                        std::vector<int16_t> &output) {
+  for (uint32_t n = 0; n < samples_per_symbol; n++) {
+    double sample =
+        std::sin(angle + static_cast<double>(phase) * PI_VAL / 2);
+    const bool first_half = n < samples_per_symbol / 2;
+    if ((first_half && filter_start) || (!first_half && filter_end)) {
+      sample *= std::sin(PI_VAL / samples_per_symbol * n);
+    }
+    output.push_back(
+        static_cast<int16_t>(sample * amplitude * MAX_SAMPLE_VALUE));
+    angle += angle_delta;
+    if (angle >= TWO_PI_VAL) {
+      angle -= TWO_PI_VAL;
+    }
+  }
+}
+
+} // namespace
+
+TEST(PSK_test, waveShaperMatchesReference) {
+  for (uint32_t samples_per_symbol : {1536, 768, 384, 192, 96, 48}) {
+    for (uint32_t carrier : {1000, 1234, 1500, 2999}) {
+      std::mt19937 generator(samples_per_symbol + carrier);
+      std::vector<psk::Phase> phases(300);
+      for (auto &phase : phases) {
+        // Mostly runs of the same phase, like varicode
+        phase = generator() % 3 == 0 ? static_cast<psk::Phase>(generator() % 4)
+                                     : psk::Phase::ZERO;
+      }
+
+      std::vector<int16_t> shaped;
+      psk::PskWaveShaper shaper(carrier, samples_per_symbol, 0.7, shaped);
+      shaper.reserve(phases.size());
+      std::vector<int16_t> reference;
+      double angle = 0.0;
+      psk::Phase previous = psk::Phase::ZERO;
+      for (size_t i = 0; i < phases.size(); i++) {
+        const bool filter_end =
+            i + 1 < phases.size() && phases[i + 1] != phases[i];
+        shaper.addSymbol(phases[i], filter_end);
+        referencePskSymbol(angle, TWO_PI_VAL * carrier / AUDIO_SAMPLE_RATE,
+                           0.7, samples_per_symbol, phases[i],
+                           phases[i] != previous, filter_end, reference);
+        previous = phases[i];
+      }
+
+      ASSERT_EQ(shaped.size(), reference.size());
+      for (size_t i = 0; i < shaped.size(); i++) {
+        ASSERT_NEAR(shaped[i], reference[i], 1)
+            << "samples per symbol " << samples_per_symbol << " carrier "
+            << carrier << " sample " << i;
+      }
+    }
+  }
+}
+
+TEST(PSK_test, bpskDemodulateAllSymbolRates) {
+  for (auto rate : {psk::Settings::SymbolRate::SR_31_25,
+                    psk::Settings::SymbolRate::SR_62_5,
+                    psk::Settings::SymbolRate::SR_125,
+                    psk::Settings::SymbolRate::SR_250,
+                    psk::Settings::SymbolRate::SR_500,
+                    psk::Settings::SymbolRate::SR_1000}) {
+    psk::Settings settings;
+    settings.mode = psk::Settings::Mode::BPSK;
+    settings.symbol_rate = rate;
+
+    psk::Demodulator::Stats stats;
+    EXPECT_EQ(demodulatePsk(settings, modulatePsk(settings, "Hello World!"),
+                            &stats),
+              "Hello World!");
+    EXPECT_EQ(stats.characters, 12);
+    EXPECT_GT(stats.signal_quality, 0.95);
+  }
+}
+
+TEST(PSK_test, bpskEveryCharacter) {
+  psk::Settings settings;
+  settings.mode = psk::Settings::Mode::BPSK;
+  settings.symbol_rate = psk::Settings::SymbolRate::SR_1000;
+
+  // Long codes land across bit stream words at many offsets
+  std::string text;
+  for (int repeat = 0; repeat < 3; repeat++) {
+    for (int c = 1; c < 128; c++) {
+      text.push_back(static_cast<char>(c));
+    }
+  }
+  EXPECT_EQ(demodulatePsk(settings, modulatePsk(settings, text)), text);
+}
+
+TEST(PSK_test, bpskDemodulateSymbolTiming) {
+  psk::Settings settings;
+  settings.mode = psk::Settings::Mode::BPSK;
+  settings.symbol_rate = psk::Settings::SymbolRate::SR_250;
+  const auto audio = modulatePsk(settings, "The quick brown fox 0123");
+
+  // Start part way through a symbol, the timing loop has to find it
+  for (size_t skew : {13, 48, 97, 150}) {
+    std::vector<int16_t> delayed(skew, 0);
+    delayed.insert(delayed.end(), audio.begin(), audio.end());
+    EXPECT_EQ(demodulatePsk(settings, delayed), "The quick brown fox 0123")
+        << "skew " << skew;
+  }
+}
+
+TEST(PSK_test, bpskDemodulateImpairedChannel) {
+  psk::Settings settings;
+  settings.mode = psk::Settings::Mode::BPSK;
+  settings.symbol_rate = psk::Settings::SymbolRate::SR_125;
+  const auto audio = modulatePsk(settings, "Hello World!");
+
+  ChannelSimulator::Settings channel_settings;
+  channel_settings.add_noise = true;
+  channel_settings.eb_n0_db = 12.0;
+  channel_settings.bit_rate = 125;
+  channel_settings.frequency_offset = 3.0;
+  channel_settings.clock_drift_ppm = 100.0;
+  channel_settings.seed = 7;
+  ChannelSimulator channel(channel_settings);
+  std::vector<int16_t> impaired;
+  channel.process(audio, impaired);
+
+  psk::Demodulator::Stats stats;
+  EXPECT_EQ(demodulatePsk(settings, impaired, &stats), "Hello World!");
+  EXPECT_NEAR(stats.frequency_offset, 3.0, 1.0);
+}
+
+TEST(PSK_test, bpsk31DemodulateImpairedChannel) {
+  psk::Settings settings;
+  settings.mode = psk::Settings::Mode::BPSK;
+  settings.symbol_rate = psk::Settings::SymbolRate::SR_31_25;
+  const auto audio = modulatePsk(settings, "CQ CQ de K1ABC");
+
+  ChannelSimulator::Settings channel_settings;
+  channel_settings.add_noise = true;
+  channel_settings.eb_n0_db = 12.0;
+  channel_settings.bit_rate = 31;
+  channel_settings.frequency_offset = 2.0;
+  channel_settings.clock_drift_ppm = 100.0;
+  channel_settings.seed = 7;
+  ChannelSimulator channel(channel_settings);
+  std::vector<int16_t> impaired;
+  channel.process(audio, impaired);
+
+  psk::Demodulator::Stats stats;
+  EXPECT_EQ(demodulatePsk(settings, impaired, &stats), "CQ CQ de K1ABC");
+  EXPECT_NEAR(stats.frequency_offset, 2.0, 1.0);
+}
+
+TEST(PSK_test, bpskAutomaticFrequencyControl) {
+  // Well outside of the Costas loop's pull in, the first characters may be
+  // lost while the AFC retunes.
+  const std::string text = "The quick brown fox jumps over the lazy dog";
+  for (auto symbol_rate : {psk::Settings::SymbolRate::SR_125,
+                           psk::Settings::SymbolRate::SR_500}) {
+    for (double offset : {-80.0, 60.0}) {
+      psk::Settings settings;
+      settings.mode = psk::Settings::Mode::BPSK;
+      settings.symbol_rate = symbol_rate;
+      const auto audio = modulatePsk(settings, text);
+
+      ChannelSimulator::Settings channel_settings;
+      channel_settings.add_noise = true;
+      channel_settings.eb_n0_db = 15.0;
+      channel_settings.bit_rate =
+          static_cast<uint32_t>(psk::getSymbolRate(symbol_rate));
+      channel_settings.frequency_offset = offset;
+      channel_settings.seed = 3;
+      ChannelSimulator channel(channel_settings);
+      std::vector<int16_t> impaired;
+      channel.process(audio, impaired);
+
+      EXPECT_EQ(demodulatePsk(settings, impaired).find(text.substr(4)),
+                std::string::npos)
+          << offset;
+
+      settings.afc_range = 100;
+      psk::Demodulator::Stats stats;
+      const std::string decoded = demodulatePsk(settings, impaired, &stats);
+      EXPECT_NE(decoded.find(text.substr(4)), std::string::npos)
+          << offset << " " << decoded;
+      EXPECT_NEAR(stats.frequency_offset, offset, 2.0);
+    }
+  }
+}
+
+TEST(PSK_test, bpskDemodulateNoiseIsSquelched) {
+  psk::Settings settings;
+  settings.mode = psk::Settings::Mode::BPSK;
+
+  std::mt19937 generator(11);
+  std::normal_distribution<double> distribution(0.0, 4000.0);
+  std::vector<int16_t> noise(AUDIO_SAMPLE_RATE * 5);
+  for (auto &sample : noise) {
+    sample = static_cast<int16_t>(distribution(generator));
+  }
+
+  psk::Demodulator::Stats stats;
+  EXPECT_EQ(demodulatePsk(settings, noise, &stats), "");
+  EXPECT_LT(stats.signal_quality, settings.squelch_level);
+}
+
+TEST(PSK_test, pskDemodulatorValidatesSettings) {
+  psk::Settings settings;
+  settings.carrier_frequency = AUDIO_SAMPLE_RATE;
+  EXPECT_THROW(psk::Demodulator{settings}, signal_easel::Exception);
+
+  settings.carrier_frequency = 1000;
+  settings.afc_range = 1000;
+  EXPECT_THROW(psk::Demodulator{settings}, signal_easel::Exception);
+}
+
+TEST(PSK_test, varicodeDecoder) {
+  // Every character, with the separator, and extra 0s between some of them
+  std::vector<bool> bits;
+  for (uint32_t c = 0; c < 128; c++) {
+    const uint16_t code = psk::AsciiToVaricodeArray[c];
+    for (int i = 15; i >= 0; i--) {
+      if (code >= (1U << i)) {
+        bits.push_back((code & (1U << i)) != 0);
+      }
+    }
+    bits.insert(bits.end(), c % 3 + 2, false);
+  }
+  // Idle 1s, longer than any code, are not a character
+  bits.insert(bits.end(), 20, true);
+  bits.insert(bits.end(), 2, false);
+
+  psk::VaricodeDecoder decoder;
+  std::string decoded;
+  char character = 0;
+  for (bool bit : bits) {
+    if (decoder.decode(bit, character)) {
+      decoded.push_back(character);
+    }
+  }
+
+  ASSERT_EQ(decoded.size(), 128);
+  for (uint32_t c = 0; c < 128; c++) {
+    EXPECT_EQ(static_cast<uint8_t>(decoded[c]), c);
+  }
+}
+
+TEST(PSK_test, convolutionalCodeTables) {
+  static_assert(psk::getShiftedConvolutionalCodePhase(
+                    0b00000, psk::Phase::NINETY) == psk::Phase::TWO_SEVENTY);
+  static_assert(psk::getShiftedConvolutionalCodePhase(
+                    0b00010, psk::Phase::ZERO) == psk::Phase::TWO_SEVENTY);
+
+  // Every transition is the current phase rotated by the code's shift
+  for (uint8_t code = 0; code < 32; code++) {
+    const double shift = psk::getConvolutionalCodeShift(code);
+    const auto &vector =
+        psk::SHIFT_VECTORS[static_cast<uint8_t>(psk::CONVOLUTIONAL_CODE[code])];
+    EXPECT_EQ(std::lround(std::cos(shift)), vector[0]);
+    EXPECT_EQ(std::lround(std::sin(shift)), vector[1]);
+
+    for (uint8_t phase = 0; phase < 4; phase++) {
+      const double angle = phase * PI_VAL / 2 + shift;
+      const auto expected = static_cast<psk::Phase>(
+          (std::lround(angle / (PI_VAL / 2)) % 4 + 4) % 4);
+      EXPECT_EQ(psk::getShiftedConvolutionalCodePhase(
+                    code, static_cast<psk::Phase>(phase)),
+                expected);
+    }
+  }
+}
+
+TEST(PSK_test, viterbiDecoderSoftDecisions) {
+  std::mt19937 generator(5);
+  std::normal_distribution<float> noise(0.0F, 0.4F);
+  std::vector<bool> bits(2000);
+  for (size_t i = 0; i < bits.size(); i++) {
+    bits[i] = (generator() & 1) != 0;
+  }
+
+  // Encode as encodeQpsk does, the phase change into symbol k + 1 is the
+  // code of the register holding bits up to k.
+  uint8_t code = 0;
+  psk::ViterbiDecoder decoder;
+  std::vector<bool> decoded;
+  size_t hard_decision_errors = 0;
+  for (bool bit : bits) {
+    code = static_cast<uint8_t>(((code << 1) | (bit ? 1 : 0)) & 0x1f);
+    const float shift =
+        static_cast<float>(psk::getConvolutionalCodeShift(code));
+    const std::complex<float> sent = std::polar(1.0F, shift);
+    const std::complex<float> received =
+        sent + std::complex<float>(noise(generator), noise(generator));
+
+    // The nearest phase change, what a hard decision decoder would see
+    const float quarter_turn = static_cast<float>(PI_VAL / 2);
+    const float nearest =
+        std::round(std::arg(received) / quarter_turn) * quarter_turn;
+    if (std::abs(std::polar(1.0F, nearest) - sent) > 0.5F) {
+      hard_decision_errors++;
+    }
+
+    bool output = false;
+    if (decoder.decode(received, output)) {
+      decoded.push_back(output);
+    }
+  }
+
+  ASSERT_EQ(decoded.size(),
+            bits.size() - psk::ViterbiDecoder::TRACEBACK_LENGTH + 1);
+  size_t errors = 0;
+  for (size_t i = 0; i < decoded.size(); i++) {
+    errors += decoded[i] != bits[i] ? 1 : 0;
+  }
+  EXPECT_GT(hard_decision_errors, 50);
+  EXPECT_EQ(errors, 0);
+}
+
+TEST(PSK_test, qpskDemodulateAllSymbolRates) {
+  for (auto rate : {psk::Settings::SymbolRate::SR_31_25,
+                    psk::Settings::SymbolRate::SR_62_5,
+                    psk::Settings::SymbolRate::SR_125,
+                    psk::Settings::SymbolRate::SR_250,
+                    psk::Settings::SymbolRate::SR_500,
+                    psk::Settings::SymbolRate::SR_1000}) {
+    psk::Settings settings;
+    settings.mode = psk::Settings::Mode::QPSK;
+    settings.symbol_rate = rate;
+
+    psk::Demodulator::Stats stats;
+    EXPECT_EQ(demodulatePsk(settings, modulatePsk(settings, "Hello World!"),
+                            &stats),
+              "Hello World!");
+    EXPECT_GT(stats.signal_quality, 0.95);
+  }
+}
+
+TEST(PSK_test, qpskDemodulateImpairedChannel) {
+  psk::Settings settings;
+  settings.mode = psk::Settings::Mode::QPSK;
+  settings.symbol_rate = psk::Settings::SymbolRate::SR_125;
+  settings.squelch_level = 0.0;
+  const std::string text = "The quick brown fox jumps over the lazy dog";
+  const auto audio = modulatePsk(settings, text);
+
+  ChannelSimulator::Settings channel_settings;
+  channel_settings.add_noise = true;
+  channel_settings.eb_n0_db = 8.0;
+  channel_settings.bit_rate = 125;
+  channel_settings.frequency_offset = 3.0;
+  channel_settings.clock_drift_ppm = 200.0;
+  channel_settings.seed = 3;
+  ChannelSimulator channel(channel_settings);
+  std::vector<int16_t> impaired;
+  channel.process(audio, impaired);
+
+  EXPECT_EQ(demodulatePsk(settings, impaired), text);
+}
+
+namespace {
+
+/// @brief Three BPSK stations across the passband, starting at different
+/// times, in noise, with a tail of noise long enough for their channels to
+/// be dropped.
+struct Band {
+  std::vector<uint32_t> carriers{700, 1234, 2100};
+  std::vector<std::string> texts{"CQ CQ de K1ABC", "de W2XYZ test 73",
+                                 "QRZ? N3DEF"};
+  std::vector<int16_t> audio{};
+
+  Band() {
+    const std::vector<size_t> starts{0, AUDIO_SAMPLE_RATE * 3 / 10,
+                                     AUDIO_SAMPLE_RATE * 7 / 10};
+    std::vector<float> mixed(AUDIO_SAMPLE_RATE * 8, 0.0F);
+    for (size_t i = 0; i < carriers.size(); i++) {
+      psk::Settings settings;
+      settings.carrier_frequency = carriers[i];
+      settings.amplitude = 0.25;
+      const auto signal = modulatePsk(settings, texts[i]);
+      for (size_t n = 0; n < signal.size(); n++) {
+        mixed[starts[i] + n] += signal[n];
+      }
+    }
+    std::mt19937 generator(5);
+    std::normal_distribution<float> distribution(0.0F, 300.0F);
+    for (const float sample : mixed) {
+      audio.push_back(static_cast<int16_t>(sample + distribution(generator)));
+    }
+  }
+};
+
+/// @brief The text of each channel by id, with the frequency it was last
+/// decoded at. The number of channels still active at the end is returned in
+/// active.
+std::map<uint32_t, psk::Channelizer::Channel>
+channelizePsk(const psk::ChannelizerSettings &settings,
+              const std::vector<int16_t> &audio, size_t &active) {
+  psk::Channelizer channelizer(settings);
+  std::map<uint32_t, psk::Channelizer::Channel> channels;
+  std::vector<psk::Channelizer::Channel> taken;
+  constexpr size_t BLOCK_SIZE = 4801;
+  for (size_t i = 0; i < audio.size(); i += BLOCK_SIZE) {
+    channelizer.process(audio.data() + i,
+                        std::min(BLOCK_SIZE, audio.size() - i));
+    channelizer.takeText(taken);
+    for (auto &channel : taken) {
+      auto &total = channels[channel.id];
+      total.id = channel.id;
+      if (!channel.text.empty()) {
+        total.frequency = channel.frequency;
+      }
+      total.text += channel.text;
+      total.active = channel.active;
+    }
+  }
+  active = channelizer.getNumChannels();
+  return channels;
+}
+
+} // namespace
+
+TEST(PSK_test, channelizerFindsEveryCarrier) {
+  const Band band;
+  size_t active = 0;
+  const auto channels =
+      channelizePsk(psk::ChannelizerSettings(), band.audio, active);
+
+  ASSERT_EQ(channels.size(), band.carriers.size());
+  EXPECT_EQ(active, 0U);
+  for (size_t i = 0; i < band.carriers.size(); i++) {
+    const auto found = std::find_if(
+        channels.begin(), channels.end(), [&](const auto &channel) {
+          return std::abs(channel.second.frequency - band.carriers[i]) < 4.0;
+        });
+    ASSERT_NE(found, channels.end()) << band.carriers[i];
+    // Noise can slip a character past the squelch as the carrier ends
+    const std::string &text = found->second.text;
+    EXPECT_EQ(text.substr(0, band.texts[i].size()), band.texts[i]);
+    EXPECT_LE(text.size(), band.texts[i].size() + 2) << text;
+    EXPECT_FALSE(found->second.active);
+  }
+}
+
+TEST(PSK_test, channelizerThreadsMatch) {
+  const Band band;
+  psk::ChannelizerSettings settings;
+  size_t active = 0;
+  const auto single = channelizePsk(settings, band.audio, active);
+  settings.threads = 4;
+  const auto threaded = channelizePsk(settings, band.audio, active);
+
+  ASSERT_EQ(single.size(), threaded.size());
+  for (const auto &[id, channel] : single) {
+    EXPECT_EQ(channel.text, threaded.at(id).text);
+    EXPECT_DOUBLE_EQ(channel.frequency, threaded.at(id).frequency);
+  }
+}
+
+TEST(PSK_test, channelizerFindsPsk31Carriers) {
+  // PSK31 stations are often packed 100 Hz apart
+  const std::vector<uint32_t> carriers{1000, 1100};
+  const std::vector<std::string> texts{"CQ de K1ABC", "de W2XYZ 73"};
+  psk::ChannelizerSettings settings;
+  settings.symbol_rate = psk::Settings::SymbolRate::SR_31_25;
+  // The band around a PSK31 carrier is only 5 bins, the noise in it varies
+  // enough to cross the default threshold now and then.
+  settings.detection_threshold_db = 10.0;
+
+  std::vector<float> mixed;
+  for (size_t i = 0; i < carriers.size(); i++) {
+    psk::Settings station = settings;
+    station.carrier_frequency = carriers[i];
+    station.amplitude = 0.25;
+    const auto signal = modulatePsk(station, texts[i]);
+    const size_t start = i * AUDIO_SAMPLE_RATE / 2;
+    // Followed by enough noise for the channels to be dropped
+    mixed.resize(std::max(mixed.size(),
+                          start + signal.size() + AUDIO_SAMPLE_RATE * 3));
+    for (size_t n = 0; n < signal.size(); n++) {
+      mixed[start + n] += signal[n];
+    }
+  }
+  std::mt19937 generator(5);
+  std::normal_distribution<float> distribution(0.0F, 300.0F);
+  std::vector<int16_t> audio;
+  for (const float sample : mixed) {
+    audio.push_back(static_cast<int16_t>(sample + distribution(generator)));
+  }
+
+  size_t active = 0;
+  const auto channels = channelizePsk(settings, audio, active);
+  ASSERT_EQ(channels.size(), carriers.size());
+  EXPECT_EQ(active, 0U);
+  for (size_t i = 0; i < carriers.size(); i++) {
+    const auto found = std::find_if(
+        channels.begin(), channels.end(), [&](const auto &channel) {
+          return std::abs(channel.second.frequency - carriers[i]) < 4.0;
+        });
+    ASSERT_NE(found, channels.end()) << carriers[i];
+    const std::string &text = found->second.text;
+    EXPECT_EQ(text.substr(0, texts[i].size()), texts[i]);
+    EXPECT_LE(text.size(), texts[i].size() + 2) << text;
+  }
+}
+
+TEST(PSK_test, channelizerValidatesSettings) {
+  psk::ChannelizerSettings settings;
+  settings.max_frequency = settings.min_frequency;
+  EXPECT_THROW(psk::Channelizer{settings}, signal_easel::Exception);
+  settings = psk::ChannelizerSettings();
+  settings.detection_interval = psk::Channelizer::SPECTRUM_LENGTH - 1;
+  EXPECT_THROW(psk::Channelizer{settings}, signal_easel::Exception);
+  settings = psk::ChannelizerSettings();
+  settings.max_channels = 0;
+  EXPECT_THROW(psk::Channelizer{settings}, signal_easel::Exception);
+}
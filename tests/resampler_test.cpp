@@ -0,0 +1,169 @@
+/// =*============================= SignalEasel ==============================*=
+/// A C++ library for audio modulation/demodulation into analog & digital modes.
+/// Detailed documentation can be found here: https://signaleasel.joshuajer.red
+///
+/// @author Joshua Jerred
+/// @date   2026-10-19
+///
+/// @copyright Copyright 2026 Joshua Jerred. All rights reserved.
+/// @license   This project is licensed under the GNU GPL v3.0 license.
+/// =*========================================================================*=
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include <SignalEasel/afsk.hpp>
+#include <SignalEasel/exception.hpp>
+#include <SignalEasel/resampler.hpp>
+
+using namespace signal_easel;
+
+namespace {
+
+std::vector<int16_t> makeTone(double frequency, uint32_t sample_rate,
+                              size_t num_samples, double amplitude) {
+  std::vector<int16_t> tone(num_samples);
+  for (size_t i = 0; i < num_samples; i++) {
+    tone[i] = static_cast<int16_t>(
+        amplitude * std::sin(TWO_PI_VAL * frequency * i / sample_rate));
+  }
+  return tone;
+}
+
+/// @brief Count the upward zero crossings to estimate the frequency of a tone.
+double measureFrequency(const std::vector<int16_t> &samples, size_t start,
+                        uint32_t sample_rate) {
+  size_t first = 0;
+  size_t last = 0;
+  size_t crossings = 0;
+  for (size_t i = start + 1; i < samples.size(); i++) {
+    if (samples[i - 1] < 0 && samples[i] >= 0) {
+      if (crossings == 0) {
+        first = i;
+      }
+      last = i;
+      crossings++;
+    }
+  }
+  return (crossings - 1) * static_cast<double>(sample_rate) / (last - first);
+}
+
+double measureRms(const std::vector<int16_t> &samples, size_t start,
+                  size_t end) {
+  double sum = 0.0;
+  for (size_t i = start; i < end; i++) {
+    sum += static_cast<double>(samples[i]) * samples[i];
+  }
+  return std::sqrt(sum / (end - start));
+}
+
+} // namespace
+
+TEST(Resampler, Factors) {
+  Resampler up(44100, 48000);
+  EXPECT_EQ(up.getUpFactor(), 160u);
+  EXPECT_EQ(up.getDownFactor(), 147u);
+  EXPECT_FALSE(up.isPassthrough());
+
+  Resampler down(48000, 9600);
+  EXPECT_EQ(down.getUpFactor(), 1u);
+  EXPECT_EQ(down.getDownFactor(), 5u);
+
+  Resampler same(48000, 48000);
+  EXPECT_TRUE(same.isPassthrough());
+  std::vector<int16_t> input = {1, 2, 3, -4};
+  std::vector<int16_t> output;
+  same.process(input, output);
+  EXPECT_EQ(input, output);
+
+  EXPECT_THROW(Resampler(0, 48000), Exception);
+  EXPECT_THROW(Resampler(48000, 0), Exception);
+}
+
+TEST(Resampler, ToneKeepsFrequencyAndAmplitude) {
+  constexpr double kFrequency = 1000.0;
+  constexpr double kAmplitude = 10000.0;
+  const auto input = makeTone(kFrequency, 44100, 44100, kAmplitude);
+
+  Resampler resampler(44100, 48000);
+  std::vector<int16_t> output;
+  resampler.process(input, output);
+
+  EXPECT_NEAR(static_cast<double>(output.size()), 48000.0, 1.0);
+  // Skip the filter's startup transient
+  EXPECT_NEAR(measureFrequency(output, 1000, 48000), kFrequency, 1.0);
+  EXPECT_NEAR(measureRms(output, 1000, output.size() - 1000),
+              kAmplitude / std::sqrt(2.0), kAmplitude * 0.01);
+}
+
+TEST(Resampler, RemovesContentAboveNyquist) {
+  // 6kHz can't be represented at 9600Hz, it must not alias down to 3.6kHz
+  const auto input = makeTone(6000.0, 48000, 48000, 10000.0);
+
+  Resampler resampler(48000, 9600);
+  std::vector<int16_t> output;
+  resampler.process(input, output);
+
+  EXPECT_LT(measureRms(output, 500, output.size()), 10.0);
+}
+
+TEST(Resampler, StreamingMatchesSingleBlock) {
+  const auto input = makeTone(1700.0, 22050, 22050, 8000.0);
+
+  Resampler single(22050, 48000);
+  std::vector<int16_t> expected;
+  single.process(input, expected);
+  single.flush(expected);
+
+  // Odd block sizes so the blocks never line up with the filter phases
+  Resampler streaming(22050, 48000);
+  std::vector<int16_t> output;
+  constexpr size_t kBlockSize = 331;
+  for (size_t i = 0; i < input.size(); i += kBlockSize) {
+    const size_t count = std::min(kBlockSize, input.size() - i);
+    streaming.process(input.data() + i, count, output);
+  }
+  streaming.flush(output);
+
+  EXPECT_EQ(expected, output);
+}
+
+/**
+ * @brief Demodulate AFSK at reduced internal sample rates.
+ */
+TEST(Resampler, AfskReducedDemodulationRate) {
+  const std::string kInputString = "Hello World! How are you today?";
+
+  afsk::Modulator modulator;
+  modulator.addString(kInputString);
+  const std::string kOutFilePath = "resampler_test_AfskReduced.wav";
+  modulator.writeToFile(kOutFilePath);
+
+  for (uint32_t sample_rate : {9600u, 12000u, 24000u}) {
+    afsk::Settings settings;
+    settings.demodulation_sample_rate = sample_rate;
+
+    afsk::Demodulator demodulator(settings);
+    demodulator.loadAudioFromFile(kOutFilePath);
+    auto results = demodulator.processAudioBuffer();
+    EXPECT_GT(results.snr, 0.0) << sample_rate;
+
+    std::string output;
+    EXPECT_EQ(demodulator.lookForString(output),
+              afsk::Demodulator::AsciiResult::SUCCESS)
+        << sample_rate;
+    EXPECT_EQ(kInputString, output) << sample_rate;
+  }
+}
+
+TEST(Resampler, AfskInvalidDemodulationRate) {
+  for (uint32_t sample_rate : {0u, 4800u, 10000u, 96000u}) {
+    afsk::Settings settings;
+    settings.demodulation_sample_rate = sample_rate;
+    EXPECT_THROW(afsk::Demodulator demodulator(settings), Exception)
+        << sample_rate;
+  }
+}
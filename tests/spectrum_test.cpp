@@ -0,0 +1,182 @@
+/// =*============================= SignalEasel ==============================*=
+/// A C++ library for audio modulation/demodulation into analog & digital modes.
+/// Detailed documentation can be found here: https://signaleasel.joshuajer.red
+///
+/// @author Joshua Jerred
+/// @date   2026-10-19
+///
+/// @copyright Copyright 2026 Joshua Jerred. All rights reserved.
+/// @license   This project is licensed under the GNU GPL v3.0 license.
+/// =*========================================================================*=
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include <SignalEasel/constants.hpp>
+#include <SignalEasel/exception.hpp>
+#include <SignalEasel/spectrum.hpp>
+
+#include "src/fft.hpp"
+
+using namespace signal_easel;
+
+namespace {
+
+std::vector<int16_t> makeTone(double frequency, size_t num_samples,
+                              double amplitude) {
+  std::vector<int16_t> tone(num_samples);
+  for (size_t i = 0; i < num_samples; i++) {
+    tone[i] = static_cast<int16_t>(std::lround(
+        amplitude * std::sin(TWO_PI_VAL * frequency * i / AUDIO_SAMPLE_RATE)));
+  }
+  return tone;
+}
+
+std::vector<int16_t> makeNoise(double deviation, size_t num_samples,
+                               uint32_t seed) {
+  std::mt19937 generator(seed);
+  std::normal_distribution<double> distribution(0.0, deviation);
+  std::vector<int16_t> noise(num_samples);
+  for (auto &sample : noise) {
+    sample = static_cast<int16_t>(std::lround(distribution(generator)));
+  }
+  return noise;
+}
+
+} // namespace
+
+TEST(Spectrum, fftMatchesDft) {
+  std::mt19937 generator(5);
+  std::uniform_real_distribution<float> distribution(-1.0F, 1.0F);
+
+  // Both an even and an odd number of radix-4 stages, with and without the
+  // radix-2 stage
+  for (size_t size : {8, 16, 32, 64, 512, 2048}) {
+    std::vector<float> input(size);
+    for (auto &sample : input) {
+      sample = distribution(generator);
+    }
+
+    RealFft fft(size);
+    std::vector<float> real(fft.getNumBins());
+    std::vector<float> imaginary(fft.getNumBins());
+    fft.transform(input.data(), real.data(), imaginary.data());
+
+    std::vector<float> power(fft.getNumBins());
+    fft.power(input.data(), power.data());
+
+    for (size_t k = 0; k < fft.getNumBins(); k++) {
+      std::complex<double> expected{};
+      for (size_t n = 0; n < size; n++) {
+        expected += static_cast<double>(input[n]) *
+                    std::polar(1.0, -TWO_PI_VAL * k * n / size);
+      }
+      EXPECT_NEAR(real[k], expected.real(), 1e-4 * size) << size << " " << k;
+      EXPECT_NEAR(imaginary[k], expected.imag(), 1e-4 * size)
+          << size << " " << k;
+      EXPECT_NEAR(power[k], std::norm(expected), 1e-3 * size * size)
+          << size << " " << k;
+    }
+  }
+}
+
+TEST(Spectrum, fftValidatesSize) {
+  EXPECT_THROW(RealFft{4}, signal_easel::Exception);
+  EXPECT_THROW(RealFft{1000}, signal_easel::Exception);
+  EXPECT_NO_THROW(RealFft{1024});
+}
+
+TEST(Spectrum, fullScaleToneReadsZeroDbfs) {
+  for (auto window : {SpectrumSettings::Window::RECTANGULAR,
+                      SpectrumSettings::Window::HANN,
+                      SpectrumSettings::Window::BLACKMAN_HARRIS}) {
+    SpectrumSettings settings;
+    settings.window = window;
+    SpectrumAnalyzer analyzer(settings);
+
+    // Centered on bin 128, 1500 Hz
+    const size_t bin = 128;
+    analyzer.process(makeTone(analyzer.getBinFrequency(bin),
+                              settings.fft_size, 32767.0));
+    std::vector<SpectrumAnalyzer::Spectrum> spectra;
+    ASSERT_TRUE(analyzer.takeSpectra(spectra));
+    ASSERT_EQ(spectra.size(), 1U);
+    ASSERT_EQ(spectra[0].power_db.size(), analyzer.getNumBins());
+
+    const auto &power = spectra[0].power_db;
+    EXPECT_EQ(std::max_element(power.begin(), power.end()) - power.begin(),
+              static_cast<std::ptrdiff_t>(bin));
+    EXPECT_NEAR(power[bin], 0.0, 0.1);
+    EXPECT_NEAR(analyzer.getBandPower(spectra[0], 1400, 1600), 0.0, 0.1);
+  }
+}
+
+TEST(Spectrum, noiseBandPower) {
+  SpectrumSettings settings;
+  SpectrumAnalyzer analyzer(settings);
+  constexpr double DEVIATION = 1000.0;
+  analyzer.process(makeNoise(DEVIATION, AUDIO_SAMPLE_RATE * 2, 3));
+
+  std::vector<SpectrumAnalyzer::Spectrum> spectra;
+  ASSERT_TRUE(analyzer.takeSpectra(spectra));
+
+  // White noise spreads it's power evenly up to AUDIO_SAMPLE_RATE / 2, and a
+  // full scale sine has a power of 32767^2 / 2.
+  const double expected =
+      10.0 * std::log10(DEVIATION * DEVIATION * 1000.0 /
+                        (AUDIO_SAMPLE_RATE / 2.0) / (32767.0 * 32767.0 / 2));
+  double average = 0.0;
+  for (const auto &spectrum : spectra) {
+    average += std::pow(10.0, analyzer.getBandPower(spectrum, 1000, 2000) / 10);
+  }
+  average = 10.0 * std::log10(average / spectra.size());
+  EXPECT_NEAR(average, expected, 0.5);
+}
+
+TEST(Spectrum, hopAndBlockSize) {
+  const auto audio = makeNoise(2000.0, AUDIO_SAMPLE_RATE, 9);
+
+  for (uint32_t hop : {256U, 4096U, 6000U}) {
+    SpectrumSettings settings;
+    settings.hop = hop;
+
+    SpectrumAnalyzer whole(settings);
+    whole.process(audio);
+    std::vector<SpectrumAnalyzer::Spectrum> expected;
+    whole.takeSpectra(expected);
+    ASSERT_EQ(expected.size(), (audio.size() - settings.fft_size) / hop + 1);
+
+    // Uneven blocks, as audio arrives from a sound card
+    SpectrumAnalyzer streamed(settings);
+    std::vector<SpectrumAnalyzer::Spectrum> spectra;
+    std::vector<SpectrumAnalyzer::Spectrum> taken;
+    constexpr size_t BLOCK_SIZE = 1013;
+    for (size_t i = 0; i < audio.size(); i += BLOCK_SIZE) {
+      streamed.process(audio.data() + i,
+                       std::min(BLOCK_SIZE, audio.size() - i));
+      streamed.takeSpectra(taken);
+      spectra.insert(spectra.end(), taken.begin(), taken.end());
+    }
+
+    ASSERT_EQ(spectra.size(), expected.size()) << hop;
+    for (size_t i = 0; i < spectra.size(); i++) {
+      EXPECT_EQ(spectra[i].start_sample, i * hop);
+      EXPECT_EQ(spectra[i].power_db, expected[i].power_db);
+    }
+  }
+}
+
+TEST(Spectrum, validatesSettings) {
+  SpectrumSettings settings;
+  settings.fft_size = 3000;
+  EXPECT_THROW(SpectrumAnalyzer{settings}, signal_easel::Exception);
+
+  settings.fft_size = 1024;
+  settings.hop = 0;
+  EXPECT_THROW(SpectrumAnalyzer{settings}, signal_easel::Exception);
+}
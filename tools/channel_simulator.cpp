@@ -0,0 +1,148 @@
+/// =*============================= SignalEasel ==============================*=
+/// A C++ library for audio modulation/demodulation into analog & digital modes.
+/// Detailed documentation can be found here: https://signaleasel.joshuajer.red
+///
+/// @author Joshua Jerred
+/// @date   2026-10-19
+///
+/// @copyright Copyright 2026 Joshua Jerred. All rights reserved.
+/// @license   This project is licensed under the GNU GPL v3.0 license.
+/// =*========================================================================*=
+
+/**
+ * @brief Passes a WAV file (or s16le PCM on stdin) through the channel
+ * simulator.
+ * @details Usage:
+ *   signal_easel_channel [options] <input.wav|-> <output.wav|->
+ * A '-' reads/writes raw, mono, signed 16-bit little endian PCM at
+ * AUDIO_SAMPLE_RATE, so the tool can sit in a pipeline between a modulator
+ * and a decoder.
+ */
+
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include <wav_gen.hpp>
+
+#include <SignalEasel/channel_simulator.hpp>
+#include <SignalEasel/pcm_stream.hpp>
+
+using namespace signal_easel;
+
+namespace {
+
+void printUsage(const char *name) {
+  std::cerr
+      << "Usage: " << name << " [options] <input.wav|-> <output.wav|->\n"
+      << "  --ebn0 <dB>               Add white noise at this Eb/N0\n"
+      << "  --bit-rate <bps>          Bit rate for Eb/N0 (default 1200)\n"
+      << "  --offset <Hz>             Frequency offset\n"
+      << "  --drift <ppm>             Transmitter clock error\n"
+      << "  --twist <dB>              2200Hz gain relative to 1200Hz\n"
+      << "  --dropout-rate <n/s>      Average dropouts per second\n"
+      << "  --dropout-duration <s>    Length of each dropout\n"
+      << "  --seed <n>                Random seed (default 0)\n"
+      << "'-' reads/writes s16le mono PCM at " << AUDIO_SAMPLE_RATE
+      << "Hz on stdin/stdout.\n";
+}
+
+std::vector<int16_t> readInput(const std::string &path) {
+  std::vector<int16_t> samples;
+  if (path == "-") {
+    PcmStreamReader reader(STDIN_FILENO);
+    reader.readAll(samples);
+  } else {
+    wavgen::Reader reader(path);
+    reader.getAllSamples(samples);
+  }
+  return samples;
+}
+
+void writeOutput(const std::string &path,
+                 const std::vector<int16_t> &samples) {
+  if (path == "-") {
+    PcmStreamWriter writer(STDOUT_FILENO);
+    writer.write(samples);
+    writer.flush();
+  } else {
+    wavgen::Writer writer(path);
+    for (int16_t sample : samples) {
+      writer.addSample(sample);
+    }
+    writer.done();
+  }
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  ChannelSimulator::Settings settings;
+  std::vector<std::string> paths;
+
+  try {
+    for (int i = 1; i < argc; i++) {
+      const std::string arg = argv[i];
+      if (arg == "-h" || arg == "--help") {
+        printUsage(argv[0]);
+        return EXIT_SUCCESS;
+      }
+      if (arg.size() < 3 || arg.rfind("--", 0) != 0) {
+        paths.push_back(arg);
+        continue;
+      }
+      if (i + 1 >= argc) {
+        std::cerr << "Missing value for " << arg << "\n";
+        return EXIT_FAILURE;
+      }
+      const std::string value = argv[++i];
+      if (arg == "--ebn0") {
+        settings.add_noise = true;
+        settings.eb_n0_db = std::stod(value);
+      } else if (arg == "--bit-rate") {
+        settings.bit_rate = static_cast<uint32_t>(std::stoul(value));
+      } else if (arg == "--offset") {
+        settings.frequency_offset = std::stod(value);
+      } else if (arg == "--drift") {
+        settings.clock_drift_ppm = std::stod(value);
+      } else if (arg == "--twist") {
+        settings.twist_db = std::stod(value);
+      } else if (arg == "--dropout-rate") {
+        settings.dropout_rate = std::stod(value);
+      } else if (arg == "--dropout-duration") {
+        settings.dropout_duration = std::stod(value);
+      } else if (arg == "--seed") {
+        settings.seed = static_cast<uint32_t>(std::stoul(value));
+      } else {
+        std::cerr << "Unknown option " << arg << "\n";
+        printUsage(argv[0]);
+        return EXIT_FAILURE;
+      }
+    }
+  } catch (const std::logic_error &e) {
+    std::cerr << "Invalid option value: " << e.what() << "\n";
+    return EXIT_FAILURE;
+  }
+
+  if (paths.size() != 2) {
+    printUsage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  try {
+    ChannelSimulator channel(settings);
+    std::vector<int16_t> output;
+    channel.process(readInput(paths[0]), output);
+    writeOutput(paths[1], output);
+  } catch (const std::exception &e) {
+    // The library's and the WAV reader/writer's errors alike
+    std::cerr << "Error: " << e.what() << "\n";
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}